@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include "logger.hpp"
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// A per-vehicle line of the verbosity 2 report
+const std::string MESSAGE = "  Vehicle   42 (   Bravo):      Flying | Battery:  57.3% | Step: Flight 0.0003 hrs, "
+                            "Dist 0.03 mi | Total: Flights 3, Flight 1.2 hrs, Dist 112.5 mi\n";
+
+void BM_LoggerLog(benchmark::State& state) {
+    const auto mode = static_cast<Logger::LogMode>(state.range(0));
+    const bool async = state.range(1) != 0;
+    std::string filename = (std::filesystem::temp_directory_path() / "evtol_bench_logger.txt").string();
+
+    // Console output goes to a string stream, cleared regularly
+    std::ostringstream console;
+    std::streambuf* stdoutBuffer = std::cout.rdbuf(console.rdbuf());
+    {
+        Logger logger(filename, mode);
+        logger.setFlushPolicy(Logger::FlushPolicy::OnExit);
+        logger.setAsync(async);
+        for (auto _ : state) {
+            logger.log(MESSAGE);
+            if (console.tellp() > (1 << 20)) {
+                console.str("");
+            }
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(MESSAGE.size()));
+    }
+    std::cout.rdbuf(stdoutBuffer);
+    std::filesystem::remove(filename);
+}
+
+} // namespace
+
+BENCHMARK(BM_LoggerLog)
+    ->ArgNames({"mode", "async"})
+    ->Args({static_cast<int>(Logger::LogMode::STDOUT_ONLY), 0})
+    ->Args({static_cast<int>(Logger::LogMode::FILE_ONLY), 0})
+    ->Args({static_cast<int>(Logger::LogMode::FILE_ONLY), 1})
+    ->Args({static_cast<int>(Logger::LogMode::BOTH), 0})
+    ->Args({static_cast<int>(Logger::LogMode::NONE), 0});
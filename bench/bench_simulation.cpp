@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include "simulation_bench.hpp"
+
+namespace {
+
+// A fixed step of the whole fleet: freeing chargers, updating every vehicle and handing out
+// chargers, so the fleet keeps cycling through its states as in a real run. The second
+// argument picks the engine, so fixed step and soa run side by side for each fleet size.
+void BM_UpdateAllVehicles(benchmark::State& state) {
+    const int numVehicles = static_cast<int>(state.range(0));
+    const SimulationEngine engine = state.range(1) ? SimulationEngine::StructOfArrays : SimulationEngine::FixedStep;
+    Simulation sim(numVehicles, DEFAULT_HRS_SIM, std::max(1, numVehicles / 10), DEFAULT_TIME_STEP_SECONDS,
+                   DEFAULT_VERBOSITY, true, false);
+    sim.setEngine(engine);
+    sim.setSeed(1);
+    SimulationBenchmark::prepare(sim);
+    state.SetLabel(engineToString(engine));
+
+    for (auto _ : state) {
+        SimulationBenchmark::step(sim);
+    }
+    state.counters["vehicle-steps/s"] = benchmark::Counter(static_cast<double>(state.iterations()) * numVehicles,
+                                                           benchmark::Counter::kIsRate);
+}
+
+// Heavy contention: the whole fleet waits for a few chargers. Every iteration the vehicles on
+// a charger go back to the end of the queue and the chargers go to the front of the queue.
+void BM_ManageCharging(benchmark::State& state) {
+    const int numVehicles = static_cast<int>(state.range(0));
+    const int numChargers = static_cast<int>(state.range(1));
+    Simulation sim(numVehicles, DEFAULT_HRS_SIM, numChargers, DEFAULT_TIME_STEP_SECONDS, DEFAULT_VERBOSITY, true, false);
+    sim.setSeed(1);
+    SimulationBenchmark::prepare(sim);
+    SimulationBenchmark::queueAll(sim);
+    SimulationBenchmark::manageCharging(sim);
+
+    size_t assigned = 0;
+    for (auto _ : state) {
+        assigned += SimulationBenchmark::requeueCharging(sim);
+        SimulationBenchmark::manageCharging(sim);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(assigned));
+}
+
+} // namespace
+
+BENCHMARK(BM_UpdateAllVehicles)->ArgNames({"vehicles", "soa"})->Apply([](benchmark::internal::Benchmark* benchmark) {
+    for (int64_t vehicles = 10; vehicles <= 1000000; vehicles *= 10) {
+        benchmark->Args({vehicles, 0})->Args({vehicles, 1});
+    }
+})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ManageCharging)->ArgNames({"vehicles", "chargers"})->Args({10000, 1})->Args({10000, 16})->Args({10000, 256});
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "counter_rng.hpp"
+#include "simulation.hpp"
+
+namespace {
+
+const double STEP_HOURS = DEFAULT_TIME_STEP_SECONDS * SECONDS_TO_HOURS;
+
+// One updateState call from the given state, the vehicle is put back into the state before
+// every call so transitions out of it (Ready -> Flying, faults) do not change what is measured.
+// The second argument selects the built-in type kernel (1) or the generic state machine (0).
+void BM_VehicleUpdateState(benchmark::State& state) {
+    const auto vehicleState = static_cast<Vehicle::State>(state.range(0));
+    if (!Vehicle::setTypeKernelsEnabled(state.range(1) != 0)) {
+        state.SkipWithError("Built without EVTOL_TYPE_KERNELS");
+        return;
+    }
+    CounterRandomGenerator rng(1, 1);
+    BravoCompanyVehicle vehicle(rng);
+
+    for (auto _ : state) {
+        vehicle.setCurrentState(vehicleState);
+        vehicle.setBatteryLevel(0.5 * vehicle.getBatteryCapacity());
+        vehicle.updateState(STEP_HOURS);
+        benchmark::DoNotOptimize(vehicle.getStepStats());
+    }
+    state.counters["vehicle-steps/s"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                           benchmark::Counter::kIsRate);
+    Vehicle::setTypeKernelsEnabled(true);
+}
+
+} // namespace
+
+BENCHMARK(BM_VehicleUpdateState)
+    ->ArgNames({"state", "type_kernel"})
+    ->ArgsProduct({{static_cast<int>(Vehicle::State::Ready),
+                    static_cast<int>(Vehicle::State::Flying),
+                    static_cast<int>(Vehicle::State::Queued),
+                    static_cast<int>(Vehicle::State::Charging),
+                    static_cast<int>(Vehicle::State::Faulted)},
+                   {0, 1}});
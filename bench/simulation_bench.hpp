@@ -0,0 +1,66 @@
+/**
+ * @file simulation_bench.hpp
+ * @brief Access to the step functions of a Simulation for the benchmarks
+ *
+ * SimulationBenchmark is a friend of Simulation so the benchmarks can set up a fleet once
+ * and time single steps (or parts of a step) without running a whole simulation.
+ */
+
+#ifndef SIMULATION_BENCH_HPP
+#define SIMULATION_BENCH_HPP
+
+#include "simulation.hpp"
+
+class SimulationBenchmark {
+public:
+    // Create the fleet and chargers as runSimulation() does before the first step
+    static void prepare(Simulation& sim) {
+        sim.initializeVehicles();
+        sim.resetCharging();
+        sim.timeStep = sim.nextTimeStep();
+        if (sim.engine == SimulationEngine::StructOfArrays) {
+            sim.loadFleet();
+        }
+    }
+
+    // One step of the fixed step or soa engine without logging or tracing
+    static void step(Simulation& sim) {
+        sim.processChargingVehicles();
+        if (sim.engine == SimulationEngine::StructOfArrays) {
+            sim.updateFleet(sim.timeStep);
+        } else {
+            sim.updateAllVehicles(sim.timeStep);
+        }
+        sim.manageCharging();
+    }
+
+    static void manageCharging(Simulation& sim) { sim.manageCharging(); }
+
+    /**
+     * @brief Send every vehicle on a charger back to the charging queue.
+     * @return Number of vehicles sent back.
+     */
+    static size_t requeueCharging(Simulation& sim) {
+        size_t count = 0;
+        for (Vehicle* vehicle : sim.chargingStations) {
+            if (vehicle) {
+                size_t index = sim.vehicleIndex.at(vehicle);
+                sim.releaseCharger(index);
+                vehicle->setCurrentState(Vehicle::State::Queued);
+                sim.chunkTransitions[0].queued.push_back(index);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Put the whole fleet in the charging queue
+    static void queueAll(Simulation& sim) {
+        for (size_t index = 0; index < sim.vehicles.size(); ++index) {
+            sim.vehicles[index]->setCurrentState(Vehicle::State::Queued);
+            sim.chunkTransitions[0].queued.push_back(index);
+        }
+    }
+};
+
+#endif
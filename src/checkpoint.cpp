@@ -0,0 +1,326 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implementation file for the SimulationCheckpoint structure
+ *
+ * See checkpoint.hpp for documentation.
+ */
+
+#include "checkpoint.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = {'E', 'V', 'C', 'K', 'P', 'T', '\0', '\0'};
+const uint64_t MAX_ELEMENTS = 1ULL << 32; // Sanity limit on vector sizes read from a file
+
+// Bytes of the records as written, at least the bytes of a record with empty distributions,
+// so that no count read from a file allocates more than the rest of the file could hold
+const uint64_t STATS_BYTES = 6 * sizeof(double) + 3 * sizeof(int);
+const uint64_t VEHICLE_BYTES = sizeof(Vehicle::Manufacturer) + sizeof(Vehicle::State) + sizeof(Vehicle::FaultModel) +
+                               2 * sizeof(double) + 2 * STATS_BYTES + sizeof(uint64_t);
+const uint64_t DISTRIBUTION_MIN_BYTES = sizeof(uint64_t) + 4 * sizeof(double) + 2 * sizeof(uint64_t); // Two empty vectors
+const uint64_t TYPE_STATS_MIN_BYTES = sizeof(Vehicle::Manufacturer) + 3 * sizeof(int) + 5 * sizeof(double) +
+                                      3 * DISTRIBUTION_MIN_BYTES;
+const uint64_t EVENT_BYTES = sizeof(double) + 2 * sizeof(uint64_t);
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& out) : out(out) {}
+
+    template <typename T>
+    void value(const T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalars are written raw");
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void stats(const VehicleStats& stats) {
+        value(stats.flightTime);
+        value(stats.queuedTime);
+        value(stats.distanceTraveled);
+        value(stats.chargingTime);
+        value(stats.faultedTime);
+        value(stats.faults);
+        value(stats.passengerMiles);
+        value(stats.flights);
+        value(stats.charges);
+    }
+
+    template <typename T>
+    void values(const std::vector<T>& values) {
+        value(static_cast<uint64_t>(values.size()));
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    void distribution(const StreamingDistribution& distribution) {
+        const RunningMoments& moments = distribution.getMoments();
+        value(moments.getCount());
+        value(moments.getMean());
+        value(moments.getSumOfSquares());
+        value(moments.getMin());
+        value(moments.getMax());
+        values(distribution.getHistogram().getIndices());
+        values(distribution.getHistogram().getCounts());
+    }
+
+private:
+    std::ostream& out;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(std::istream& in, uint64_t length) : in(in), length(length) {}
+
+    template <typename T>
+    void value(T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalars are read raw");
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+
+    void stats(VehicleStats& stats) {
+        value(stats.flightTime);
+        value(stats.queuedTime);
+        value(stats.distanceTraveled);
+        value(stats.chargingTime);
+        value(stats.faultedTime);
+        value(stats.faults);
+        value(stats.passengerMiles);
+        value(stats.flights);
+        value(stats.charges);
+    }
+
+    // Size of a vector of elements of elementBytes each, which must fit in the rest of the file
+    uint64_t size(uint64_t elementBytes) {
+        uint64_t count = 0;
+        value(count);
+        std::streamoff position = in.tellg();
+        uint64_t remaining = position >= 0 && static_cast<uint64_t>(position) <= length ? length - position : 0;
+        if (count > MAX_ELEMENTS || count > remaining / elementBytes) {
+            in.setstate(std::ios::failbit);
+            return 0;
+        }
+        return count;
+    }
+
+    template <typename T>
+    void values(std::vector<T>& values) {
+        values.resize(size(sizeof(T)));
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    void distribution(StreamingDistribution& distribution) {
+        uint64_t count = 0;
+        double mean = 0.0, m2 = 0.0, min = 0.0, max = 0.0;
+        std::vector<uint32_t> indices;
+        std::vector<uint64_t> counts;
+        value(count);
+        value(mean);
+        value(m2);
+        value(min);
+        value(max);
+        values(indices);
+        values(counts);
+        distribution.getMoments().restore(count, mean, m2, min, max);
+        if (!distribution.getHistogram().restore(indices, counts) || distribution.getHistogram().getCount() != count) {
+            in.setstate(std::ios::failbit);
+        }
+    }
+
+    bool ok() const { return static_cast<bool>(in); }
+
+private:
+    std::istream& in;
+    uint64_t length; // Bytes of the file
+};
+
+} // namespace
+
+bool SimulationCheckpoint::write(const std::string& filename) const {
+    // Write next to the target and rename, an interrupted write never replaces a good checkpoint
+    std::filesystem::path path(filename);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        BinaryWriter out(file);
+        file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        out.value(CHECKPOINT_VERSION);
+
+        out.value(numVehicles);
+        out.value(simHours);
+        out.value(numChargers);
+        out.value(numVertiports);
+        out.value(dispatchPolicy);
+        out.value(simTimeStepSeconds);
+        out.value(static_cast<uint8_t>(randomizeVehicles));
+        out.value(engine);
+        out.value(faultModel);
+        out.value(seed);
+
+        out.value(currentTime);
+        out.value(stepCount);
+        out.value(rngCounter);
+
+        out.value(static_cast<uint64_t>(vehicles.size()));
+        for (const auto& vehicle : vehicles) {
+            out.value(vehicle.manufacturer);
+            out.value(vehicle.state);
+            out.value(vehicle.faultModel);
+            out.value(vehicle.batteryLevel);
+            out.value(vehicle.flightTimeToFault);
+            out.stats(vehicle.stepStats);
+            out.stats(vehicle.totalStats);
+            out.value(vehicle.rngCounter);
+        }
+
+        out.values(chargingQueue);
+        out.values(queuePriorities);
+        out.values(chargingStations);
+        out.values(freeChargers);
+        out.values(doneCharging);
+        out.values(vehicleSites);
+        out.values(siteVirtualTimes);
+        out.values(siteFinishTags);
+
+        out.value(static_cast<uint64_t>(typeStats.size()));
+        for (const auto& stats : typeStats) {
+            out.value(stats.manufacturer);
+            out.value(stats.totalFlights);
+            out.value(stats.totalCharges);
+            out.value(stats.totalFlightTime);
+            out.value(stats.totalDistance);
+            out.value(stats.totalChargingTime);
+            out.value(stats.totalQueuedTime);
+            out.value(stats.totalFaults);
+            out.value(stats.totalPassengerMiles);
+            out.distribution(stats.queueWaitTimes);
+            out.distribution(stats.chargeTimes);
+            out.distribution(stats.flightTimes);
+        }
+        out.values(sessionClocks);
+        out.value(utilizationFirstWindow);
+        out.values(utilizationValues);
+        out.values(parkedSince);
+
+        out.value(static_cast<uint64_t>(events.size()));
+        for (const auto& event : events) {
+            out.value(event.time);
+            out.value(event.sequence);
+            out.value(event.vehicleIndex);
+        }
+        out.value(eventSequence);
+        out.values(lastUpdateTime);
+
+        if (!file.flush()) {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    return !error;
+}
+
+bool SimulationCheckpoint::read(const std::string& filename, SimulationCheckpoint& checkpoint) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    std::streamoff length = file.tellg();
+    file.seekg(0);
+    char magic[sizeof(CHECKPOINT_MAGIC)] = {};
+    uint32_t version = 0;
+    BinaryReader in(file, length > 0 ? static_cast<uint64_t>(length) : 0);
+    file.read(magic, sizeof(magic));
+    in.value(version);
+    if (!in.ok() || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 || version != CHECKPOINT_VERSION) {
+        return false;
+    }
+
+    SimulationCheckpoint parsed;
+    uint8_t randomize = 0;
+    in.value(parsed.numVehicles);
+    in.value(parsed.simHours);
+    in.value(parsed.numChargers);
+    in.value(parsed.numVertiports);
+    in.value(parsed.dispatchPolicy);
+    in.value(parsed.simTimeStepSeconds);
+    in.value(randomize);
+    in.value(parsed.engine);
+    in.value(parsed.faultModel);
+    in.value(parsed.seed);
+    parsed.randomizeVehicles = randomize != 0;
+
+    in.value(parsed.currentTime);
+    in.value(parsed.stepCount);
+    in.value(parsed.rngCounter);
+
+    // The vehicle count is checked before anything of that size is allocated
+    uint64_t numVehicles = in.size(VEHICLE_BYTES);
+    if (!in.ok() || parsed.numVehicles < 0 || numVehicles != static_cast<uint64_t>(parsed.numVehicles)) {
+        return false;
+    }
+    parsed.vehicles.resize(numVehicles);
+    for (auto& vehicle : parsed.vehicles) {
+        in.value(vehicle.manufacturer);
+        in.value(vehicle.state);
+        in.value(vehicle.faultModel);
+        in.value(vehicle.batteryLevel);
+        in.value(vehicle.flightTimeToFault);
+        in.stats(vehicle.stepStats);
+        in.stats(vehicle.totalStats);
+        in.value(vehicle.rngCounter);
+    }
+
+    in.values(parsed.chargingQueue);
+    in.values(parsed.queuePriorities);
+    in.values(parsed.chargingStations);
+    in.values(parsed.freeChargers);
+    in.values(parsed.doneCharging);
+    in.values(parsed.vehicleSites);
+    in.values(parsed.siteVirtualTimes);
+    in.values(parsed.siteFinishTags);
+
+    parsed.typeStats.resize(in.size(TYPE_STATS_MIN_BYTES));
+    for (auto& stats : parsed.typeStats) {
+        in.value(stats.manufacturer);
+        in.value(stats.totalFlights);
+        in.value(stats.totalCharges);
+        in.value(stats.totalFlightTime);
+        in.value(stats.totalDistance);
+        in.value(stats.totalChargingTime);
+        in.value(stats.totalQueuedTime);
+        in.value(stats.totalFaults);
+        in.value(stats.totalPassengerMiles);
+        in.distribution(stats.queueWaitTimes);
+        in.distribution(stats.chargeTimes);
+        in.distribution(stats.flightTimes);
+    }
+    in.values(parsed.sessionClocks);
+    in.value(parsed.utilizationFirstWindow);
+    in.values(parsed.utilizationValues);
+    in.values(parsed.parkedSince);
+
+    parsed.events.resize(in.size(EVENT_BYTES));
+    for (auto& event : parsed.events) {
+        in.value(event.time);
+        in.value(event.sequence);
+        in.value(event.vehicleIndex);
+    }
+    in.value(parsed.eventSequence);
+    in.values(parsed.lastUpdateTime);
+
+    if (!in.ok() || parsed.vehicles.size() != static_cast<size_t>(parsed.numVehicles) ||
+        parsed.chargingStations.size() != static_cast<size_t>(parsed.numChargers) ||
+        parsed.vehicleSites.size() != static_cast<size_t>(parsed.numVehicles) ||
+        parsed.sessionClocks.size() != 3 * static_cast<size_t>(parsed.numVehicles) ||
+        parsed.parkedSince.size() != static_cast<size_t>(parsed.numVehicles)) {
+        return false;
+    }
+    checkpoint = std::move(parsed);
+    return true;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file checkpoint.hpp
+ * @brief Header file for the SimulationCheckpoint structure
+ *
+ * A checkpoint is a snapshot of the complete state of a Simulation between two steps (or
+ * events): its configuration, the simulation time, every vehicle including the position
+ * of its random number stream, the charging queues and stations of every vertiport, the accumulated
+ * statistics and the event queue of the event engine. Resuming from a checkpoint
+ * continues the run exactly as if it had not been interrupted.
+ *
+ * Checkpoints are written in a compact binary format in native byte order, see
+ * SimulationCheckpoint::write.
+ */
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "simulation.hpp"
+
+const uint32_t CHECKPOINT_VERSION = 5; // Bump whenever the checkpoint layout changes
+
+struct VehicleCheckpoint {
+    Vehicle::Manufacturer manufacturer;
+    Vehicle::State state;
+    Vehicle::FaultModel faultModel;
+    double batteryLevel;
+    double flightTimeToFault;
+    VehicleStats stepStats;
+    VehicleStats totalStats;
+    uint64_t rngCounter; // Draws taken from the vehicle's random number stream
+};
+
+struct EventCheckpoint {
+    double time;
+    uint64_t sequence;
+    uint64_t vehicleIndex;
+};
+
+struct SimulationCheckpoint {
+    // Configuration
+    int numVehicles = 0;
+    double simHours = 0.0;
+    int numChargers = 0;
+    int numVertiports = DEFAULT_VERTIPORTS;
+    DispatchPolicy dispatchPolicy = DEFAULT_DISPATCH_POLICY;
+    double simTimeStepSeconds = DEFAULT_TIME_STEP_SECONDS;
+    bool randomizeVehicles = true;
+    SimulationEngine engine = DEFAULT_ENGINE;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+    uint64_t seed = 0;
+
+    // Time
+    double currentTime = 0.0;
+    int stepCount = 0;
+
+    // State
+    uint64_t rngCounter = 0;                  // Draws taken from the simulation stream
+    std::vector<VehicleCheckpoint> vehicles;
+    std::vector<uint64_t> chargingQueue;      // Vehicle indices, front first, site after site
+    std::vector<double> queuePriorities;      // Dispatch priority of every vehicle in chargingQueue
+    std::vector<int64_t> chargingStations;    // Vehicle index per charger, -1 = available
+    std::vector<int32_t> freeChargers;        // Stacks of available chargers, top last, site after site
+    std::vector<int32_t> vehicleSites;        // Vertiport of each vehicle
+    std::vector<double> siteVirtualTimes;     // Fair share dispatch state, see VertiportNetwork
+    std::vector<double> siteFinishTags;
+    std::vector<uint64_t> doneCharging;       // Vehicles whose charger is released on the next step
+    std::vector<VehicleTypeStats> typeStats;  // Accumulated statistics, the totals and session distributions are restored
+    std::vector<double> sessionClocks;        // Flight, queued and charging totals of each vehicle at the start of its open sessions
+    uint64_t utilizationFirstWindow = 0;      // Charger utilization series, see Simulation::getChargerUtilization
+    std::vector<double> utilizationValues;
+    std::vector<double> parkedSince;          // Fast-forward of waiting vehicles, see Simulation::setFastForward
+
+    // Event engine
+    std::vector<EventCheckpoint> events;
+    uint64_t eventSequence = 0;
+    std::vector<double> lastUpdateTime;
+
+    /**
+     * @brief Write the checkpoint, replacing the file only once it is complete.
+     * @return False if the file could not be written.
+     */
+    bool write(const std::string& filename) const;
+
+    /**
+     * @brief Read a checkpoint written by write().
+     * @return False if the file is missing, truncated, of another version or holds counts that
+     *         do not match its configuration or the size of the file.
+     */
+    static bool read(const std::string& filename, SimulationCheckpoint& checkpoint);
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file counter_rng.cpp
+ * @brief Implementation file for the CounterRandomGenerator class
+ *
+ * See counter_rng.hpp for class documentation.
+ */
+
+#include "counter_rng.hpp"
+#include <cmath>
+#include <limits>
+
+namespace {
+const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL; // SplitMix64 increment
+}
+
+CounterRandomGenerator::CounterRandomGenerator(uint64_t seed, uint64_t stream)
+    : seed(seed), stream(stream), key(streamKey(seed, stream)) {
+}
+
+uint64_t CounterRandomGenerator::mix(uint64_t value) {
+    // SplitMix64 finalizer
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+uint64_t CounterRandomGenerator::streamKey(uint64_t seed, uint64_t stream) {
+    // Hash both parts so neighbouring seeds and streams give unrelated keys
+    return mix(mix(seed + GOLDEN_GAMMA) ^ (stream * GOLDEN_GAMMA + 0x632BE59BD9B4E019ULL));
+}
+
+uint64_t CounterRandomGenerator::draw(uint64_t key, uint64_t counter) {
+    return mix(key + (counter + 1) * GOLDEN_GAMMA);
+}
+
+uint64_t CounterRandomGenerator::at(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return draw(streamKey(seed, stream), counter);
+}
+
+bool CounterRandomGenerator::bernoulli(double p) {
+    return nextUnit() < p;
+}
+
+int CounterRandomGenerator::uniformInt(int min, int max) {
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    // Multiply-shift maps the upper 32 bits onto [0, range) without a division
+    return min + static_cast<int>(((next() >> 32) * range) >> 32);
+}
+
+double CounterRandomGenerator::exponential(double rate) {
+    if (rate <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return -std::log1p(-nextUnit()) / rate;
+}
+
+void CounterRandomGenerator::fillBernoulli(double p, uint8_t* out, size_t count) {
+    // Independent draws, written so the loop can be vectorized
+    const uint64_t base = counter;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = (static_cast<double>(draw(key, base + i) >> 11) * 0x1.0p-53) < p;
+    }
+    counter += count;
+}
+
+void CounterRandomGenerator::fillUniformInt(int min, int max, int* out, size_t count) {
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    const uint64_t base = counter;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = min + static_cast<int>(((draw(key, base + i) >> 32) * range) >> 32);
+    }
+    counter += count;
+}
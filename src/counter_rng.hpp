@@ -0,0 +1,55 @@
+/**
+ * @file counter_rng.hpp
+ * @brief Header file for the CounterRandomGenerator class
+ *
+ * Counter-based random number generator: draw n of a stream is a pure function of
+ * (seed, stream, n), computed with the SplitMix64 finalizer. There is no shared engine
+ * state, so every vehicle can own a stream that is reproducible bit for bit regardless
+ * of which thread advances it or in which order the vehicles are updated, and a stream
+ * can be repositioned by setting its counter.
+ */
+
+#ifndef COUNTER_RNG_HPP
+#define COUNTER_RNG_HPP
+
+#include "interface_rng.hpp"
+#include <cstdint>
+
+class CounterRandomGenerator : public RandomGenerator {
+public:
+    CounterRandomGenerator(uint64_t seed = 0, uint64_t stream = 0);
+
+    bool bernoulli(double p) override;
+    int uniformInt(int min, int max) override;
+    double exponential(double rate) override;
+
+    void fillBernoulli(double p, uint8_t* out, size_t count) override;
+    void fillUniformInt(int min, int max, int* out, size_t count) override;
+
+    uint64_t getSeed() const { return seed; }
+    uint64_t getStream() const { return stream; }
+
+    // Index of the next draw
+    uint64_t getCounter() const { return counter; }
+    void setCounter(uint64_t value) { counter = value; }
+
+    /**
+     * @brief Raw 64 bit value of draw `counter` of the stream (seed, stream).
+     */
+    static uint64_t at(uint64_t seed, uint64_t stream, uint64_t counter);
+
+private:
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t key;     // Derived from seed and stream once
+    uint64_t counter = 0;
+
+    uint64_t next() { return draw(key, counter++); }
+    double nextUnit() { return static_cast<double>(next() >> 11) * 0x1.0p-53; } // [0, 1)
+
+    static uint64_t mix(uint64_t value);
+    static uint64_t streamKey(uint64_t seed, uint64_t stream);
+    static uint64_t draw(uint64_t key, uint64_t counter);
+};
+
+#endif
@@ -0,0 +1,389 @@
+/**
+ * @file fleet_kernels.cpp
+ * @brief Implementation file for the FleetSoA batch kernels
+ *
+ * See fleet_kernels.hpp for documentation. Every SIMD kernel computes the same operations
+ * in the same order as the scalar lane functions (which follow Vehicle::fly and
+ * Vehicle::charge), so all instruction sets give the same results as Vehicle.
+ */
+
+#include "fleet_kernels.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FLEET_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FLEET_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+const uint8_t READY = static_cast<uint8_t>(Vehicle::State::Ready);
+const uint8_t FLYING = static_cast<uint8_t>(Vehicle::State::Flying);
+const uint8_t QUEUED = static_cast<uint8_t>(Vehicle::State::Queued);
+const uint8_t CHARGING = static_cast<uint8_t>(Vehicle::State::Charging);
+
+/* Scalar lanes, also used for the tails of the SIMD kernels */
+inline void chargeLane(FleetSoA& fleet, const FleetSoA::TypeColumns& types, size_t i) {
+    if (fleet.state[i] != CHARGING || !(fleet.remaining[i] > 0)) {
+        return;
+    }
+
+    const uint8_t type = fleet.manufacturer[i];
+    const double capacity = types.batteryCapacity[type];
+    const double chargeRate = types.chargeRate[type];
+
+    double energyToAdd = std::min(capacity - fleet.battery[i], chargeRate * fleet.remaining[i]);
+    double timeUsed = energyToAdd / chargeRate;
+    double battery = std::max(std::min(fleet.battery[i] + energyToAdd, capacity), 0.0);
+
+    fleet.step.chargingTime[i] += timeUsed;
+    fleet.remaining[i] -= timeUsed;
+
+    if (battery >= capacity - EPSILON) {
+        battery = capacity;
+        fleet.state[i] = READY;
+        fleet.step.charges[i]++;
+    }
+    fleet.battery[i] = battery;
+}
+
+inline void flyLane(FleetSoA& fleet, const FleetSoA::TypeColumns& types, size_t i) {
+    if (fleet.state[i] != FLYING || !(fleet.remaining[i] > 0)) {
+        return;
+    }
+
+    const uint8_t type = fleet.manufacturer[i];
+    const double cruiseSpeed = types.cruiseSpeed[type];
+    const double energyUsePerMile = types.energyUsePerMile[type];
+
+    // A depleted battery gives zero flight time and falls through to the Queued case
+    double flightTime = std::min(fleet.remaining[i], fleet.battery[i] / energyUsePerMile / cruiseSpeed);
+    double distance = cruiseSpeed * flightTime;
+    double battery = std::max(fleet.battery[i] - distance * energyUsePerMile, 0.0);
+
+    fleet.step.flightTime[i] += flightTime;
+    fleet.step.distanceTraveled[i] += distance;
+    fleet.step.passengerMiles[i] += distance * types.passengerCount[type];
+    fleet.remaining[i] -= flightTime;
+
+    if (battery <= EPSILON) {
+        battery = 0.0;
+        fleet.state[i] = QUEUED;
+        fleet.step.flights[i]++;
+        fleet.step.queuedTime[i] += fleet.remaining[i];
+        fleet.remaining[i] = 0.0;
+    }
+    fleet.battery[i] = battery;
+}
+
+void updateChargingScalar(FleetSoA& fleet, size_t begin, size_t end) {
+    const FleetSoA::TypeColumns& types = fleet.typeColumns();
+    for (size_t i = begin; i < end; ++i) {
+        chargeLane(fleet, types, i);
+    }
+}
+
+void updateFlyingScalar(FleetSoA& fleet, size_t begin, size_t end) {
+    const FleetSoA::TypeColumns& types = fleet.typeColumns();
+    for (size_t i = begin; i < end; ++i) {
+        flyLane(fleet, types, i);
+    }
+}
+
+#ifdef FLEET_KERNELS_AVX2
+/* AVX2, 4 vehicles per iteration */
+__attribute__((target("avx2")))
+inline __m256i loadBytesAvx2(const uint8_t* bytes) {
+    int32_t packed;
+    std::memcpy(&packed, bytes, sizeof(packed));
+    return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+}
+
+__attribute__((target("avx2")))
+inline __m256d activeMaskAvx2(const uint8_t* state, uint8_t wanted, __m256d remaining) {
+    __m256i inState = _mm256_cmpeq_epi64(loadBytesAvx2(state), _mm256_set1_epi64x(wanted));
+    return _mm256_and_pd(_mm256_castsi256_pd(inState), _mm256_cmp_pd(remaining, _mm256_setzero_pd(), _CMP_GT_OQ));
+}
+
+__attribute__((target("avx2")))
+inline void setStateAvx2(uint8_t* state, int* counter, int laneMask, uint8_t value) {
+    // Transitions are rare, set them and count them one lane at a time
+    for (int lane = 0; lane < 4; ++lane) {
+        if (laneMask & (1 << lane)) {
+            state[lane] = value;
+            counter[lane]++;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void updateChargingAvx2(FleetSoA& fleet, size_t begin, size_t end) {
+    const FleetSoA::TypeColumns& types = fleet.typeColumns();
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d epsilon = _mm256_set1_pd(EPSILON);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256d remaining = _mm256_loadu_pd(&fleet.remaining[i]);
+        __m256d active = activeMaskAvx2(&fleet.state[i], CHARGING, remaining);
+        if (_mm256_movemask_pd(active) == 0) {
+            continue;
+        }
+
+        __m256i type = loadBytesAvx2(&fleet.manufacturer[i]);
+        __m256d capacity = _mm256_i64gather_pd(types.batteryCapacity, type, 8);
+        __m256d chargeRate = _mm256_i64gather_pd(types.chargeRate, type, 8);
+        __m256d battery = _mm256_loadu_pd(&fleet.battery[i]);
+
+        // min(b, a) with the operands swapped returns the same value as std::min(a, b)
+        __m256d energyToAdd = _mm256_min_pd(_mm256_mul_pd(chargeRate, remaining), _mm256_sub_pd(capacity, battery));
+        __m256d timeUsed = _mm256_div_pd(energyToAdd, chargeRate);
+        __m256d newBattery = _mm256_max_pd(_mm256_min_pd(_mm256_add_pd(battery, energyToAdd), capacity), zero);
+
+        __m256d full = _mm256_and_pd(active, _mm256_cmp_pd(newBattery, _mm256_sub_pd(capacity, epsilon), _CMP_GE_OQ));
+        newBattery = _mm256_blendv_pd(newBattery, capacity, full);
+
+        __m256d chargingTime = _mm256_loadu_pd(&fleet.step.chargingTime[i]);
+        _mm256_storeu_pd(&fleet.step.chargingTime[i], _mm256_blendv_pd(chargingTime, _mm256_add_pd(chargingTime, timeUsed), active));
+        _mm256_storeu_pd(&fleet.remaining[i], _mm256_blendv_pd(remaining, _mm256_sub_pd(remaining, timeUsed), active));
+        _mm256_storeu_pd(&fleet.battery[i], _mm256_blendv_pd(battery, newBattery, active));
+        setStateAvx2(&fleet.state[i], &fleet.step.charges[i], _mm256_movemask_pd(full), READY);
+    }
+
+    updateChargingScalar(fleet, i, end);
+}
+
+__attribute__((target("avx2")))
+void updateFlyingAvx2(FleetSoA& fleet, size_t begin, size_t end) {
+    const FleetSoA::TypeColumns& types = fleet.typeColumns();
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d epsilon = _mm256_set1_pd(EPSILON);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256d remaining = _mm256_loadu_pd(&fleet.remaining[i]);
+        __m256d active = activeMaskAvx2(&fleet.state[i], FLYING, remaining);
+        if (_mm256_movemask_pd(active) == 0) {
+            continue;
+        }
+
+        __m256i type = loadBytesAvx2(&fleet.manufacturer[i]);
+        __m256d cruiseSpeed = _mm256_i64gather_pd(types.cruiseSpeed, type, 8);
+        __m256d energyUsePerMile = _mm256_i64gather_pd(types.energyUsePerMile, type, 8);
+        __m256d passengerCount = _mm256_i64gather_pd(types.passengerCount, type, 8);
+        __m256d battery = _mm256_loadu_pd(&fleet.battery[i]);
+
+        __m256d maxFlightTime = _mm256_div_pd(_mm256_div_pd(battery, energyUsePerMile), cruiseSpeed);
+        __m256d flightTime = _mm256_min_pd(maxFlightTime, remaining);
+        __m256d distance = _mm256_mul_pd(cruiseSpeed, flightTime);
+        __m256d newBattery = _mm256_max_pd(_mm256_sub_pd(battery, _mm256_mul_pd(distance, energyUsePerMile)), zero);
+        __m256d newRemaining = _mm256_sub_pd(remaining, flightTime);
+
+        __m256d depleted = _mm256_and_pd(active, _mm256_cmp_pd(newBattery, epsilon, _CMP_LE_OQ));
+        newBattery = _mm256_blendv_pd(newBattery, zero, depleted);
+
+        __m256d flight = _mm256_loadu_pd(&fleet.step.flightTime[i]);
+        __m256d distanceTraveled = _mm256_loadu_pd(&fleet.step.distanceTraveled[i]);
+        __m256d passengerMiles = _mm256_loadu_pd(&fleet.step.passengerMiles[i]);
+        __m256d queued = _mm256_loadu_pd(&fleet.step.queuedTime[i]);
+
+        _mm256_storeu_pd(&fleet.step.flightTime[i], _mm256_blendv_pd(flight, _mm256_add_pd(flight, flightTime), active));
+        _mm256_storeu_pd(&fleet.step.distanceTraveled[i], _mm256_blendv_pd(distanceTraveled, _mm256_add_pd(distanceTraveled, distance), active));
+        _mm256_storeu_pd(&fleet.step.passengerMiles[i],
+                         _mm256_blendv_pd(passengerMiles, _mm256_add_pd(passengerMiles, _mm256_mul_pd(distance, passengerCount)), active));
+        _mm256_storeu_pd(&fleet.step.queuedTime[i], _mm256_blendv_pd(queued, _mm256_add_pd(queued, newRemaining), depleted));
+        _mm256_storeu_pd(&fleet.remaining[i],
+                         _mm256_blendv_pd(remaining, _mm256_blendv_pd(newRemaining, zero, depleted), active));
+        _mm256_storeu_pd(&fleet.battery[i], _mm256_blendv_pd(battery, newBattery, active));
+        setStateAvx2(&fleet.state[i], &fleet.step.flights[i], _mm256_movemask_pd(depleted), QUEUED);
+    }
+
+    updateFlyingScalar(fleet, i, end);
+}
+
+bool cpuHasAvx2() {
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#ifdef FLEET_KERNELS_NEON
+/* NEON, 2 vehicles per iteration */
+inline uint64x2_t activeMaskNeon(const uint8_t* state, uint8_t wanted, float64x2_t remaining) {
+    uint64x2_t inState = vcombine_u64(vcreate_u64(state[0] == wanted ? ~0ULL : 0ULL),
+                                      vcreate_u64(state[1] == wanted ? ~0ULL : 0ULL));
+    return vandq_u64(inState, vcgtq_f64(remaining, vdupq_n_f64(0.0)));
+}
+
+inline float64x2_t gatherNeon(const double* table, const uint8_t* type) {
+    return vcombine_f64(vld1_f64(&table[type[0]]), vld1_f64(&table[type[1]]));
+}
+
+inline bool anyLaneNeon(uint64x2_t mask) {
+    return (vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)) != 0;
+}
+
+inline void setStateNeon(uint8_t* state, int* counter, uint64x2_t mask, uint8_t value) {
+    if (vgetq_lane_u64(mask, 0)) { state[0] = value; counter[0]++; }
+    if (vgetq_lane_u64(mask, 1)) { state[1] = value; counter[1]++; }
+}
+
+void updateChargingNeon(FleetSoA& fleet, size_t begin, size_t end) {
+    const FleetSoA::TypeColumns& types = fleet.typeColumns();
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t epsilon = vdupq_n_f64(EPSILON);
+
+    size_t i = begin;
+    for (; i + 2 <= end; i += 2) {
+        float64x2_t remaining = vld1q_f64(&fleet.remaining[i]);
+        uint64x2_t active = activeMaskNeon(&fleet.state[i], CHARGING, remaining);
+        if (!anyLaneNeon(active)) {
+            continue;
+        }
+
+        float64x2_t capacity = gatherNeon(types.batteryCapacity, &fleet.manufacturer[i]);
+        float64x2_t chargeRate = gatherNeon(types.chargeRate, &fleet.manufacturer[i]);
+        float64x2_t battery = vld1q_f64(&fleet.battery[i]);
+
+        float64x2_t energyToAdd = vminq_f64(vsubq_f64(capacity, battery), vmulq_f64(chargeRate, remaining));
+        float64x2_t timeUsed = vdivq_f64(energyToAdd, chargeRate);
+        float64x2_t newBattery = vmaxq_f64(vminq_f64(vaddq_f64(battery, energyToAdd), capacity), zero);
+
+        uint64x2_t full = vandq_u64(active, vcgeq_f64(newBattery, vsubq_f64(capacity, epsilon)));
+        newBattery = vbslq_f64(full, capacity, newBattery);
+
+        float64x2_t chargingTime = vld1q_f64(&fleet.step.chargingTime[i]);
+        vst1q_f64(&fleet.step.chargingTime[i], vbslq_f64(active, vaddq_f64(chargingTime, timeUsed), chargingTime));
+        vst1q_f64(&fleet.remaining[i], vbslq_f64(active, vsubq_f64(remaining, timeUsed), remaining));
+        vst1q_f64(&fleet.battery[i], vbslq_f64(active, newBattery, battery));
+        setStateNeon(&fleet.state[i], &fleet.step.charges[i], full, READY);
+    }
+
+    updateChargingScalar(fleet, i, end);
+}
+
+void updateFlyingNeon(FleetSoA& fleet, size_t begin, size_t end) {
+    const FleetSoA::TypeColumns& types = fleet.typeColumns();
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t epsilon = vdupq_n_f64(EPSILON);
+
+    size_t i = begin;
+    for (; i + 2 <= end; i += 2) {
+        float64x2_t remaining = vld1q_f64(&fleet.remaining[i]);
+        uint64x2_t active = activeMaskNeon(&fleet.state[i], FLYING, remaining);
+        if (!anyLaneNeon(active)) {
+            continue;
+        }
+
+        float64x2_t cruiseSpeed = gatherNeon(types.cruiseSpeed, &fleet.manufacturer[i]);
+        float64x2_t energyUsePerMile = gatherNeon(types.energyUsePerMile, &fleet.manufacturer[i]);
+        float64x2_t passengerCount = gatherNeon(types.passengerCount, &fleet.manufacturer[i]);
+        float64x2_t battery = vld1q_f64(&fleet.battery[i]);
+
+        float64x2_t maxFlightTime = vdivq_f64(vdivq_f64(battery, energyUsePerMile), cruiseSpeed);
+        float64x2_t flightTime = vminq_f64(remaining, maxFlightTime);
+        float64x2_t distance = vmulq_f64(cruiseSpeed, flightTime);
+        float64x2_t newBattery = vmaxq_f64(vsubq_f64(battery, vmulq_f64(distance, energyUsePerMile)), zero);
+        float64x2_t newRemaining = vsubq_f64(remaining, flightTime);
+
+        uint64x2_t depleted = vandq_u64(active, vcleq_f64(newBattery, epsilon));
+        newBattery = vbslq_f64(depleted, zero, newBattery);
+
+        float64x2_t flight = vld1q_f64(&fleet.step.flightTime[i]);
+        float64x2_t distanceTraveled = vld1q_f64(&fleet.step.distanceTraveled[i]);
+        float64x2_t passengerMiles = vld1q_f64(&fleet.step.passengerMiles[i]);
+        float64x2_t queued = vld1q_f64(&fleet.step.queuedTime[i]);
+
+        vst1q_f64(&fleet.step.flightTime[i], vbslq_f64(active, vaddq_f64(flight, flightTime), flight));
+        vst1q_f64(&fleet.step.distanceTraveled[i], vbslq_f64(active, vaddq_f64(distanceTraveled, distance), distanceTraveled));
+        vst1q_f64(&fleet.step.passengerMiles[i],
+                  vbslq_f64(active, vaddq_f64(passengerMiles, vmulq_f64(distance, passengerCount)), passengerMiles));
+        vst1q_f64(&fleet.step.queuedTime[i], vbslq_f64(depleted, vaddq_f64(queued, newRemaining), queued));
+        vst1q_f64(&fleet.remaining[i], vbslq_f64(active, vbslq_f64(depleted, zero, newRemaining), remaining));
+        vst1q_f64(&fleet.battery[i], vbslq_f64(active, newBattery, battery));
+        setStateNeon(&fleet.state[i], &fleet.step.flights[i], depleted, QUEUED);
+    }
+
+    updateFlyingScalar(fleet, i, end);
+}
+#endif
+
+bool isSupported(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::Scalar: return true;
+#ifdef FLEET_KERNELS_AVX2
+        case KernelIsa::Avx2: return cpuHasAvx2();
+#endif
+#ifdef FLEET_KERNELS_NEON
+        case KernelIsa::Neon: return true;
+#endif
+        default: return false;
+    }
+}
+
+KernelIsa& selectedIsa() {
+    static KernelIsa isa = detectKernelIsa();
+    return isa;
+}
+
+} // namespace
+
+std::string kernelIsaToString(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::Scalar: return "scalar";
+        case KernelIsa::Avx2: return "avx2";
+        case KernelIsa::Neon: return "neon";
+        default: return "unknown";
+    }
+}
+
+KernelIsa detectKernelIsa() {
+    if (isSupported(KernelIsa::Avx2)) {
+        return KernelIsa::Avx2;
+    }
+    if (isSupported(KernelIsa::Neon)) {
+        return KernelIsa::Neon;
+    }
+    return KernelIsa::Scalar;
+}
+
+KernelIsa getKernelIsa() {
+    return selectedIsa();
+}
+
+bool setKernelIsa(KernelIsa isa) {
+    if (!isSupported(isa)) {
+        return false;
+    }
+    selectedIsa() = isa;
+    return true;
+}
+
+void updateCharging(const FleetSpan& span) {
+    switch (getKernelIsa()) {
+#ifdef FLEET_KERNELS_AVX2
+        case KernelIsa::Avx2: updateChargingAvx2(span.fleet, span.begin, span.end); break;
+#endif
+#ifdef FLEET_KERNELS_NEON
+        case KernelIsa::Neon: updateChargingNeon(span.fleet, span.begin, span.end); break;
+#endif
+        default: updateChargingScalar(span.fleet, span.begin, span.end); break;
+    }
+}
+
+void updateFlying(const FleetSpan& span) {
+    switch (getKernelIsa()) {
+#ifdef FLEET_KERNELS_AVX2
+        case KernelIsa::Avx2: updateFlyingAvx2(span.fleet, span.begin, span.end); break;
+#endif
+#ifdef FLEET_KERNELS_NEON
+        case KernelIsa::Neon: updateFlyingNeon(span.fleet, span.begin, span.end); break;
+#endif
+        default: updateFlyingScalar(span.fleet, span.begin, span.end); break;
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * @file fleet_kernels.hpp
+ * @brief Batch kernels for the Charging and Flying updates of a FleetSoA
+ *
+ * The kernels advance every vehicle of a span that is in the matching state by the time
+ * left in its remaining column, with the same arithmetic as Vehicle::charge() and
+ * Vehicle::fly(). Branches are turned into lane masks so several vehicles are updated per
+ * instruction. Faults are not sampled here, FleetSoA handles them in a separate pass
+ * before updateFlying runs.
+ *
+ * The instruction set is selected at runtime (AVX2 on x86-64 when the CPU supports it,
+ * NEON on AArch64), with a scalar fallback that is always available.
+ */
+
+#ifndef FLEET_KERNELS_HPP
+#define FLEET_KERNELS_HPP
+
+#include <string>
+
+#include "fleet_soa.hpp"
+
+/**
+ * @brief Range of vehicles [begin, end) in a fleet.
+ */
+struct FleetSpan {
+    FleetSoA& fleet;
+    size_t begin;
+    size_t end;
+};
+
+enum class KernelIsa {
+    Scalar,
+    Avx2,
+    Neon
+};
+
+std::string kernelIsaToString(KernelIsa isa);
+
+/**
+ * @brief Best instruction set supported by this build and CPU.
+ */
+KernelIsa detectKernelIsa();
+
+/**
+ * @brief Instruction set currently used by the kernels, detectKernelIsa() unless overridden.
+ */
+KernelIsa getKernelIsa();
+
+/**
+ * @brief Override the instruction set, for testing and benchmarking.
+ * @return false (and no change) if the instruction set is not supported.
+ */
+bool setKernelIsa(KernelIsa isa);
+
+/**
+ * @brief Charge every Charging vehicle with remaining time, same as Vehicle::charge().
+ *
+ * Vehicles that reach full charge are set Ready, remaining is reduced by the time used.
+ */
+void updateCharging(const FleetSpan& span);
+
+/**
+ * @brief Fly every Flying vehicle with remaining time without faulting, same as Vehicle::fly().
+ *
+ * Vehicles that deplete their battery are set Queued and spend the rest of their time
+ * waiting, remaining is reduced by the time used.
+ */
+void updateFlying(const FleetSpan& span);
+
+#endif
@@ -0,0 +1,474 @@
+/**
+ * @file fleet_soa.cpp
+ * @brief Implementation file for the FleetSoA class
+ *
+ * See fleet_soa.hpp for class documentation.
+ */
+
+#include "fleet_soa.hpp"
+#include "fleet_kernels.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+/* FleetStatsColumns */
+void FleetStatsColumns::resize(size_t size) {
+    flightTime.resize(size, 0.0);
+    queuedTime.resize(size, 0.0);
+    distanceTraveled.resize(size, 0.0);
+    chargingTime.resize(size, 0.0);
+    faultedTime.resize(size, 0.0);
+    faults.resize(size, 0);
+    passengerMiles.resize(size, 0.0);
+    flights.resize(size, 0);
+    charges.resize(size, 0);
+}
+
+void FleetStatsColumns::reset(size_t index) {
+    flightTime[index] = 0.0;
+    queuedTime[index] = 0.0;
+    distanceTraveled[index] = 0.0;
+    chargingTime[index] = 0.0;
+    faultedTime[index] = 0.0;
+    faults[index] = 0;
+    passengerMiles[index] = 0.0;
+    flights[index] = 0;
+    charges[index] = 0;
+}
+
+void FleetStatsColumns::add(size_t index, const FleetStatsColumns& other) {
+    flightTime[index] += other.flightTime[index];
+    queuedTime[index] += other.queuedTime[index];
+    distanceTraveled[index] += other.distanceTraveled[index];
+    chargingTime[index] += other.chargingTime[index];
+    faultedTime[index] += other.faultedTime[index];
+    faults[index] += other.faults[index];
+    passengerMiles[index] += other.passengerMiles[index];
+    flights[index] += other.flights[index];
+    charges[index] += other.charges[index];
+}
+
+void FleetStatsColumns::resetRange(size_t begin, size_t end) {
+    for (auto* column : {&flightTime, &queuedTime, &distanceTraveled, &chargingTime, &faultedTime, &passengerMiles}) {
+        std::fill(column->begin() + begin, column->begin() + end, 0.0);
+    }
+    for (auto* column : {&faults, &flights, &charges}) {
+        std::fill(column->begin() + begin, column->begin() + end, 0);
+    }
+}
+
+namespace {
+
+template <typename T>
+void addColumn(std::vector<T>& column, const std::vector<T>& other, size_t begin, size_t end) {
+    T* __restrict target = column.data();
+    const T* __restrict source = other.data();
+    for (size_t i = begin; i < end; ++i) {
+        target[i] += source[i];
+    }
+}
+
+} // namespace
+
+void FleetStatsColumns::addRange(size_t begin, size_t end, const FleetStatsColumns& other) {
+    addColumn(flightTime, other.flightTime, begin, end);
+    addColumn(queuedTime, other.queuedTime, begin, end);
+    addColumn(distanceTraveled, other.distanceTraveled, begin, end);
+    addColumn(chargingTime, other.chargingTime, begin, end);
+    addColumn(faultedTime, other.faultedTime, begin, end);
+    addColumn(faults, other.faults, begin, end);
+    addColumn(passengerMiles, other.passengerMiles, begin, end);
+    addColumn(flights, other.flights, begin, end);
+    addColumn(charges, other.charges, begin, end);
+}
+
+VehicleStats FleetStatsColumns::get(size_t index) const {
+    VehicleStats stats;
+    stats.flightTime = flightTime[index];
+    stats.queuedTime = queuedTime[index];
+    stats.distanceTraveled = distanceTraveled[index];
+    stats.chargingTime = chargingTime[index];
+    stats.faultedTime = faultedTime[index];
+    stats.faults = faults[index];
+    stats.passengerMiles = passengerMiles[index];
+    stats.flights = flights[index];
+    stats.charges = charges[index];
+    return stats;
+}
+
+void FleetStatsColumns::set(size_t index, const VehicleStats& stats) {
+    flightTime[index] = stats.flightTime;
+    queuedTime[index] = stats.queuedTime;
+    distanceTraveled[index] = stats.distanceTraveled;
+    chargingTime[index] = stats.chargingTime;
+    faultedTime[index] = stats.faultedTime;
+    faults[index] = stats.faults;
+    passengerMiles[index] = stats.passengerMiles;
+    flights[index] = stats.flights;
+    charges[index] = stats.charges;
+}
+
+/* Constructor */
+FleetSoA::FleetSoA() {
+    loadTypes();
+}
+
+void FleetSoA::loadTypes() {
+    for (size_t i = 0; i < getNumVehicleTypes(); ++i) {
+        const VehicleTypeSpec& spec = getVehicleTypeSpec(static_cast<Vehicle::Manufacturer>(i));
+        types[i] = {spec, spec.energyUsePerMile * spec.cruiseSpeed, spec.batteryCapacity / spec.timeToCharge};
+
+        columns.cruiseSpeed[i] = spec.cruiseSpeed;
+        columns.batteryCapacity[i] = spec.batteryCapacity;
+        columns.energyUsePerMile[i] = spec.energyUsePerMile;
+        columns.passengerCount[i] = spec.passengerCount;
+        columns.chargeRate[i] = types[i].chargeRate;
+    }
+}
+
+void FleetSoA::clear() {
+    loadTypes();
+    manufacturer.clear();
+    state.clear();
+    battery.clear();
+    flightTimeToFault.clear();
+    faultModel.clear();
+    remaining.clear();
+    rngs.clear();
+    step.resize(0);
+    total.resize(0);
+}
+
+void FleetSoA::reserve(size_t size) {
+    manufacturer.reserve(size);
+    state.reserve(size);
+    battery.reserve(size);
+    flightTimeToFault.reserve(size);
+    faultModel.reserve(size);
+    remaining.reserve(size);
+    rngs.reserve(size);
+    for (auto* columns : {&step, &total}) {
+        columns->flightTime.reserve(size);
+        columns->queuedTime.reserve(size);
+        columns->distanceTraveled.reserve(size);
+        columns->chargingTime.reserve(size);
+        columns->faultedTime.reserve(size);
+        columns->faults.reserve(size);
+        columns->passengerMiles.reserve(size);
+        columns->flights.reserve(size);
+        columns->charges.reserve(size);
+    }
+}
+
+size_t FleetSoA::add(Vehicle::Manufacturer type, RandomGenerator& rng, Vehicle::FaultModel model) {
+    if (!VehicleTypeRegistry::instance().contains(type)) {
+        throw std::invalid_argument("Unknown vehicle type");
+    }
+    size_t index = size();
+    manufacturer.push_back(static_cast<uint8_t>(type));
+    state.push_back(static_cast<uint8_t>(Vehicle::State::Ready)); // Always start Ready
+    battery.push_back(typeConstants(type).spec.batteryCapacity);
+    flightTimeToFault.push_back(-1.0);
+    faultModel.push_back(static_cast<uint8_t>(model));
+    remaining.push_back(0.0);
+    rngs.push_back(&rng);
+    step.resize(index + 1);
+    total.resize(index + 1);
+    return index;
+}
+
+size_t FleetSoA::load(const Vehicle& vehicle) {
+    size_t index = add(vehicle.getManufacturer(), vehicle.getRandomGenerator(), vehicle.getFaultModel());
+    state[index] = static_cast<uint8_t>(vehicle.getCurrentState());
+    battery[index] = vehicle.getBatteryLevel();
+    flightTimeToFault[index] = vehicle.getFlightTimeToFault();
+    step.set(index, vehicle.getStepStats());
+    total.set(index, vehicle.getTotalStats());
+    return index;
+}
+
+void FleetSoA::store(size_t index, Vehicle& vehicle) const {
+    if (vehicle.getManufacturer() != getManufacturer(index)) {
+        throw std::invalid_argument("Vehicle manufacturer does not match fleet entry");
+    }
+    vehicle.setCurrentState(getState(index));
+    vehicle.setBatteryLevel(battery[index]);
+    vehicle.setFlightTimeToFault(flightTimeToFault[index]);
+    vehicle.setFaultModel(static_cast<Vehicle::FaultModel>(faultModel[index]));
+    vehicle.getStepStats() = step.get(index);
+    vehicle.getTotalStats() = total.get(index);
+}
+
+/* State Machine */
+void FleetSoA::setBatteryLevel(size_t index, double level) {
+    const double capacity = types[manufacturer[index]].spec.batteryCapacity;
+    if (level < 0.0) level = 0.0;
+    if (level > capacity) level = capacity;
+    battery[index] = level;
+}
+
+void FleetSoA::startFlight(size_t index) {
+    // Ready -> Flying, see Vehicle::updateState for the fault time sampling
+    state[index] = static_cast<uint8_t>(Vehicle::State::Flying);
+    if (faultModel[index] == static_cast<uint8_t>(Vehicle::FaultModel::Exponential) && flightTimeToFault[index] < 0) {
+        flightTimeToFault[index] = rngs[index]->exponential(types[manufacturer[index]].spec.faultProbability);
+    }
+}
+
+void FleetSoA::updateAll(double hours) {
+    updateRange(0, size(), hours);
+}
+
+void FleetSoA::updateRange(size_t begin, size_t end, double hours, const uint8_t* skip) {
+    if (hours <= 0) {
+        // Zero time updates only run the automatic transitions, not worth batching
+        for (size_t i = begin; i < end; ++i) {
+            if (skip != nullptr && skip[i - begin]) {
+                step.reset(i);
+            } else {
+                updateState(i, hours);
+            }
+        }
+        return;
+    }
+
+    // Same order as the transitions in updateState: Charging -> Ready -> Flying, then
+    // whatever time is left is spent waiting in the Queued or Faulted state. All passes
+    // run over one block before the next, while its columns are in the cache.
+    for (size_t first = begin; first < end; first += FLEET_BLOCK_SIZE) {
+        const size_t last = std::min(end, first + FLEET_BLOCK_SIZE);
+        FleetSpan span{*this, first, last};
+        beginRange(first, last, hours, skip == nullptr ? nullptr : skip + (first - begin));
+        updateCharging(span);
+        startFlights(first, last);
+        sampleFaults(first, last);
+        updateFlying(span);
+        finishRange(first, last);
+    }
+}
+
+void FleetSoA::beginRange(size_t begin, size_t end, double hours, const uint8_t* skip) {
+    step.resetRange(begin, end);
+    if (skip == nullptr) {
+        std::fill(remaining.begin() + begin, remaining.begin() + end, hours);
+        return;
+    }
+    // Without time left the passes leave a Queued or Faulted vehicle as it is
+    for (size_t i = begin; i < end; ++i) {
+        remaining[i] = skip[i - begin] ? 0.0 : hours;
+    }
+}
+
+void FleetSoA::startFlights(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (getState(i) == Vehicle::State::Ready && battery[i] > 0) {
+            startFlight(i);
+        }
+    }
+}
+
+void FleetSoA::sampleFaults(size_t begin, size_t end) {
+    // Decide for each flight whether it faults this step, exactly as fly() does. Faulted
+    // flights are completed here, the rest are left for the updateFlying kernel.
+    for (size_t i = begin; i < end; ++i) {
+        if (getState(i) != Vehicle::State::Flying || !(remaining[i] > 0)) {
+            continue;
+        }
+
+        const VehicleTypeSpec& spec = types[manufacturer[i]].spec;
+        double maxDistance = battery[i] / spec.energyUsePerMile;
+        double actualFlightTime = std::min(remaining[i], maxDistance / spec.cruiseSpeed);
+        if (actualFlightTime <= 0) {
+            continue; // Depleted, the kernel queues it
+        }
+
+        double flightTimeBeforeFault;
+        if (flightTimeToFault[i] >= 0) {
+            if (flightTimeToFault[i] > actualFlightTime + EPSILON) {
+                flightTimeToFault[i] -= actualFlightTime;
+                continue;
+            }
+            flightTimeBeforeFault = std::min(flightTimeToFault[i], actualFlightTime);
+            flightTimeToFault[i] = -1.0;
+        } else if (rngs[i]->bernoulli(std::min(1.0, spec.faultProbability * actualFlightTime))) {
+            flightTimeBeforeFault = actualFlightTime * 0.5;
+        } else {
+            continue;
+        }
+
+        double distanceFlown = spec.cruiseSpeed * flightTimeBeforeFault;
+        setBatteryLevel(i, battery[i] - distanceFlown * spec.energyUsePerMile);
+        step.flightTime[i] += flightTimeBeforeFault;
+        step.distanceTraveled[i] += distanceFlown;
+        step.passengerMiles[i] += distanceFlown * spec.passengerCount;
+        step.faults[i]++;
+        step.flights[i]++;
+        state[i] = static_cast<uint8_t>(Vehicle::State::Faulted);
+
+        step.faultedTime[i] += remaining[i] - flightTimeBeforeFault;
+        remaining[i] = 0.0;
+    }
+}
+
+void FleetSoA::finishRange(size_t begin, size_t end) {
+    // Branch free so the loop vectorizes, adding 0.0 leaves a time unchanged
+    const uint8_t* __restrict states = state.data();
+    double* __restrict left = remaining.data();
+    double* __restrict queued = step.queuedTime.data();
+    double* __restrict faulted = step.faultedTime.data();
+    for (size_t i = begin; i < end; ++i) {
+        queued[i] += states[i] == static_cast<uint8_t>(Vehicle::State::Queued) ? left[i] : 0.0;
+        faulted[i] += states[i] == static_cast<uint8_t>(Vehicle::State::Faulted) ? left[i] : 0.0;
+        left[i] = 0.0;
+    }
+    total.addRange(begin, end, step);
+}
+
+void FleetSoA::updateState(size_t index, double hours) {
+    // See Vehicle::updateState, the transitions here must stay identical
+    bool continueProcessing = true;
+    double remainingTime = hours;
+    step.reset(index);
+
+    while (continueProcessing && remainingTime >= 0) {
+        continueProcessing = false;
+
+        switch (getState(index)) {
+            case Vehicle::State::Ready:
+                if (battery[index] > 0) {
+                    startFlight(index);
+                    continueProcessing = true;
+                }
+                break;
+
+            case Vehicle::State::Flying:
+                if (remainingTime > 0) {
+                    remainingTime -= fly(index, remainingTime);
+
+                    if (getState(index) == Vehicle::State::Queued && remainingTime > 0) {
+                        step.queuedTime[index] += remainingTime;
+                        remainingTime = 0;
+                    } else if (getState(index) == Vehicle::State::Faulted) {
+                        step.faultedTime[index] += remainingTime;
+                        remainingTime = 0;
+                    }
+                }
+                break;
+
+            case Vehicle::State::Charging:
+                if (remainingTime > 0) {
+                    remainingTime -= charge(index, remainingTime);
+                    if (getState(index) == Vehicle::State::Ready) {
+                        continueProcessing = true;
+                    }
+                } else if (battery[index] >= types[manufacturer[index]].spec.batteryCapacity) {
+                    setBatteryLevel(index, types[manufacturer[index]].spec.batteryCapacity);
+                    state[index] = static_cast<uint8_t>(Vehicle::State::Ready);
+                    step.charges[index]++;
+                    continueProcessing = true;
+                }
+                break;
+
+            case Vehicle::State::Queued:
+                if (remainingTime > 0) {
+                    step.queuedTime[index] += remainingTime;
+                    remainingTime = 0;
+                }
+                break;
+
+            case Vehicle::State::Faulted:
+                step.faultedTime[index] += remainingTime;
+                remainingTime = 0;
+                break;
+        }
+    }
+
+    total.add(index, step);
+}
+
+double FleetSoA::fly(size_t index, double hours) {
+    if (hours <= 0) {
+        return 0.0;
+    }
+
+    const VehicleTypeSpec& spec = types[manufacturer[index]].spec;
+
+    double maxDistance = battery[index] / spec.energyUsePerMile;
+    double maxFlightTime = maxDistance / spec.cruiseSpeed;
+    double actualFlightTime = std::min(hours, maxFlightTime);
+
+    if (actualFlightTime <= 0) {
+        setBatteryLevel(index, 0.0);
+        state[index] = static_cast<uint8_t>(Vehicle::State::Queued);
+        step.flights[index]++;
+        return 0.0;
+    }
+
+    bool faultOccurred = false;
+    double flightTimeBeforeFault = actualFlightTime;
+
+    if (flightTimeToFault[index] >= 0) {
+        faultOccurred = (flightTimeToFault[index] <= actualFlightTime + EPSILON);
+        if (faultOccurred) {
+            flightTimeBeforeFault = std::min(flightTimeToFault[index], actualFlightTime);
+            flightTimeToFault[index] = -1.0;
+        } else {
+            flightTimeToFault[index] -= actualFlightTime;
+        }
+    } else if (rngs[index]->bernoulli(std::min(1.0, spec.faultProbability * actualFlightTime))) {
+        faultOccurred = true;
+        flightTimeBeforeFault = actualFlightTime * 0.5;
+    }
+
+    double distanceFlown = spec.cruiseSpeed * flightTimeBeforeFault;
+    double energyConsumed = distanceFlown * spec.energyUsePerMile;
+
+    setBatteryLevel(index, battery[index] - energyConsumed);
+    step.flightTime[index] += flightTimeBeforeFault;
+    step.distanceTraveled[index] += distanceFlown;
+    step.passengerMiles[index] += distanceFlown * spec.passengerCount;
+
+    if (faultOccurred) {
+        step.faults[index]++;
+        step.flights[index]++;
+        state[index] = static_cast<uint8_t>(Vehicle::State::Faulted);
+        return flightTimeBeforeFault;
+    }
+
+    if (battery[index] <= EPSILON) {
+        setBatteryLevel(index, 0.0);
+        state[index] = static_cast<uint8_t>(Vehicle::State::Queued);
+        step.flights[index]++;
+    }
+
+    return actualFlightTime;
+}
+
+void FleetSoA::startCharging(size_t index) {
+    if (getState(index) != Vehicle::State::Queued) {
+        throw std::runtime_error("Vehicle must be Queued to start charging");
+    }
+    state[index] = static_cast<uint8_t>(Vehicle::State::Charging);
+    updateState(index, 0.0); // Check for any follow-up transitions
+}
+
+double FleetSoA::charge(size_t index, double hours) {
+    if (hours <= 0) {
+        return 0.0;
+    }
+
+    const TypeConstants& type = types[manufacturer[index]];
+    double energyNeeded = type.spec.batteryCapacity - battery[index];
+    double actualEnergyToAdd = std::min(energyNeeded, type.chargeRate * hours);
+    double timeActuallyUsed = actualEnergyToAdd / type.chargeRate;
+
+    setBatteryLevel(index, battery[index] + actualEnergyToAdd);
+    step.chargingTime[index] += timeActuallyUsed;
+
+    if (battery[index] >= type.spec.batteryCapacity - EPSILON) {
+        setBatteryLevel(index, type.spec.batteryCapacity);
+        state[index] = static_cast<uint8_t>(Vehicle::State::Ready);
+        step.charges[index]++;
+    }
+
+    return timeActuallyUsed;
+}
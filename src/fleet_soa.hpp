@@ -0,0 +1,181 @@
+/**
+ * @file fleet_soa.hpp
+ * @brief Header file for the FleetSoA class
+ *
+ * FleetSoA stores the mutable state of a whole fleet as a structure of arrays: vehicle
+ * state, battery level and the statistics accumulators each live in their own contiguous
+ * column, and the per-type constants are held once in a small table indexed by
+ * Vehicle::Manufacturer, filled from the VehicleTypeRegistry. Stepping the fleet streams through the columns instead of
+ * following one heap pointer and virtual call per vehicle.
+ *
+ * The state machine mirrors Vehicle::updateState exactly, Vehicle objects can be loaded
+ * into and stored back from the fleet so they remain usable as a view of a vehicle.
+ *
+ * Stepping a range of the fleet runs as a sequence of passes over the columns: the
+ * Charging and Flying updates are branch free kernels (see fleet_kernels.hpp), the fault
+ * sampling and the rare fault transitions run in a separate scalar pass. The passes only
+ * pay off while the columns of the range stay in the cache, so ranges are stepped in
+ * blocks of FLEET_BLOCK_SIZE vehicles.
+ */
+
+#ifndef FLEET_SOA_HPP
+#define FLEET_SOA_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "vehicle.hpp"
+#include "vehicle_registry.hpp"
+
+const size_t FLEET_BLOCK_SIZE = 128; // Vehicles stepped together, the columns of a block stay in the L1 cache
+
+/**
+ * @brief Columns for one set of VehicleStats (step or total) across the fleet.
+ */
+struct FleetStatsColumns {
+    std::vector<double> flightTime;
+    std::vector<double> queuedTime;
+    std::vector<double> distanceTraveled;
+    std::vector<double> chargingTime;
+    std::vector<double> faultedTime;
+    std::vector<int> faults;
+    std::vector<double> passengerMiles;
+    std::vector<int> flights;
+    std::vector<int> charges;
+
+    void resize(size_t size);
+    void reset(size_t index);
+    void add(size_t index, const FleetStatsColumns& other);
+
+    // Column by column over [begin, end), so the loops vectorize
+    void resetRange(size_t begin, size_t end);
+    void addRange(size_t begin, size_t end, const FleetStatsColumns& other);
+    VehicleStats get(size_t index) const;
+    void set(size_t index, const VehicleStats& stats);
+};
+
+class FleetSoA {
+public:
+    static constexpr size_t NUM_TYPES = MAX_VEHICLE_TYPES; // Capacity of the type tables
+
+    /**
+     * @brief Per-manufacturer constants, including derived rates used every step.
+     */
+    struct TypeConstants {
+        VehicleTypeSpec spec;
+        double powerConsumptionRate; // energyUsePerMile * cruiseSpeed [kWh/hour]
+        double chargeRate;           // batteryCapacity / timeToCharge [kWh/hour]
+    };
+
+    /**
+     * @brief The per-manufacturer constants used by the kernels, one array per field so
+     *        they can be gathered by manufacturer index.
+     */
+    struct TypeColumns {
+        double cruiseSpeed[NUM_TYPES];
+        double batteryCapacity[NUM_TYPES];
+        double energyUsePerMile[NUM_TYPES];
+        double passengerCount[NUM_TYPES];
+        double chargeRate[NUM_TYPES];
+    };
+
+    FleetSoA();
+
+    // Also reloads the type tables from the registry
+    void clear();
+    void reserve(size_t size);
+    size_t size() const { return state.size(); }
+
+    /**
+     * @brief Add a new vehicle in the Ready state with a full battery.
+     * @param rng Generator for the vehicle's fault checks, must outlive the fleet entry.
+     * @param model How the vehicle's faults are drawn, see Vehicle::setFaultModel.
+     * @return Index of the vehicle in the fleet.
+     */
+    size_t add(Vehicle::Manufacturer manufacturer,
+               RandomGenerator& rng = Vehicle::defaultRng(),
+               Vehicle::FaultModel model = Vehicle::FaultModel::PerStep);
+
+    /**
+     * @brief Add a vehicle copying its current state, battery, statistics, fault schedule and fault model.
+     *
+     * The fleet entry shares the vehicle's random number generator.
+     * @return Index of the vehicle in the fleet.
+     */
+    size_t load(const Vehicle& vehicle);
+
+    /**
+     * @brief Copy a vehicle's state, battery, statistics, fault schedule and fault model back into a Vehicle.
+     */
+    void store(size_t index, Vehicle& vehicle) const;
+
+    /**
+     * @brief Advance one vehicle, same transitions and statistics as Vehicle::updateState.
+     */
+    void updateState(size_t index, double hours);
+
+    /**
+     * @brief Advance every vehicle, same results as calling updateState in index order.
+     */
+    void updateAll(double hours);
+
+    /**
+     * @brief Advance the vehicles in [begin, end) using the batch kernels.
+     *
+     * Produces the same states and statistics as calling updateState for each index in
+     * order, each vehicle's generator is called in the same order. Disjoint ranges can be
+     * updated concurrently as long as they do not share a generator.
+     *
+     * @param skip Optional flags for [begin, end), only Queued or Faulted vehicles may be
+     *        skipped. A skipped vehicle spends no time, only its step statistics are reset.
+     */
+    void updateRange(size_t begin, size_t end, double hours, const uint8_t* skip = nullptr);
+
+    /**
+     * @brief Same as Vehicle::startCharging, the vehicle must be Queued.
+     */
+    void startCharging(size_t index);
+
+    // Accessors
+    const TypeConstants& typeConstants(Vehicle::Manufacturer manufacturer) const {
+        return types[static_cast<size_t>(manufacturer)];
+    }
+    const TypeColumns& typeColumns() const { return columns; }
+    Vehicle::Manufacturer getManufacturer(size_t index) const { return static_cast<Vehicle::Manufacturer>(manufacturer[index]); }
+    Vehicle::State getState(size_t index) const { return static_cast<Vehicle::State>(state[index]); }
+    double getBatteryLevel(size_t index) const { return battery[index]; }
+    double getMaxFlightTime(size_t index) const { return battery[index] / types[manufacturer[index]].powerConsumptionRate; }
+    VehicleStats getStepStats(size_t index) const { return step.get(index); }
+    VehicleStats getTotalStats(size_t index) const { return total.get(index); }
+
+    // Columns (public so batch kernels can stream through them)
+    std::vector<uint8_t> manufacturer;     // Vehicle::Manufacturer
+    std::vector<uint8_t> state;            // Vehicle::State
+    std::vector<double> battery;           // current battery level [kWh]
+    std::vector<double> flightTimeToFault; // flight hours until scheduled fault (< 0 = per-step check)
+    std::vector<uint8_t> faultModel;       // Vehicle::FaultModel
+    FleetStatsColumns step;                // statistics for the current step
+    FleetStatsColumns total;               // statistics for the total simulation
+    std::vector<double> remaining;         // step time left while updateRange runs [hours]
+    std::vector<RandomGenerator*> rngs;    // generator for each vehicle's fault checks
+
+private:
+    std::array<TypeConstants, NUM_TYPES> types{};
+    TypeColumns columns{};
+
+    void loadTypes();
+
+    // updateRange passes
+    void beginRange(size_t begin, size_t end, double hours, const uint8_t* skip);
+    void startFlights(size_t begin, size_t end);
+    void sampleFaults(size_t begin, size_t end);
+    void finishRange(size_t begin, size_t end);
+
+    void setBatteryLevel(size_t index, double level);
+    void startFlight(size_t index);
+    double fly(size_t index, double hours);
+    double charge(size_t index, double hours);
+};
+
+#endif
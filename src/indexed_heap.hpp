@@ -0,0 +1,156 @@
+/**
+ * @file indexed_heap.hpp
+ * @brief Header file for the IndexedHeap class
+ *
+ * Min-heap of integer handles (e.g. vehicle indices) ordered by a key, stored as an implicit
+ * d-ary tree in one vector. Every heap records the position of its handles in a position
+ * table, so a handle's key can be changed (decrease-key or increase-key) and a handle can be
+ * removed in O(log n) without a search. Several heaps may share one position table as long
+ * as a handle is in at most one of them, e.g. one heap per vertiport over the vehicles of a
+ * fleet.
+ *
+ * A wider node (the default of 4 children) halves the depth of a binary heap, which makes
+ * pushes cheaper and keeps the children of a node in one cache line for the pops.
+ */
+
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+const uint32_t NOT_IN_HEAP = std::numeric_limits<uint32_t>::max(); // Position of a handle in no heap
+
+template <typename Key, size_t Arity = 4>
+class IndexedHeap {
+    static_assert(Arity >= 2, "A heap node needs at least two children");
+
+public:
+    using Handle = size_t;
+
+    struct Entry {
+        Key key;
+        Handle handle;
+    };
+
+    /**
+     * @param positions Position table with one slot per handle, every slot NOT_IN_HEAP at
+     *        first. Must outlive the heap.
+     * @param resource Allocates the entries.
+     */
+    explicit IndexedHeap(std::vector<uint32_t>* positions = nullptr,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : entries(resource), positions(positions) {}
+
+    // A copy would share the position table, heaps are only moved
+    IndexedHeap(const IndexedHeap&) = delete;
+    IndexedHeap& operator=(const IndexedHeap&) = delete;
+    IndexedHeap(IndexedHeap&&) = default;
+    IndexedHeap& operator=(IndexedHeap&&) = default;
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    bool contains(Handle handle) const { return (*positions)[handle] != NOT_IN_HEAP; }
+
+    // Smallest entry, the heap must not be empty
+    const Entry& top() const { return entries.front(); }
+
+    // Entries in heap order (not sorted)
+    const std::pmr::vector<Entry>& getEntries() const { return entries; }
+
+    // The handle must not be in any heap sharing the position table
+    void push(Handle handle, const Key& key) {
+        entries.push_back({key, handle});
+        siftUp(entries.size() - 1);
+    }
+
+    void pop() { erase(entries.front().handle); }
+
+    void erase(Handle handle) {
+        size_t position = (*positions)[handle];
+        (*positions)[handle] = NOT_IN_HEAP;
+        Entry last = std::move(entries.back());
+        entries.pop_back();
+        if (position < entries.size()) {
+            entries[position] = std::move(last);
+            restore(position);
+        }
+    }
+
+    /**
+     * @brief Change the key of a handle in the heap, up or down.
+     */
+    void update(Handle handle, const Key& key) {
+        size_t position = (*positions)[handle];
+        entries[position].key = key;
+        restore(position);
+    }
+
+    void clear() {
+        for (const Entry& entry : entries) {
+            (*positions)[entry.handle] = NOT_IN_HEAP;
+        }
+        entries.clear();
+    }
+
+private:
+    std::pmr::vector<Entry> entries;
+    std::vector<uint32_t>* positions;
+
+    void place(size_t position) { (*positions)[entries[position].handle] = static_cast<uint32_t>(position); }
+
+    void restore(size_t position) {
+        if (position > 0 && entries[position].key < entries[(position - 1) / Arity].key) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+    }
+
+    void siftUp(size_t position) {
+        Entry entry = std::move(entries[position]);
+        while (position > 0) {
+            size_t parent = (position - 1) / Arity;
+            if (!(entry.key < entries[parent].key)) {
+                break;
+            }
+            entries[position] = std::move(entries[parent]);
+            place(position);
+            position = parent;
+        }
+        entries[position] = std::move(entry);
+        place(position);
+    }
+
+    void siftDown(size_t position) {
+        Entry entry = std::move(entries[position]);
+        const size_t count = entries.size();
+        while (true) {
+            size_t first = position * Arity + 1;
+            if (first >= count) {
+                break;
+            }
+            size_t smallest = first;
+            size_t last = first + Arity < count ? first + Arity : count;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (entries[child].key < entries[smallest].key) {
+                    smallest = child;
+                }
+            }
+            if (!(entries[smallest].key < entry.key)) {
+                break;
+            }
+            entries[position] = std::move(entries[smallest]);
+            place(position);
+            position = smallest;
+        }
+        entries[position] = std::move(entry);
+        place(position);
+    }
+};
+
+#endif
@@ -1,11 +1,28 @@
 #ifndef INTERFACE_RNG_HPP
 #define INTERFACE_RNG_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 class RandomGenerator {
 public:
     virtual ~RandomGenerator() = default;
     virtual bool bernoulli(double p) = 0;
     virtual int uniformInt(int min, int max) = 0;
+    virtual double exponential(double rate) = 0; // Returns infinity when rate <= 0
+
+    // Batched draws, same results as calling the single draw count times
+    virtual void fillBernoulli(double p, uint8_t* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = bernoulli(p) ? 1 : 0;
+        }
+    }
+
+    virtual void fillUniformInt(int min, int max, int* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = uniformInt(min, max);
+        }
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,5 +1,5 @@
 /**
- * @file logger.hpp
+ * @file logger.cpp
  * @brief Implementation file for the Logger class
  *
  * See logger.hpp for more information.
@@ -9,9 +9,47 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <cstring>
+#include <algorithm>
 
+/* TimestampCache */
+const char* TimestampCache::now() {
+    return format(std::chrono::system_clock::now());
+}
+
+const char* TimestampCache::format(std::chrono::system_clock::time_point time) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    std::time_t second = static_cast<std::time_t>(ms / 1000);
+    int millis = static_cast<int>(ms % 1000);
+
+    // Only reformat the date and time when the second changes
+    if (second != cachedSecond) {
+        std::tm localTime;
+        localtime_r(&second, &localTime); // Thread-safe, also used by the async writer
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d_%H:%M:%S", &localTime);
+        buffer[19] = '.';
+        cachedSecond = second;
+    }
+
+    buffer[20] = static_cast<char>('0' + millis / 100);
+    buffer[21] = static_cast<char>('0' + (millis / 10) % 10);
+    buffer[22] = static_cast<char>('0' + millis % 10);
+    buffer[23] = '\0';
+    return buffer;
+}
+
+const char* Logger::currentTimestamp() {
+    thread_local TimestampCache cache;
+    return cache.now();
+}
+
+/* Logger */
 Logger::Logger(const std::string& filename, LogMode mode, int verbosity)
-    : currentMode(mode), includeTimestampInFile(true), verbosityLevel(verbosity) {
+    : currentMode(mode), includeTimestampInFile(true), verbosityLevel(verbosity),
+      flushPolicy(FlushPolicy::OnSectionDivider), flushIntervalMs(DEFAULT_FLUSH_INTERVAL_MS),
+      lastFlushTime(std::chrono::steady_clock::now()),
+      asyncEnabled(false), asyncCapacity(DEFAULT_ASYNC_CAPACITY),
+      writerRunning(false), flushesCompleted(0), flushesRequested(0) {
     logFileName = filename;
 
     // Only open file if we need to log to file
@@ -23,22 +61,28 @@ Logger::Logger(const std::string& filename, LogMode mode, int verbosity)
 }
 
 Logger::~Logger() {
-    if (logFile.is_open()) {
-        logFile.close();
-    }
+    closeLogFile();
 }
 
 void Logger::openLogFile() {
     logFile.open(logFileName, std::ios::app);
     if (!logFile.is_open()) {
         std::cerr << "Warning: Could not open log file " << logFileName << std::endl;
+    } else if (asyncEnabled) {
+        startWriter();
     }
 }
 
-void Logger::setLogFile(const std::string& filename) {
+void Logger::closeLogFile() {
+    // Writer owns the file while running, drain it before closing
+    stopWriter();
     if (logFile.is_open()) {
         logFile.close();
     }
+}
+
+void Logger::setLogFile(const std::string& filename) {
+    closeLogFile();
     logFileName = filename;
 
     // Only open file if we need to log to file
@@ -57,14 +101,10 @@ void Logger::setLogMode(LogMode mode) {
 
     // Handle file opening/closing based on mode change
     if (oldMode != currentMode) {
-        if ((oldMode == LogMode::FILE_ONLY || oldMode == LogMode::BOTH) &&
-            currentMode == LogMode::STDOUT_ONLY) {
+        if (writesFile(oldMode) && !writesFile(currentMode)) {
             // We were logging to file, now we're not
-            if (logFile.is_open()) {
-                logFile.close();
-            }
-        } else if (oldMode == LogMode::STDOUT_ONLY &&
-                   (currentMode == LogMode::FILE_ONLY || currentMode == LogMode::BOTH)) {
+            closeLogFile();
+        } else if (!writesFile(oldMode) && writesFile(currentMode)) {
             // We weren't logging to file, now we are
             if (!logFileName.empty()) {
                 openLogFile();
@@ -77,6 +117,10 @@ Logger::LogMode Logger::getLogMode() const {
     return currentMode;
 }
 
+void Logger::setSink(Sink sink) {
+    this->sink = std::move(sink);
+}
+
 void Logger::setIncludeTimestampInFile(bool enable) {
     includeTimestampInFile = enable;
 }
@@ -93,6 +137,184 @@ int Logger::getVerbosityLevel() const {
     return verbosityLevel;
 }
 
+void Logger::setAsync(bool enable, size_t capacity) {
+    if (enable == asyncEnabled && capacity == asyncCapacity) {
+        return;
+    }
+
+    stopWriter();
+    asyncEnabled = enable;
+    asyncCapacity = capacity;
+    if (asyncEnabled && logFile.is_open()) {
+        startWriter();
+    }
+}
+
+bool Logger::getAsync() const {
+    return asyncEnabled;
+}
+
+void Logger::setFlushPolicy(FlushPolicy policy, int intervalMs) {
+    // The interval is published by the policy store, a writer seeing Interval also sees its interval
+    flushIntervalMs.store(intervalMs, std::memory_order_relaxed);
+    flushPolicy.store(policy, std::memory_order_release);
+}
+
+Logger::FlushPolicy Logger::getFlushPolicy() const {
+    return flushPolicy.load(std::memory_order_relaxed);
+}
+
+int Logger::getFlushIntervalMs() const {
+    return flushIntervalMs.load(std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    std::cout.flush();
+    requestFlush(true);
+}
+
+bool Logger::flushIntervalElapsed() const {
+    return std::chrono::steady_clock::now() - lastFlushTime >=
+           std::chrono::milliseconds(flushIntervalMs.load(std::memory_order_relaxed));
+}
+
+void Logger::requestFlush(bool wait) {
+    if (writerRunning.load(std::memory_order_relaxed)) {
+        // Flushes are ordered with messages, so queue a marker for the writer
+        unsigned long sequence = ++flushesRequested;
+        LogRecord* record;
+        while ((record = ringBuffer->beginWrite()) == nullptr) {
+            std::this_thread::yield();
+        }
+        record->flushSequence = sequence;
+        record->length = 0;
+        ringBuffer->endWrite();
+
+        while (wait && flushesCompleted.load(std::memory_order_acquire) < sequence) {
+            std::this_thread::yield();
+        }
+    } else if (logFile.is_open()) {
+        logFile.flush();
+        lastFlushTime = std::chrono::steady_clock::now();
+    }
+}
+
+void Logger::writeToFile(const std::string& message, bool includeTimestamp) {
+    if (writerRunning.load(std::memory_order_relaxed)) {
+        pushRecord(message, includeTimestamp);
+        return;
+    }
+
+    if (includeTimestamp) {
+        logFile << '[' << currentTimestamp() << "] ";
+    }
+    logFile << message;
+
+    if (getFlushPolicy() == FlushPolicy::Interval && flushIntervalElapsed()) {
+        requestFlush(false);
+    }
+}
+
+void Logger::pushRecord(const std::string& message, bool includeTimestamp) {
+    // Split long messages over several records, only the first carries the timestamp
+    auto now = std::chrono::system_clock::now();
+    size_t offset = 0;
+    do {
+        LogRecord* record;
+        while ((record = ringBuffer->beginWrite()) == nullptr) {
+            std::this_thread::yield(); // Full, wait for the writer rather than dropping messages
+        }
+
+        size_t length = std::min(message.size() - offset, RECORD_TEXT_SIZE);
+        record->time = now;
+        record->flushSequence = 0;
+        record->length = static_cast<unsigned int>(length);
+        record->includeTimestamp = includeTimestamp && offset == 0;
+        std::memcpy(record->text, message.data() + offset, length);
+        ringBuffer->endWrite();
+
+        offset += length;
+    } while (offset < message.size());
+}
+
+void Logger::startWriter() {
+    if (writerRunning.load()) {
+        return;
+    }
+    if (!ringBuffer || ringBuffer->capacity() < asyncCapacity) {
+        ringBuffer = std::make_unique<SpscRingBuffer<LogRecord>>(asyncCapacity);
+    }
+    writerRunning.store(true, std::memory_order_release);
+    writerThread = std::thread(&Logger::writerLoop, this);
+}
+
+void Logger::stopWriter() {
+    if (!writerRunning.load()) {
+        return;
+    }
+    writerRunning.store(false, std::memory_order_release);
+    writerThread.join();
+}
+
+void Logger::writerLoop() {
+    std::string block;
+    block.reserve(WRITE_BLOCK_SIZE + RECORD_TEXT_SIZE + 32);
+    auto lastWriterFlush = std::chrono::steady_clock::now();
+    TimestampCache timestamps;
+
+    auto writeBlock = [&]() {
+        if (!block.empty()) {
+            logFile.write(block.data(), static_cast<std::streamsize>(block.size()));
+            block.clear();
+        }
+    };
+
+    while (true) {
+        // Read the stop flag before draining so everything queued before stopWriter() is written
+        bool stopping = !writerRunning.load(std::memory_order_acquire);
+        bool drained = false;
+
+        while (LogRecord* record = ringBuffer->beginRead()) {
+            drained = true;
+            if (record->flushSequence != 0) {
+                writeBlock();
+                logFile.flush();
+                lastWriterFlush = std::chrono::steady_clock::now();
+                flushesCompleted.store(record->flushSequence, std::memory_order_release);
+            } else {
+                if (record->includeTimestamp) {
+                    block += '[';
+                    block.append(timestamps.format(record->time), TimestampCache::LENGTH);
+                    block += "] ";
+                }
+                block.append(record->text, record->length);
+                if (block.size() >= WRITE_BLOCK_SIZE) {
+                    writeBlock();
+                }
+            }
+            ringBuffer->endRead();
+        }
+
+        if (flushPolicy.load(std::memory_order_acquire) == FlushPolicy::Interval &&
+            std::chrono::steady_clock::now() - lastWriterFlush >=
+                std::chrono::milliseconds(flushIntervalMs.load(std::memory_order_relaxed))) {
+            writeBlock();
+            logFile.flush();
+            lastWriterFlush = std::chrono::steady_clock::now();
+        }
+
+        if (stopping) {
+            break;
+        }
+        if (!drained) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    writeBlock();
+    logFile.flush();
+}
+
 std::string Logger::formatFixedWidth(const std::string& text, int width, bool rightAlign) {
     std::ostringstream oss;
     if (rightAlign) {
@@ -104,27 +326,21 @@ std::string Logger::formatFixedWidth(const std::string& text, int width, bool ri
 }
 
 void Logger::log(const std::string& message, bool includeTimestamp) {
-    // Prepare console output
-    std::string consoleOutput = message;
-    if (includeTimestamp) {
-        consoleOutput = "[" + getCurrentTimestamp() + "] " + message;
-    }
-
-    // Prepare file output (may differ from console output)
-    std::string fileOutput = message;
-    if (includeTimestamp && includeTimestampInFile) {
-        fileOutput = "[" + getCurrentTimestamp() + "] " + message;
-    }
-
     // Output to stdout if mode allows it
     if (currentMode == LogMode::STDOUT_ONLY || currentMode == LogMode::BOTH) {
-        std::cout << consoleOutput;
+        if (includeTimestamp) {
+            std::cout << '[' << currentTimestamp() << "] ";
+        }
+        std::cout << message;
     }
 
-    // Output to file if mode allows it and file is open
+    // Output to file if mode allows it and file is open (file timestamp may differ from console)
     if ((currentMode == LogMode::FILE_ONLY || currentMode == LogMode::BOTH) && logFile.is_open()) {
-        logFile << fileOutput;
-        logFile.flush();
+        writeToFile(message, includeTimestamp && includeTimestampInFile);
+    }
+
+    if (currentMode == LogMode::SINK && sink) {
+        sink(message);
     }
 }
 
@@ -133,25 +349,25 @@ void Logger::logLine(const std::string& message, bool includeTimestamp) {
 }
 
 void Logger::log(int verbosity, const std::string& message, bool includeTimestamp) {
-    if (verbosity <= verbosityLevel) {
+    if (isEnabled(verbosity)) {
         log(message, includeTimestamp);
     }
 }
 
 void Logger::logLine(int verbosity, const std::string& message, bool includeTimestamp) {
-    if (verbosity <= verbosityLevel) {
+    if (isEnabled(verbosity)) {
         logLine(message, includeTimestamp);
     }
 }
 
 void Logger::logSectionDivider(int verbosity, const std::string& message, bool includeTimestamp) {
-    if (verbosity <= verbosityLevel) {
+    if (isEnabled(verbosity)) {
         logSectionDivider(message, includeTimestamp);
     }
 }
 
 void Logger::logSubSectionDivider(int verbosity, const std::string& message, bool includeTimestamp) {
-    if (verbosity <= verbosityLevel) {
+    if (isEnabled(verbosity)) {
         logSubSectionDivider(message, includeTimestamp);
     }
 }
@@ -163,6 +379,10 @@ void Logger::logSectionDivider(const std::string& message, bool includeTimestamp
         logLine(message, includeTimestamp);
     }
     logLine(divider, includeTimestamp);
+
+    if (getFlushPolicy() == FlushPolicy::OnSectionDivider) {
+        requestFlush(false);
+    }
 }
 
 void Logger::logSubSectionDivider(const std::string& message, bool includeTimestamp) {
@@ -11,6 +11,44 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <ctime>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "ring_buffer.hpp"
+
+/**
+ * @brief Coarse clock that formats "YYYY-MM-DD_HH:MM:SS.mmm" timestamps into a fixed buffer.
+ *
+ * The date/time prefix is only reformatted (localtime + strftime) when the second changes,
+ * otherwise only the millisecond digits are patched in place. Not thread-safe, use one
+ * cache per thread.
+ */
+class TimestampCache {
+public:
+    static constexpr size_t LENGTH = 23;    // Characters in a timestamp
+    static constexpr size_t SIZE = LENGTH + 1; // Buffer size including terminator
+
+    /**
+     * @brief Format the current time.
+     * @return Pointer to the internal buffer, valid until the next call.
+     */
+    const char* now();
+
+    /**
+     * @brief Format the given time.
+     * @return Pointer to the internal buffer, valid until the next call.
+     */
+    const char* format(std::chrono::system_clock::time_point time);
+
+private:
+    std::time_t cachedSecond = -1;
+    char buffer[SIZE] = {};
+};
 
 class Logger {
 public:
@@ -20,17 +58,69 @@ public:
     enum class LogMode {
         STDOUT_ONLY,  // Log to std::cout only
         FILE_ONLY,    // Log to file only
-        BOTH          // Log to both std::cout and file (default)
+        BOTH,         // Log to both std::cout and file (default)
+        NONE,         // Discard all output
+        SINK          // Pass every message to the sink set with setSink()
+    };
+
+    // Receives each message as logged, without timestamp (lines end in '\n')
+    using Sink = std::function<void(const std::string& message)>;
+
+    /**
+     * @brief Enumeration for when buffered file output is flushed to disk
+     */
+    enum class FlushPolicy {
+        OnExit,           // Flush only when the log file is closed
+        OnSectionDivider, // Flush after each section divider (default)
+        Interval          // Flush at most every flush interval milliseconds
     };
 
+    static constexpr size_t DEFAULT_ASYNC_CAPACITY = 8192;  // Records in the async ring buffer
+    static constexpr int DEFAULT_FLUSH_INTERVAL_MS = 1000;  // Default interval for FlushPolicy::Interval
+
 private:
+    static constexpr size_t RECORD_TEXT_SIZE = 232;      // Message bytes per async record (longer messages span records)
+    static constexpr size_t WRITE_BLOCK_SIZE = 64 * 1024; // Async writer output block size
+
+    // Preallocated record passed from the logging thread to the writer thread
+    struct LogRecord {
+        std::chrono::system_clock::time_point time;
+        unsigned long flushSequence; // Non-zero for flush requests (no text)
+        unsigned int length;
+        bool includeTimestamp;
+        char text[RECORD_TEXT_SIZE];
+    };
+
     std::ofstream logFile;
     std::string logFileName;
+    Sink sink;
     LogMode currentMode;
     bool includeTimestampInFile;
     int verbosityLevel;
 
+    std::atomic<FlushPolicy> flushPolicy; // Also read by the writer thread
+    std::atomic<int> flushIntervalMs;
+    std::chrono::steady_clock::time_point lastFlushTime;
+
+    // Asynchronous file output
+    bool asyncEnabled;
+    size_t asyncCapacity;
+    std::unique_ptr<SpscRingBuffer<LogRecord>> ringBuffer;
+    std::thread writerThread;
+    std::atomic<bool> writerRunning;
+    std::atomic<unsigned long> flushesCompleted;
+    unsigned long flushesRequested;
+
+    static bool writesFile(LogMode mode) { return mode == LogMode::FILE_ONLY || mode == LogMode::BOTH; }
     void openLogFile();
+    void closeLogFile();
+    void writeToFile(const std::string& message, bool includeTimestamp);
+    void pushRecord(const std::string& message, bool includeTimestamp);
+    void requestFlush(bool wait);
+    bool flushIntervalElapsed() const;
+    void startWriter();
+    void stopWriter();
+    void writerLoop();
 
 public:
     Logger(const std::string& filename = "", LogMode mode = LogMode::BOTH, int verbosity = 1);
@@ -49,6 +139,38 @@ public:
     void logSectionDivider(int verbosity, const std::string& message = "", bool includeTimestamp = true);
     void logSubSectionDivider(int verbosity, const std::string& message = "", bool includeTimestamp = true);
 
+    /**
+     * @brief Check if messages at the given verbosity level would be logged.
+     *
+     * Use this as a cheap guard around blocks of logging so messages are not built
+     * (and nothing is allocated) when they would be filtered out anyway.
+     */
+    bool isEnabled(int verbosity) const { return currentMode != LogMode::NONE && verbosity <= verbosityLevel; }
+
+    /**
+     * @brief Log a message that is only formatted if the verbosity level is enabled.
+     *
+     * @param formatter Callable returning the message (std::string), only invoked if enabled.
+     */
+    template <typename Formatter>
+    void logLazy(int verbosity, Formatter&& formatter, bool includeTimestamp = true) {
+        if (isEnabled(verbosity)) {
+            log(formatter(), includeTimestamp);
+        }
+    }
+
+    /**
+     * @brief Log a line that is only formatted if the verbosity level is enabled.
+     *
+     * @param formatter Callable returning the message (std::string), only invoked if enabled.
+     */
+    template <typename Formatter>
+    void logLineLazy(int verbosity, Formatter&& formatter, bool includeTimestamp = true) {
+        if (isEnabled(verbosity)) {
+            logLine(formatter(), includeTimestamp);
+        }
+    }
+
     std::string formatFixedWidth(const std::string& text, int width, bool rightAlign = true);
 
     void setLogFile(const std::string& filename);
@@ -57,22 +179,56 @@ public:
     void setLogMode(LogMode mode);
     LogMode getLogMode() const;
 
+    /**
+     * @brief Embedders' destination for LogMode::SINK, called on the logging thread.
+     */
+    void setSink(Sink sink);
+
     void setIncludeTimestampInFile(bool enable);
     bool getIncludeTimestampInFile() const;
 
     void setVerbosityLevel(int level);
     int getVerbosityLevel() const;
 
+    /**
+     * @brief Enable or disable asynchronous file output.
+     *
+     * In async mode file messages are copied into a lock-free ring buffer of preallocated
+     * records and a background thread formats timestamps and writes them in large blocks.
+     * Console output is always written synchronously.
+     *
+     * @param enable True to write the log file from a background thread.
+     * @param capacity Number of records in the ring buffer.
+     */
+    void setAsync(bool enable, size_t capacity = DEFAULT_ASYNC_CAPACITY);
+    bool getAsync() const;
+
+    /**
+     * @brief Set when buffered file output is flushed to disk.
+     *
+     * Safe to call while the async writer runs, it uses the new policy from its next pass
+     * over the ring buffer.
+     *
+     * @param policy When to flush, see FlushPolicy.
+     * @param intervalMs Minimum time between flushes for FlushPolicy::Interval.
+     */
+    void setFlushPolicy(FlushPolicy policy, int intervalMs = DEFAULT_FLUSH_INTERVAL_MS);
+    FlushPolicy getFlushPolicy() const;
+    int getFlushIntervalMs() const;
+
+    /**
+     * @brief Write all pending file output to disk, blocking until done.
+     */
+    void flush();
+
+    /**
+     * @brief Current timestamp from a per-thread TimestampCache.
+     * @return Pointer to a TimestampCache::SIZE buffer, valid until the next call on this thread.
+     */
+    static const char* currentTimestamp();
+
     static std::string getCurrentTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
-
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d_%H:%M:%S");
-        ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-        return ss.str();
+        return std::string(currentTimestamp(), TimestampCache::LENGTH);
     }
 };
 
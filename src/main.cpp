@@ -1,7 +1,19 @@
 #include "simulation.hpp"
+#include "checkpoint.hpp"
+#include "replication.hpp"
+#include "scenario.hpp"
+#include "sweep.hpp"
+#include "work_queue.hpp"
 #include <iostream>
 #include <string>
+#include <vector>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
 
 void printUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [options]\n";
@@ -9,18 +21,100 @@ void printUsage(const char* programName) {
     std::cout << "  -v, --vehicles <num>     Number of vehicles (default: " << DEFAULT_NUM_VEHICLES << ")\n";
     std::cout << "  -h, --hours <hours>      Simulation duration in hours, decimal values supported (default: " << DEFAULT_HRS_SIM << ")\n";
     std::cout << "  -c, --chargers <num>     Number of charging stations (default: " << DEFAULT_CHARGERS << ")\n";
+    std::cout << "  --vertiports <num>       Spread the chargers over a number of vertiports (default: " << DEFAULT_VERTIPORTS << ")\n";
+    std::cout << "                           Vehicles fly between the sites and only charge at the site they\n";
+    std::cout << "                           land at, each site has its own queue. Needs at least one charger\n";
+    std::cout << "                           per vertiport.\n";
+    std::cout << "  --dispatch <policy>      Order in which waiting vehicles get a charger [fifo, sjf, passengers, fair]\n";
+    std::cout << "                           (default: " << dispatchPolicyToString(DEFAULT_DISPATCH_POLICY) << ")\n";
+    std::cout << "                           sjf serves the shortest remaining charge first, passengers the\n";
+    std::cout << "                           largest aircraft, fair gives every manufacturer the same charger time.\n";
     std::cout << "  -t, --timestep <sec>     Time step in seconds (default: " << DEFAULT_TIME_STEP_SECONDS << ")\n";
     std::cout << "  -l, --logVerbosity <num> Log verbosity level [1, 2] (default: " << DEFAULT_VERBOSITY << ")\n";
     std::cout << "                           This controls verbosity in log output file (not to console).\n";
     std::cout << "                           Recommend to use > 1 only for short/smaller simulations and\n";
     std::cout << "                           debugging. \n";
     std::cout << "  -e, --equal              Use equal distribution instead of random (default: random)\n";
+    std::cout << "  --log-async              Write the log file from a background thread\n";
+    std::cout << "  --log-flush <policy>     When the log file is flushed [exit, divider, <ms>] (default: divider)\n";
+    std::cout << "                           <ms> flushes at most every given number of milliseconds.\n";
+    std::cout << "  --engine <type>          Simulation engine [fixed, event, soa, adaptive] (default: " << engineToString(DEFAULT_ENGINE) << ")\n";
+    std::cout << "                           'event' jumps between vehicle transitions instead of stepping\n";
+    std::cout << "                           every vehicle each time step; faults use sampled fault times.\n";
+    std::cout << "                           'adaptive' steps the whole fleet to the next vehicle transition.\n";
+    std::cout << "  --threads <num>          Threads used to update vehicles (default: " << DEFAULT_THREADS << ")\n";
+    std::cout << "                           Results for a given seed do not depend on the thread count.\n";
+    std::cout << "                           The event engine always runs on one thread.\n";
+    std::cout << "  --fault-model <model>    How faults are drawn [step, exponential] (default: " << faultModelToString(DEFAULT_FAULT_MODEL) << ")\n";
+    std::cout << "                           'step' draws once per flying step, 'exponential' samples a fault\n";
+    std::cout << "                           time once per flight and does not depend on the time step.\n";
+    std::cout << "                           The event and adaptive engines always use 'exponential'.\n";
+    std::cout << "  --vehicle-types <file>   Register the vehicle types of a file in addition to the built-in\n";
+    std::cout << "                           Alpha to Echo, one '<name> <mph> <kWh> <charge hours> <kWh/mile>\n";
+    std::cout << "                           <passengers> <faults/hour>' line per type. Vehicles are drawn\n";
+    std::cout << "                           from all types; pass the same file on --resume.\n";
+    std::cout << "  --scenario <file>        Read the settings of a run from a file instead of options, one\n";
+    std::cout << "                           '<option> <value>' line each (e.g. 'chargers 8'), and a fleet:\n";
+    std::cout << "                           'fleet random', 'fleet equal' or '<type> <count>' pairs, e.g.\n";
+    std::cout << "                           'fleet Alpha 40 Bravo 60'. Options after it override the file;\n";
+    std::cout << "                           pass --vehicle-types before it.\n";
+    std::cout << "  --seed <num>             Seed for all random draws, runs with the same seed and options\n";
+    std::cout << "                           are reproducible (default: random, printed in the report)\n";
+    std::cout << "  --replications <num>     Run independently seeded replications and report the mean, standard\n";
+    std::cout << "                           deviation and 95% confidence interval of every result column\n";
+    std::cout << "                           (default: " << DEFAULT_REPLICATIONS << "). Replications run on --threads threads\n";
+    std::cout << "                           without per-step logging, their seeds are derived from --seed.\n";
+    std::cout << "  --sweep-vehicles <range> Sweep the number of vehicles, <range> is start:end:step or a value\n";
+    std::cout << "  --sweep-chargers <range> Sweep the number of chargers\n";
+    std::cout << "  --sweep-hours <range>    Sweep the simulation hours\n";
+    std::cout << "                           Any sweep option runs the whole grid on --threads threads and\n";
+    std::cout << "                           writes one CSV row per configuration instead of a report.\n";
+    std::cout << "                           Dimensions that are not swept use -v, -c and -h.\n";
+    std::cout << "  --sweep-output <file>    CSV file for the sweep (default: output/eVTOL_sweep_<time>.csv)\n";
+    std::cout << "  --sweep-cache <file>     Cache of computed cells, 'none' disables it (default: " << DEFAULT_SWEEP_CACHE << ")\n";
+    std::cout << "  --coordinator <port>     Run the replications or sweep cells on workers that connect to this\n";
+    std::cout << "                           port, 0 picks a free port (default port: " << DEFAULT_WORK_PORT << ")\n";
+    std::cout << "  --worker <host:port>     Run work items of a coordinator on --threads connections until it\n";
+    std::cout << "                           is done. Pass the coordinator's --vehicle-types file.\n";
+    std::cout << "  --work-timeout <sec>     Also hand items running longer to idle workers, the first result\n";
+    std::cout << "                           counts (default: never)\n";
+    std::cout << "  --trace-format <format>  Per-vehicle step output [text, binary] (default: text)\n";
+    std::cout << "                           'binary' writes fixed-width records for every step to a trace\n";
+    std::cout << "                           file at any -l level instead of text lines in the report.\n";
+    std::cout << "                           Render it as text with eVTOL_trace <file>.\n";
+    std::cout << "  --trace-file <file>      Binary trace file (default: output/eVTOL_sim_trace_<time>.evtrace)\n";
+    std::cout << "  --checkpoint-every <hrs> Write a checkpoint of the whole simulation state every given\n";
+    std::cout << "                           number of simulation hours, replacing the previous one.\n";
+    std::cout << "  --checkpoint-file <file> Checkpoint file (default: " << DEFAULT_CHECKPOINT_FILE << ")\n";
+    std::cout << "  --resume <file>          Continue a run from a checkpoint. The fleet, chargers, time step\n";
+    std::cout << "                           and engine come from the checkpoint; -h and --seed may change\n";
+    std::cout << "                           the end time and the random draws from the checkpoint on.\n";
+    std::cout << "  --profile-json <file>    Also write the time per step phase and the hot-path counters as\n";
+    std::cout << "                           JSON. Needs a build with -DEVTOL_PROFILING=ON, which prints the\n";
+    std::cout << "                           profile after the results table.\n";
+    std::cout << "  --metrics-file <file>    Publish live metrics (sim time, steps/s, queue length, charger\n";
+    std::cout << "                           occupancy, running totals) to a file in the Prometheus text format\n";
+    std::cout << "  --metrics-interval <ms>  Time between metrics file updates (default: " << DEFAULT_METRICS_INTERVAL_MS << ")\n";
+    std::cout << "  --timeseries <file>      Also write the charger utilization of every minute as CSV\n";
+    std::cout << "  --no-progress            Do not draw the console progress bar (e.g. for batch jobs)\n";
     std::cout << "  --help                   Show this help message\n";
+    std::cout << "\nLong options also accept the form --option=value.\n";
     std::cout << "\nExamples:\n";
     std::cout << "  " << programName << "                              # Use all defaults\n";
     std::cout << "  " << programName << " -v 50 -h 6                   # 50 vehicles, 6 hours simulation\n";
     std::cout << "  " << programName << " --vehicles 30 --chargers 5   # 30 vehicles, 5 chargers\n";
     std::cout << "  " << programName << " -v 10 -h 4.5 -c 8 -t 0.5     # 10 vehicles, 4.5 hours, 8 chargers, 0.5s timestep\n";
+    std::cout << "  " << programName << " -v 100000 -h 24 --engine=event # Large fleet using the event-driven engine\n";
+    std::cout << "  " << programName << " -v 50000 -c 1500 --vertiports=500 # 500 sites with 3 chargers each\n";
+    std::cout << "  " << programName << " --scenario=peak.txt --seed=7      # Settings and fleet from a scenario file\n";
+    std::cout << "  " << programName << " -v 50 -c 3 --dispatch=sjf       # Shortest charge first\n";
+    std::cout << "  " << programName << " -v 100000 -h 1 --threads=8 # Large fleet stepped on 8 threads\n";
+    std::cout << "  " << programName << " -v 50 -h 3 --replications=200 --threads=8 # Confidence intervals from 200 runs\n";
+    std::cout << "  " << programName << " -v 1000 -h 1 --trace-format=binary # Per-vehicle trace of every step\n";
+    std::cout << "  " << programName << " -v 500 -h 24 --checkpoint-every=1 # Resume with --resume=" << DEFAULT_CHECKPOINT_FILE << "\n";
+    std::cout << "  " << programName << " --sweep-vehicles=20:400:20 --sweep-chargers=1:20 --threads=8 # 20x20 grid\n";
+    std::cout << "  " << programName << " --sweep-vehicles=20:400:20 --coordinator=" << DEFAULT_WORK_PORT << " # Grid on workers started with\n";
+    std::cout << "  " << programName << " --worker=<coordinator host>:" << DEFAULT_WORK_PORT << " --threads=8 # on every node\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -28,9 +122,62 @@ int main(int argc, char* argv[]) {
     int numVehicles = DEFAULT_NUM_VEHICLES;
     double simHours = DEFAULT_HRS_SIM;
     int numChargers = DEFAULT_CHARGERS;
+    int numVertiports = DEFAULT_VERTIPORTS;
+    DispatchPolicy dispatchPolicy = DEFAULT_DISPATCH_POLICY;
     double simTimeStepSeconds = DEFAULT_TIME_STEP_SECONDS;
     int simLogVerbosity = DEFAULT_VERBOSITY;
     bool randomizeVehicles = true;
+    std::vector<int> fleetComposition;
+    SimulationEngine engine = DEFAULT_ENGINE;
+    int numThreads = DEFAULT_THREADS;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+    int numReplications = DEFAULT_REPLICATIONS;
+    bool sweep = false;
+    SweepSettings sweepSettings;
+    bool sweepVehicles = false;
+    bool sweepChargers = false;
+    bool sweepHours = false;
+    std::string sweepOutput;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    TraceFormat traceFormat = TraceFormat::Text;
+    std::string traceFile;
+    double checkpointInterval = 0.0;
+    std::string checkpointFile = DEFAULT_CHECKPOINT_FILE;
+    std::string resumeFile;
+    std::string profileFile;
+    std::string metricsFile;
+    std::string timeSeriesFile;
+    int metricsIntervalMs = DEFAULT_METRICS_INTERVAL_MS;
+    bool showProgress = true;
+    bool hasHours = false;
+    bool hasFleetOptions = false; // Options replaced by the checkpoint on --resume
+    bool asyncLog = false;
+    Logger::FlushPolicy flushPolicy = Logger::FlushPolicy::OnSectionDivider;
+    int flushIntervalMs = Logger::DEFAULT_FLUSH_INTERVAL_MS;
+    bool coordinate = false;
+    WorkCoordinatorSettings workSettings;
+    std::string workerHost;
+    uint16_t workerPort = 0;
+
+    // Split "--option=value" into separate arguments so both forms are parsed the same way
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        if (arg.rfind("--", 0) == 0 && equals != std::string::npos) {
+            args.push_back(arg.substr(0, equals));
+            args.push_back(arg.substr(equals + 1));
+        } else {
+            args.push_back(arg);
+        }
+    }
+    std::vector<char*> argPointers = {argv[0]};
+    for (auto& arg : args) {
+        argPointers.push_back(&arg[0]);
+    }
+    argc = static_cast<int>(argPointers.size());
+    argv = argPointers.data();
 
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -41,42 +188,245 @@ int main(int argc, char* argv[]) {
             return 0;
         }
         else if ((arg == "-v" || arg == "--vehicles") && i + 1 < argc) {
-            numVehicles = std::atoi(argv[++i]);
-            if (numVehicles <= 0) {
+            if (!parseInt(argv[++i], numVehicles) || numVehicles <= 0) {
                 std::cerr << "Error: Number of vehicles must be positive\n";
                 return 1;
             }
+            hasFleetOptions = true;
         }
         else if ((arg == "-h" || arg == "--hours") && i + 1 < argc) {
-            simHours = std::atof(argv[++i]);
-            if (simHours <= 0) {
+            if (!parseDouble(argv[++i], simHours) || simHours <= 0) {
                 std::cerr << "Error: Simulation hours must be positive\n";
                 return 1;
             }
+            hasHours = true;
         }
         else if ((arg == "-c" || arg == "--chargers") && i + 1 < argc) {
-            numChargers = std::atoi(argv[++i]);
-            if (numChargers <= 0) {
+            if (!parseInt(argv[++i], numChargers) || numChargers <= 0) {
                 std::cerr << "Error: Number of chargers must be positive\n";
                 return 1;
             }
+            hasFleetOptions = true;
+        }
+        else if (arg == "--vertiports" && i + 1 < argc) {
+            if (!parseInt(argv[++i], numVertiports) || numVertiports <= 0) {
+                std::cerr << "Error: Number of vertiports must be positive\n";
+                return 1;
+            }
+            hasFleetOptions = true;
+        }
+        else if (arg == "--dispatch" && i + 1 < argc) {
+            if (!dispatchPolicyFromString(argv[++i], dispatchPolicy)) {
+                std::cerr << "Error: Dispatch policy must be one of [fifo, sjf, passengers, fair]\n";
+                return 1;
+            }
+            hasFleetOptions = true;
         }
         else if ((arg == "-t" || arg == "--timestep") && i + 1 < argc) {
-            simTimeStepSeconds = std::atof(argv[++i]);
-            if (simTimeStepSeconds <= 0) {
+            if (!parseDouble(argv[++i], simTimeStepSeconds) || simTimeStepSeconds <= 0) {
                 std::cerr << "Error: Time step must be positive\n";
                 return 1;
             }
+            hasFleetOptions = true;
         }
         else if ((arg == "-l" || arg == "--logVerbosity") && i + 1 < argc) {
-            simLogVerbosity = std::atoi(argv[++i]);
-            if (simLogVerbosity <= 0) {
-                std::cerr << "Error: Time step must be positive\n";
+            if (!parseInt(argv[++i], simLogVerbosity) || simLogVerbosity <= 0) {
+                std::cerr << "Error: Log verbosity must be positive\n";
                 return 1;
             }
         }
         else if (arg == "-e" || arg == "--equal") {
             randomizeVehicles = false;
+            hasFleetOptions = true;
+        }
+        else if (arg == "--log-async") {
+            asyncLog = true;
+        }
+        else if (arg == "--log-flush" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "exit") {
+                flushPolicy = Logger::FlushPolicy::OnExit;
+            } else if (policy == "divider") {
+                flushPolicy = Logger::FlushPolicy::OnSectionDivider;
+            } else {
+                flushPolicy = Logger::FlushPolicy::Interval;
+                if (!parseInt(policy, flushIntervalMs) || flushIntervalMs <= 0) {
+                    std::cerr << "Error: Log flush policy must be exit, divider or a positive number of milliseconds\n";
+                    return 1;
+                }
+            }
+        }
+        else if (arg == "--engine" && i + 1 < argc) {
+            if (!engineFromString(argv[++i], engine)) {
+                std::cerr << "Error: Engine must be one of [fixed, event, soa, adaptive]\n";
+                return 1;
+            }
+            hasFleetOptions = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            if (!parseInt(argv[++i], numThreads) || numThreads <= 0) {
+                std::cerr << "Error: Number of threads must be positive\n";
+                return 1;
+            }
+        }
+        else if (arg == "--fault-model" && i + 1 < argc) {
+            if (!faultModelFromString(argv[++i], faultModel)) {
+                std::cerr << "Error: Fault model must be one of [step, exponential]\n";
+                return 1;
+            }
+            hasFleetOptions = true;
+        }
+        else if (arg == "--replications" && i + 1 < argc) {
+            if (!parseInt(argv[++i], numReplications) || numReplications <= 0) {
+                std::cerr << "Error: Number of replications must be positive\n";
+                return 1;
+            }
+        }
+        else if ((arg == "--sweep-vehicles" || arg == "--sweep-chargers" || arg == "--sweep-hours") && i + 1 < argc) {
+            SweepRange range;
+            if (!SweepRange::parse(argv[++i], range) || range.start <= 0) {
+                std::cerr << "Error: Sweep ranges must be start:end:step with positive values\n";
+                return 1;
+            }
+            if (arg == "--sweep-vehicles") {
+                sweepSettings.vehicles = range;
+                sweepVehicles = true;
+            } else if (arg == "--sweep-chargers") {
+                sweepSettings.chargers = range;
+                sweepChargers = true;
+            } else {
+                sweepSettings.hours = range;
+                sweepHours = true;
+            }
+            sweep = true;
+        }
+        else if (arg == "--sweep-output" && i + 1 < argc) {
+            sweepOutput = argv[++i];
+        }
+        else if (arg == "--sweep-cache" && i + 1 < argc) {
+            std::string cache = argv[++i];
+            sweepSettings.cacheFile = (cache == "none") ? "" : cache;
+        }
+        else if (arg == "--coordinator" && i + 1 < argc) {
+            const char* value = argv[++i];
+            char* end = nullptr;
+            unsigned long port = std::strtoul(value, &end, 10);
+            if (*value == '\0' || *value == '-' || *end != '\0' || port > 65535) {
+                std::cerr << "Error: Coordinator port must be between 0 and 65535\n";
+                return 1;
+            }
+            workSettings.port = static_cast<uint16_t>(port);
+            coordinate = true;
+        }
+        else if (arg == "--worker" && i + 1 < argc) {
+            std::string address = argv[++i];
+            size_t colon = address.rfind(':');
+            char* end = nullptr;
+            unsigned long port = colon == std::string::npos ? 0 : std::strtoul(address.c_str() + colon + 1, &end, 10);
+            if (colon == std::string::npos || colon == 0 || address[colon + 1] == '\0' || *end != '\0' ||
+                port == 0 || port > 65535) {
+                std::cerr << "Error: Worker address must be <host>:<port>\n";
+                return 1;
+            }
+            workerHost = address.substr(0, colon);
+            workerPort = static_cast<uint16_t>(port);
+        }
+        else if (arg == "--work-timeout" && i + 1 < argc) {
+            if (!parseDouble(argv[++i], workSettings.itemTimeoutSeconds) || workSettings.itemTimeoutSeconds <= 0) {
+                std::cerr << "Error: Work timeout must be a positive number of seconds\n";
+                return 1;
+            }
+        }
+        else if (arg == "--trace-format" && i + 1 < argc) {
+            if (!traceFormatFromString(argv[++i], traceFormat)) {
+                std::cerr << "Error: Trace format must be one of [text, binary]\n";
+                return 1;
+            }
+        }
+        else if (arg == "--trace-file" && i + 1 < argc) {
+            traceFile = argv[++i];
+        }
+        else if (arg == "--checkpoint-every" && i + 1 < argc) {
+            if (!parseDouble(argv[++i], checkpointInterval) || checkpointInterval <= 0) {
+                std::cerr << "Error: Checkpoint interval must be positive\n";
+                return 1;
+            }
+        }
+        else if (arg == "--checkpoint-file" && i + 1 < argc) {
+            checkpointFile = argv[++i];
+        }
+        else if (arg == "--metrics-file" && i + 1 < argc) {
+            metricsFile = argv[++i];
+        }
+        else if (arg == "--metrics-interval" && i + 1 < argc) {
+            if (!parseInt(argv[++i], metricsIntervalMs) || metricsIntervalMs <= 0) {
+                std::cerr << "Error: Metrics interval must be a positive number of milliseconds\n";
+                return 1;
+            }
+        }
+        else if (arg == "--timeseries" && i + 1 < argc) {
+            timeSeriesFile = argv[++i];
+        }
+        else if (arg == "--no-progress") {
+            showProgress = false;
+        }
+        else if (arg == "--profile-json" && i + 1 < argc) {
+            profileFile = argv[++i];
+            if (!Profiler::ENABLED) {
+                std::cerr << "Warning: Built without EVTOL_PROFILING, no profile is written\n";
+            }
+        }
+        else if (arg == "--vehicle-types" && i + 1 < argc) {
+            try {
+                VehicleTypeRegistry::instance().loadFile(argv[++i]);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "Error: " << error.what() << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--scenario" && i + 1 < argc) {
+            Scenario scenario;
+            try {
+                scenario = Scenario::loadFile(argv[++i]);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "Error: " << error.what() << "\n";
+                return 1;
+            }
+            // Settings of the file, options after it override them
+            numVehicles = scenario.numVehicles.value_or(numVehicles);
+            numChargers = scenario.numChargers.value_or(numChargers);
+            numVertiports = scenario.vertiports.value_or(numVertiports);
+            dispatchPolicy = scenario.dispatchPolicy.value_or(dispatchPolicy);
+            simTimeStepSeconds = scenario.simTimeStepSeconds.value_or(simTimeStepSeconds);
+            engine = scenario.engine.value_or(engine);
+            faultModel = scenario.faultModel.value_or(faultModel);
+            randomizeVehicles = scenario.randomizeVehicles.value_or(randomizeVehicles);
+            numThreads = scenario.threads.value_or(numThreads);
+            numReplications = scenario.replications.value_or(numReplications);
+            if (!scenario.fleetComposition.empty()) {
+                fleetComposition = scenario.fleetComposition;
+            }
+            if (scenario.simHours) {
+                simHours = *scenario.simHours;
+                hasHours = true;
+            }
+            if (scenario.seed) {
+                seed = *scenario.seed;
+                hasSeed = true;
+            }
+            hasFleetOptions = hasFleetOptions || scenario.numVehicles || scenario.numChargers || scenario.vertiports ||
+                              scenario.dispatchPolicy || scenario.simTimeStepSeconds || scenario.engine ||
+                              scenario.faultModel || scenario.randomizeVehicles;
+        }
+        else if (arg == "--resume" && i + 1 < argc) {
+            resumeFile = argv[++i];
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            if (!parseUint64(argv[++i], seed)) {
+                std::cerr << "Error: Seed must be a non-negative integer\n";
+                return 1;
+            }
+            hasSeed = true;
         }
         else {
             std::cerr << "Error: Unknown argument '" << arg << "'\n";
@@ -85,8 +435,222 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // A worker only runs what its coordinator hands out, one connection per thread
+    if (!workerHost.empty()) {
+        std::vector<int> completed(numThreads, 0);
+        std::vector<std::string> errors(numThreads);
+        std::vector<std::thread> connections;
+        for (int i = 0; i < numThreads; ++i) {
+            connections.emplace_back([&, i] {
+                try {
+                    completed[i] = WorkWorker(workerHost, workerPort).run();
+                } catch (const std::runtime_error& error) {
+                    errors[i] = error.what();
+                }
+            });
+        }
+        int total = 0;
+        for (int i = 0; i < numThreads; ++i) {
+            connections[i].join();
+            total += completed[i];
+        }
+        for (const std::string& error : errors) {
+            if (!error.empty()) {
+                std::cerr << "Error: " << error << "\n";
+                return 1;
+            }
+        }
+        std::cout << "Worker: " << total << " work items run for " << workerHost << ":" << workerPort << "\n";
+        return 0;
+    }
+
+    if (coordinate && !sweep && numReplications <= 1) {
+        std::cerr << "Error: --coordinator needs a sweep or replications\n";
+        return 1;
+    }
+
+    if (!resumeFile.empty() && (sweep || numReplications > 1)) {
+        std::cerr << "Error: --resume cannot be combined with sweeps or replications\n";
+        return 1;
+    }
+
+    if (!fleetComposition.empty()) {
+        int fleetVehicles = 0;
+        for (int count : fleetComposition) {
+            fleetVehicles += count;
+        }
+        if (sweepVehicles) {
+            std::cerr << "Error: --sweep-vehicles cannot be combined with a scenario fleet\n";
+            return 1;
+        }
+        if (fleetVehicles != numVehicles) {
+            std::cerr << "Error: Scenario fleet has " << fleetVehicles << " vehicles, --vehicles is " << numVehicles << "\n";
+            return 1;
+        }
+    }
+
+    // The fleet of a resumed run is the one of the checkpoint
+    SimulationCheckpoint checkpoint;
+    if (!resumeFile.empty()) {
+        if (!SimulationCheckpoint::read(resumeFile, checkpoint)) {
+            std::cerr << "Error: Could not read checkpoint " << resumeFile << "\n";
+            return 1;
+        }
+        if (hasFleetOptions) {
+            std::cerr << "Warning: Fleet options are ignored on --resume, the checkpoint configuration is used\n";
+        }
+        numVehicles = checkpoint.numVehicles;
+        numChargers = checkpoint.numChargers;
+        numVertiports = checkpoint.numVertiports;
+        dispatchPolicy = checkpoint.dispatchPolicy;
+        simTimeStepSeconds = checkpoint.simTimeStepSeconds;
+        randomizeVehicles = checkpoint.randomizeVehicles;
+        fleetComposition.clear();
+        engine = checkpoint.engine;
+        faultModel = checkpoint.faultModel;
+        if (!hasHours) {
+            simHours = checkpoint.simHours;
+        }
+        if (!hasSeed) {
+            seed = checkpoint.seed;
+            hasSeed = true;
+        }
+        if (simHours <= checkpoint.currentTime) {
+            std::cerr << "Error: Simulation hours must be past the checkpoint time of " << checkpoint.currentTime << " hours\n";
+            return 1;
+        }
+    }
+
+    // Every vertiport needs a charger, in every cell of a sweep
+    int fewestChargers = sweepChargers ? static_cast<int>(sweepSettings.chargers.start) : numChargers;
+    if (numVertiports > fewestChargers) {
+        std::cerr << "Error: Number of vertiports must not exceed the number of chargers\n";
+        return 1;
+    }
+
+    // Listens before the batch starts, so workers may connect while it is being set up
+    std::unique_ptr<WorkCoordinator> coordinator;
+    if (coordinate) {
+        try {
+            coordinator = std::make_unique<WorkCoordinator>(workSettings);
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Error: " << error.what() << "\n";
+            return 1;
+        }
+        std::cout << "Coordinator: waiting for workers on port " << coordinator->getPort() << std::endl;
+    }
+    BatchRunner batchRunner;
+    if (coordinator) {
+        batchRunner = [&coordinator](const std::vector<RunConfig>& configs) { return coordinator->run(configs); };
+    }
+
+    if (sweep) {
+        if (!sweepVehicles) sweepSettings.vehicles = {static_cast<double>(numVehicles), static_cast<double>(numVehicles), 1};
+        if (!sweepChargers) sweepSettings.chargers = {static_cast<double>(numChargers), static_cast<double>(numChargers), 1};
+        if (!sweepHours) sweepSettings.hours = {simHours, simHours, 1};
+        sweepSettings.simTimeStepSeconds = simTimeStepSeconds;
+        sweepSettings.vertiports = numVertiports;
+        sweepSettings.dispatchPolicy = dispatchPolicy;
+        sweepSettings.randomizeVehicles = randomizeVehicles;
+        sweepSettings.fleetComposition = fleetComposition;
+        sweepSettings.engine = engine;
+        sweepSettings.faultModel = faultModel;
+        sweepSettings.threads = numThreads;
+        // A fixed default seed so repeated sweeps hit the cache
+        sweepSettings.seed = hasSeed ? seed : 0;
+
+        SweepRunner runner(sweepSettings);
+        runner.setBatchRunner(batchRunner);
+        try {
+            runner.run();
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Error: " << error.what() << "\n";
+            return 1;
+        }
+
+        if (sweepOutput.empty()) {
+            std::filesystem::create_directories("output");
+            sweepOutput = "output/eVTOL_sweep_" + Logger::getCurrentTimestamp() + ".csv";
+        }
+        std::ofstream csv(sweepOutput);
+        if (!csv) {
+            std::cerr << "Error: Could not open sweep output file " << sweepOutput << "\n";
+            return 1;
+        }
+        runner.writeCsv(csv);
+
+        std::cout << "Sweep: " << runner.getCells().size() << " configurations, "
+                  << runner.getComputedCount() << " computed, "
+                  << (runner.getCells().size() - runner.getComputedCount()) << " from cache\n";
+        std::cout << "Results: " << sweepOutput << "\n";
+        if (coordinator) {
+            std::cout << "Workers: " << coordinator->getWorkersSeen() << " connected, " << coordinator->getRetries() << " items retried\n";
+        }
+        return 0;
+    }
+
+    if (numReplications > 1) {
+        ReplicationSettings settings;
+        settings.numVehicles = numVehicles;
+        settings.simHours = simHours;
+        settings.numChargers = numChargers;
+        settings.vertiports = numVertiports;
+        settings.dispatchPolicy = dispatchPolicy;
+        settings.simTimeStepSeconds = simTimeStepSeconds;
+        settings.randomizeVehicles = randomizeVehicles;
+        settings.fleetComposition = fleetComposition;
+        settings.engine = engine;
+        settings.faultModel = faultModel;
+        settings.replications = numReplications;
+        settings.threads = numThreads;
+        settings.seed = hasSeed ? seed : std::random_device{}();
+
+        ReplicationRunner runner(settings);
+        runner.setBatchRunner(batchRunner);
+        try {
+            runner.run();
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Error: " << error.what() << "\n";
+            return 1;
+        }
+
+        // A single report for the whole batch
+        std::filesystem::create_directories("output");
+        Logger logger("output/eVTOL_sim_replications_" + Logger::getCurrentTimestamp() + ".txt");
+        logger.setFlushPolicy(flushPolicy, flushIntervalMs);
+        runner.printReport(logger);
+        logger.logLine();
+        logger.logLine("  Log File: " + logger.getLogFile());
+        return 0;
+    }
+
     // Create and run simulation with parsed parameters
-    Simulation simulation(numVehicles, simHours, numChargers, simTimeStepSeconds, simLogVerbosity, randomizeVehicles);
+    Simulation simulation(numVehicles, simHours, numChargers, simTimeStepSeconds, simLogVerbosity, randomizeVehicles, true);
+    if (!fleetComposition.empty()) {
+        simulation.setFleetComposition(fleetComposition);
+    }
+    simulation.setEngine(engine);
+    simulation.setThreads(numThreads);
+    simulation.setVertiports(numVertiports);
+    simulation.setDispatchPolicy(dispatchPolicy);
+    simulation.setFaultModel(faultModel);
+    simulation.setTraceFormat(traceFormat, traceFile);
+    if (hasSeed) {
+        simulation.setSeed(seed);
+    }
+    simulation.setProfileFile(profileFile);
+    simulation.setMetricsFile(metricsFile, metricsIntervalMs);
+    simulation.setTimeSeriesFile(timeSeriesFile);
+    simulation.setShowProgress(showProgress);
+    if (checkpointInterval > 0) {
+        simulation.setCheckpointInterval(checkpointInterval, checkpointFile);
+    }
+    if (!resumeFile.empty() && !simulation.resumeFrom(checkpoint)) {
+        std::cerr << "Error: Checkpoint " << resumeFile << " does not match the simulation\n";
+        return 1;
+    }
+    simulation.getLogger().setFlushPolicy(flushPolicy, flushIntervalMs);
+    simulation.getLogger().setAsync(asyncLog);
     simulation.runSimulation();
 
     return 0;
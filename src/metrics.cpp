@@ -0,0 +1,110 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation file for the MetricsExporter class
+ *
+ * See metrics.hpp for class documentation.
+ */
+
+#include "metrics.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+void writeGauge(std::ostream& out, const std::string& name, const std::string& help, const std::string& type, double value) {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+    out << name << ' ' << value << '\n';
+}
+
+// One metric with a sample per vehicle type that has vehicles
+template <typename Getter>
+void writePerType(std::ostream& out, const MetricsSnapshot& snapshot, const std::string& name, const std::string& help,
+                  const std::string& type, Getter getter) {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+    for (size_t i = 0; i < MetricsSnapshot::NUM_TYPES; ++i) {
+        if (snapshot.types[i].vehicles > 0) {
+            out << name << "{type=\"" << getManufacturerName(static_cast<Vehicle::Manufacturer>(i)) << "\"} "
+                << getter(snapshot.types[i]) << '\n';
+        }
+    }
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(const std::string& filename, int intervalMs)
+    : filename(filename),
+      intervalMs(intervalMs),
+      writer(&MetricsExporter::run, this) {}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+void MetricsExporter::run() {
+    uint64_t written = 0; // Version of the snapshot in the file
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        bool stop = wakeUp.wait_for(lock, std::chrono::milliseconds(intervalMs), [this]() { return stopping; });
+        if (latest.version() != written) {
+            written = latest.version();
+            lock.unlock();
+            writeFile(latest.load());
+            lock.lock();
+        }
+        if (stop) {
+            return;
+        }
+    }
+}
+
+bool MetricsExporter::writeFile(const MetricsSnapshot& snapshot) const {
+    // Readers never see a partial file
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        writePrometheus(file, snapshot);
+        if (!file.flush()) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    return !error;
+}
+
+void MetricsExporter::writePrometheus(std::ostream& out, const MetricsSnapshot& snapshot) {
+    out << std::setprecision(12);
+    writeGauge(out, "evtol_sim_time_hours", "Simulation time reached", "gauge", snapshot.simTime);
+    writeGauge(out, "evtol_sim_length_hours", "Simulation length", "gauge", snapshot.simHours);
+    writeGauge(out, "evtol_steps_total", "Steps (or events) processed", "counter", static_cast<double>(snapshot.steps));
+    writeGauge(out, "evtol_steps_per_second", "Steps (or events) per wall second", "gauge", snapshot.stepsPerSecond);
+    writeGauge(out, "evtol_wall_seconds", "Wall time since the run started", "gauge", snapshot.wallSeconds);
+    writeGauge(out, "evtol_charging_queue_length", "Vehicles waiting for a charger", "gauge", snapshot.queueLength);
+    writeGauge(out, "evtol_chargers", "Charging stations", "gauge", snapshot.numChargers);
+    writeGauge(out, "evtol_chargers_busy", "Charging stations in use", "gauge", snapshot.chargersBusy);
+    writeGauge(out, "evtol_charger_occupancy_ratio", "Share of charging stations in use", "gauge",
+               snapshot.numChargers > 0 ? static_cast<double>(snapshot.chargersBusy) / snapshot.numChargers : 0.0);
+    writeGauge(out, "evtol_run_done", "1 once the run has finished", "gauge", snapshot.done);
+
+    using Totals = MetricsSnapshot::TypeTotals;
+    writePerType(out, snapshot, "evtol_vehicles", "Vehicles", "gauge", [](const Totals& t) { return t.vehicles; });
+    writePerType(out, snapshot, "evtol_flights_total", "Completed flights", "counter", [](const Totals& t) { return t.flights; });
+    writePerType(out, snapshot, "evtol_charges_total", "Completed charging sessions", "counter", [](const Totals& t) { return t.charges; });
+    writePerType(out, snapshot, "evtol_faults_total", "Faults", "counter", [](const Totals& t) { return t.faults; });
+    writePerType(out, snapshot, "evtol_flight_hours_total", "Flight time", "counter", [](const Totals& t) { return t.flightTime; });
+    writePerType(out, snapshot, "evtol_distance_miles_total", "Distance flown", "counter", [](const Totals& t) { return t.distance; });
+    writePerType(out, snapshot, "evtol_charging_hours_total", "Time on a charger", "counter", [](const Totals& t) { return t.chargingTime; });
+    writePerType(out, snapshot, "evtol_queued_hours_total", "Time waiting for a charger", "counter", [](const Totals& t) { return t.queuedTime; });
+    writePerType(out, snapshot, "evtol_passenger_miles_total", "Passenger miles", "counter", [](const Totals& t) { return t.passengerMiles; });
+}
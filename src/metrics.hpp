@@ -0,0 +1,90 @@
+/**
+ * @file metrics.hpp
+ * @brief Header file for the MetricsSnapshot structure and the MetricsExporter class
+ *
+ * A running simulation publishes a MetricsSnapshot (simulation time, steps per second,
+ * charging queue length, charger occupancy and the running totals per vehicle type) through
+ * a SeqLock, which never blocks the simulation loop. The exporter's thread reads the latest
+ * snapshot every interval and rewrites a metrics file in the Prometheus text format, e.g.
+ * for the textfile collector of the node exporter or for a quick `watch cat`.
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "seqlock.hpp"
+#include "vehicle_registry.hpp"
+
+const int DEFAULT_METRICS_INTERVAL_MS = 1000; // Default interval between metrics file updates
+
+struct MetricsSnapshot {
+    static constexpr size_t NUM_TYPES = MAX_VEHICLE_TYPES;
+
+    struct TypeTotals {
+        uint32_t vehicles;
+        uint64_t flights;
+        uint64_t charges;
+        uint64_t faults;
+        double flightTime;     // [hours]
+        double distance;       // [miles]
+        double chargingTime;   // [hours]
+        double queuedTime;     // [hours]
+        double passengerMiles; // [miles]
+    };
+
+    double simTime;        // [hours]
+    double simHours;       // Simulation length [hours]
+    uint64_t steps;        // Steps (or events) processed
+    double wallSeconds;    // Wall time since the run started
+    double stepsPerSecond; // Over the last publish interval
+    uint32_t numVehicles;
+    uint32_t numChargers;
+    uint32_t chargersBusy;
+    uint32_t queueLength;
+    uint32_t done;         // 1 once the run has finished
+    TypeTotals types[NUM_TYPES];
+};
+
+class MetricsExporter {
+public:
+    /**
+     * @param filename Metrics file, replaced atomically on every update.
+     * @param intervalMs Wall time between updates of the file.
+     */
+    MetricsExporter(const std::string& filename, int intervalMs = DEFAULT_METRICS_INTERVAL_MS);
+
+    // Writes the last published snapshot before returning
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Simulation thread only, never blocks
+    void publish(const MetricsSnapshot& snapshot) { latest.store(snapshot); }
+
+    const std::string& getFilename() const { return filename; }
+
+    static void writePrometheus(std::ostream& out, const MetricsSnapshot& snapshot);
+
+private:
+    void run();
+    bool writeFile(const MetricsSnapshot& snapshot) const;
+
+    std::string filename;
+    int intervalMs;
+    SeqLock<MetricsSnapshot> latest;
+
+    std::mutex mutex; // Only guards stopping
+    std::condition_variable wakeUp;
+    bool stopping = false;
+    std::thread writer;
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file profiler.cpp
+ * @brief Implementation file for the Profiler class
+ *
+ * See profiler.hpp for class documentation.
+ */
+
+#include "profiler.hpp"
+
+void Profiler::begin() {
+    nanoseconds.fill(0);
+    calls.fill(0);
+    for (auto& counter : counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    current = Phase::Other;
+    since = std::chrono::steady_clock::now();
+}
+
+void Profiler::end() {
+    charge(std::chrono::steady_clock::now());
+    current = Phase::Other;
+}
+
+double Profiler::getTotalSeconds() const {
+    double total = 0.0;
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        total += getSeconds(static_cast<Phase>(i));
+    }
+    return total;
+}
+
+double Profiler::getCategorySeconds(Category category) const {
+    double total = 0.0;
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        if (getCategory(static_cast<Phase>(i)) == category) {
+            total += getSeconds(static_cast<Phase>(i));
+        }
+    }
+    return total;
+}
+
+Profiler::Category Profiler::getCategory(Phase phase) {
+    switch (phase) {
+        case Phase::UpdateVehicles: return Category::Physics;
+        case Phase::ReleaseChargers:
+        case Phase::QueueVehicles:
+        case Phase::AssignChargers:
+        case Phase::ScheduleEvents: return Category::Scheduling;
+        case Phase::Logging:
+        case Phase::Trace:
+        case Phase::Checkpoint: return Category::IO;
+        default: return Category::Other;
+    }
+}
+
+std::string Profiler::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::UpdateVehicles: return "Update vehicles";
+        case Phase::ReleaseChargers: return "Release chargers";
+        case Phase::QueueVehicles: return "Queue vehicles";
+        case Phase::AssignChargers: return "Assign chargers";
+        case Phase::ScheduleEvents: return "Schedule events";
+        case Phase::Logging: return "Logging";
+        case Phase::Trace: return "Trace";
+        case Phase::Checkpoint: return "Checkpoints";
+        default: return "Other";
+    }
+}
+
+std::string Profiler::getCategoryName(Category category) {
+    switch (category) {
+        case Category::Physics: return "physics";
+        case Category::Scheduling: return "scheduling";
+        case Category::IO: return "io";
+        default: return "other";
+    }
+}
+
+std::string Profiler::getCounterName(Counter counter) {
+    switch (counter) {
+        case Counter::StateTransitions: return "state_transitions";
+        case Counter::QueuePushes: return "queue_pushes";
+        case Counter::EventPushes: return "event_pushes";
+        case Counter::RngDraws: return "rng_draws";
+        default: return "unknown";
+    }
+}
+
+void Profiler::writeJson(std::ostream& out) const {
+    const double total = getTotalSeconds();
+    auto share = [total](double seconds) { return total > 0 ? seconds / total : 0.0; };
+
+    out << "{\n";
+    out << "  \"total_seconds\": " << total << ",\n";
+    out << "  \"phases\": [\n";
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        Phase phase = static_cast<Phase>(i);
+        out << "    {\"name\": \"" << getPhaseName(phase) << "\", \"category\": \""
+            << getCategoryName(getCategory(phase)) << "\", \"seconds\": " << getSeconds(phase)
+            << ", \"share\": " << share(getSeconds(phase)) << ", \"calls\": " << getCalls(phase) << "}"
+            << (i + 1 < NUM_PHASES ? ",\n" : "\n");
+    }
+    out << "  ],\n";
+    out << "  \"categories\": {";
+    const Category categories[] = {Category::Physics, Category::Scheduling, Category::IO, Category::Other};
+    for (size_t i = 0; i < 4; ++i) {
+        out << (i ? ", " : "") << "\"" << getCategoryName(categories[i]) << "\": " << getCategorySeconds(categories[i]);
+    }
+    out << "},\n";
+    out << "  \"counters\": {";
+    for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+        Counter counter = static_cast<Counter>(i);
+        out << (i ? ", " : "") << "\"" << getCounterName(counter) << "\": " << getCount(counter);
+    }
+    out << "}\n";
+    out << "}\n";
+}
@@ -0,0 +1,159 @@
+/**
+ * @file profiler.hpp
+ * @brief Header file for the Profiler class and the EVTOL_PROFILE_* macros
+ *
+ * The profiler splits the wall time of a run into the phases of a step (vehicle updates,
+ * charger handling, event scheduling, logging, ...) and counts hot-path operations (state
+ * transitions, charging queue pushes, event pushes, random draws). Phases are timed
+ * exclusively: a scope entered inside another one pauses the outer phase, so phases add up
+ * to the run time and nothing is counted twice.
+ *
+ * Profiling is compiled in with the EVTOL_PROFILING definition (CMake option of the same
+ * name). Without it the EVTOL_PROFILE_* macros expand to nothing and the hot path is
+ * unchanged. Scopes must only be entered on the simulation thread.
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class Profiler {
+public:
+#ifdef EVTOL_PROFILING
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    enum class Phase {
+        Other,           // Anything outside the scopes below (loop control, statistics, ...)
+        UpdateVehicles,  // Vehicle state machines
+        ReleaseChargers, // Freeing the chargers of vehicles done charging
+        QueueVehicles,   // Adding newly queued vehicles to the charging queue
+        AssignChargers,  // Handing chargers to queued vehicles
+        ScheduleEvents,  // Event queue of the event engine
+        Logging,         // Text report and progress bar
+        Trace,           // Binary trace records
+        Checkpoint,      // Writing checkpoints
+        NumPhases
+    };
+
+    // What a phase is spent on, to tell physics from scheduling from I/O
+    enum class Category {
+        Physics,
+        Scheduling,
+        IO,
+        Other
+    };
+
+    enum class Counter {
+        StateTransitions, // Vehicle state changes
+        QueuePushes,      // Vehicles added to the charging queue
+        EventPushes,      // Events added to the event queue
+        RngDraws,         // Random numbers drawn by the simulation and the vehicles
+        NumCounters
+    };
+
+    static constexpr size_t NUM_PHASES = static_cast<size_t>(Phase::NumPhases);
+    static constexpr size_t NUM_COUNTERS = static_cast<size_t>(Counter::NumCounters);
+
+    /**
+     * @brief Clear all times and counters and start timing the Other phase.
+     */
+    void begin();
+
+    /**
+     * @brief Stop timing, the run time is the sum of the phase times.
+     */
+    void end();
+
+    // Switch to a phase, returning the phase that was active
+    Phase enter(Phase phase) {
+        auto now = std::chrono::steady_clock::now();
+        charge(now);
+        Phase previous = current;
+        current = phase;
+        calls[static_cast<size_t>(phase)]++;
+        return previous;
+    }
+
+    // Return to the phase that was active before enter()
+    void leave(Phase previous) {
+        charge(std::chrono::steady_clock::now());
+        current = previous;
+    }
+
+    // Thread-safe, counters are also incremented from the worker threads
+    void count(Counter counter, uint64_t amount = 1) {
+        counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+    void setCount(Counter counter, uint64_t value) {
+        counters[static_cast<size_t>(counter)].store(value, std::memory_order_relaxed);
+    }
+
+    double getSeconds(Phase phase) const { return nanoseconds[static_cast<size_t>(phase)] * 1e-9; }
+    uint64_t getCalls(Phase phase) const { return calls[static_cast<size_t>(phase)]; }
+    uint64_t getCount(Counter counter) const { return counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed); }
+    double getTotalSeconds() const;
+    double getCategorySeconds(Category category) const;
+
+    static Category getCategory(Phase phase);
+    static std::string getPhaseName(Phase phase);
+    static std::string getCategoryName(Category category);
+    static std::string getCounterName(Counter counter);
+
+    /**
+     * @brief Write the times per phase and category and the counters as a JSON object.
+     */
+    void writeJson(std::ostream& out) const;
+
+private:
+    void charge(std::chrono::steady_clock::time_point now) {
+        nanoseconds[static_cast<size_t>(current)] +=
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - since).count());
+        since = now;
+    }
+
+    Phase current = Phase::Other;
+    std::chrono::steady_clock::time_point since;
+    std::array<uint64_t, NUM_PHASES> nanoseconds{};
+    std::array<uint64_t, NUM_PHASES> calls{};
+    std::array<std::atomic<uint64_t>, NUM_COUNTERS> counters{};
+};
+
+/**
+ * @brief Times the enclosing scope as a phase of a profiler.
+ */
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, Profiler::Phase phase)
+        : profiler(profiler), previous(profiler.enter(phase)) {}
+    ~ProfileScope() { profiler.leave(previous); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+    Profiler::Phase previous;
+};
+
+#define EVTOL_PROFILE_CONCAT_INNER(a, b) a##b
+#define EVTOL_PROFILE_CONCAT(a, b) EVTOL_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef EVTOL_PROFILING
+#define EVTOL_PROFILE_SCOPE(profiler, phase) \
+    ProfileScope EVTOL_PROFILE_CONCAT(profileScope, __LINE__)((profiler), Profiler::Phase::phase)
+#define EVTOL_PROFILE_COUNT(profiler, counter, amount) (profiler).count(Profiler::Counter::counter, (amount))
+#else
+#define EVTOL_PROFILE_SCOPE(profiler, phase) ((void)0)
+#define EVTOL_PROFILE_COUNT(profiler, counter, amount) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,289 @@
+/**
+ * @file regression.cpp
+ * @brief Implementation file for the RegressionRunner class
+ */
+
+#include "regression.hpp"
+#include "scenario.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+/* Comparisons */
+namespace {
+
+// A total of VehicleTypeStats, with the scale its tolerance is relative to
+struct RegressionMetric {
+    const char* name;
+    double (*value)(const VehicleTypeStats& stats);
+    bool isCount;
+    bool isTime; // Hours, at least a share of the type's fleet hours in the statistical cases
+};
+
+const RegressionMetric REGRESSION_METRICS[] = {
+    {"flights", [](const VehicleTypeStats& s) { return static_cast<double>(s.totalFlights); }, true, false},
+    {"charges", [](const VehicleTypeStats& s) { return static_cast<double>(s.totalCharges); }, true, false},
+    {"flight hours", [](const VehicleTypeStats& s) { return s.totalFlightTime; }, false, true},
+    {"miles", [](const VehicleTypeStats& s) { return s.totalDistance; }, false, false},
+    {"charging hours", [](const VehicleTypeStats& s) { return s.totalChargingTime; }, false, true},
+    {"queued hours", [](const VehicleTypeStats& s) { return s.totalQueuedTime; }, false, true},
+    {"passenger miles", [](const VehicleTypeStats& s) { return s.totalPassengerMiles; }, false, false},
+};
+
+std::string formatValue(double value) {
+    std::ostringstream out;
+    out << std::setprecision(12) << value;
+    return out.str();
+}
+
+} // namespace
+
+std::vector<std::string> compareTypeStats(const VehicleTypeStatsTable& reference, const VehicleTypeStatsTable& actual,
+                                          bool exact, double tolerance, double simHours) {
+    std::vector<std::string> mismatches;
+    for (const auto& pair : actual) {
+        if (!reference.contains(pair.first)) {
+            mismatches.push_back(pair.second.manufacturerName + ": not in the reference run");
+        }
+    }
+    for (const auto& pair : reference) {
+        const VehicleTypeStats& expected = pair.second;
+        const std::string& name = expected.manufacturerName;
+        if (!actual.contains(pair.first)) {
+            mismatches.push_back(name + ": missing");
+            continue;
+        }
+        const VehicleTypeStats& stats = actual.at(pair.first);
+        if (stats.vehicleCount != expected.vehicleCount) {
+            mismatches.push_back(name + " vehicles: " + std::to_string(stats.vehicleCount) + ", reference " +
+                                 std::to_string(expected.vehicleCount));
+            continue;
+        }
+        if (exact && stats.totalFaults != expected.totalFaults) {
+            mismatches.push_back(name + " faults: " + std::to_string(stats.totalFaults) + ", reference " +
+                                 std::to_string(expected.totalFaults));
+        }
+
+        const double fleetHours = expected.vehicleCount * simHours;
+        for (const RegressionMetric& metric : REGRESSION_METRICS) {
+            double want = metric.value(expected);
+            double got = metric.value(stats);
+            double allowed = 0.0;
+            if (exact) {
+                allowed = metric.isCount ? 0.0 : EPSILON * std::max(1.0, std::fabs(want));
+            } else {
+                // Short totals (e.g. queued hours without contention) are compared against the fleet hours,
+                // session counts also differ by the order of nearly simultaneous transitions
+                double scale = metric.isTime ? std::max(std::fabs(want), tolerance * fleetHours) : std::fabs(want);
+                allowed = tolerance * std::max(1.0, scale) + (metric.isCount ? std::sqrt(std::fabs(want)) : 0.0);
+            }
+            if (std::fabs(got - want) > allowed) {
+                mismatches.push_back(name + " " + metric.name + ": " + formatValue(got) + ", reference " +
+                                     formatValue(want));
+            }
+        }
+    }
+    return mismatches;
+}
+
+std::vector<std::string> checkFaultBounds(const VehicleTypeStatsTable& typeStats) {
+    std::vector<std::string> mismatches;
+    for (const auto& pair : typeStats) {
+        const VehicleTypeStats& stats = pair.second;
+        double expected = stats.expectedFaultRate * stats.totalFlightTime;
+        double bound = FAULT_BOUND_SIGMAS * std::sqrt(expected) + 1.0;
+        if (std::fabs(stats.totalFaults - expected) > bound) {
+            mismatches.push_back(stats.manufacturerName + " faults: " + std::to_string(stats.totalFaults) +
+                                 ", expected " + formatValue(expected) + " +/- " + formatValue(bound));
+        }
+    }
+    return mismatches;
+}
+
+/* Cases */
+std::string RegressionCase::label() const {
+    return engineToString(engine) + "/" + std::to_string(threads) + "/" + faultModelToString(faultModel);
+}
+
+/* RegressionRunner */
+RegressionRunner::RegressionRunner(const RegressionSettings& settings) : settings(settings) {}
+
+std::vector<RegressionScenario> RegressionRunner::scenarios(bool quick) {
+    auto scenario = [](const std::string& name, int vehicles, double hours, int chargers, int vertiports,
+                       DispatchPolicy policy) {
+        RegressionScenario result;
+        result.name = name;
+        result.config.numVehicles = vehicles;
+        result.config.simHours = hours;
+        result.config.numChargers = chargers;
+        result.config.vertiports = vertiports;
+        result.config.dispatchPolicy = policy;
+        return result;
+    };
+    // Many chargers per vehicle, few chargers per vehicle, and a network of sites
+    if (quick) {
+        return {scenario("fleet", 500, 2.0, 50, 1, DispatchPolicy::Fifo),
+                scenario("contention", 500, 2.0, 10, 1, DispatchPolicy::Fifo),
+                scenario("vertiports", 500, 2.0, 40, 4, DispatchPolicy::FairShare)};
+    }
+    return {scenario("fleet", 10000, 4.0, 1000, 1, DispatchPolicy::Fifo),
+            scenario("contention", 10000, 4.0, 200, 1, DispatchPolicy::Fifo),
+            scenario("vertiports", 10000, 4.0, 1000, 100, DispatchPolicy::FairShare)};
+}
+
+std::vector<RegressionCase> RegressionRunner::cases(int threads) {
+    using Engine = SimulationEngine;
+    const Vehicle::FaultModel step = Vehicle::FaultModel::PerStep;
+    const Vehicle::FaultModel exponential = Vehicle::FaultModel::Exponential;
+    const std::vector<RegressionCase> all = {
+        {Engine::FixedStep, 1, step},        {Engine::FixedStep, threads, step},
+        {Engine::StructOfArrays, 1, step},   {Engine::StructOfArrays, threads, step},
+        {Engine::FixedStep, 1, exponential}, {Engine::StructOfArrays, threads, exponential},
+        {Engine::Adaptive, 1, exponential},  {Engine::Adaptive, threads, exponential},
+        {Engine::EventDriven, 1, exponential},
+    };
+    // With one thread the threaded cases are the single threaded ones
+    std::vector<RegressionCase> result;
+    for (const RegressionCase& run : all) {
+        bool duplicate = std::any_of(result.begin(), result.end(), [&](const RegressionCase& other) {
+            return other.label() == run.label();
+        });
+        if (!duplicate) {
+            result.push_back(run);
+        }
+    }
+    return result;
+}
+
+void RegressionRunner::run(std::ostream* progress) {
+    results.clear();
+    for (const RegressionScenario& scenario : scenarios(settings.quick)) {
+        std::map<Vehicle::FaultModel, VehicleTypeStatsTable> references;
+        for (const RegressionCase& run : cases(settings.threads)) {
+            RunConfig config = scenario.config;
+            config.engine = run.engine;
+            config.threads = run.threads;
+            config.faultModel = run.faultModel;
+            config.seed = settings.seed;
+
+            RegressionResult result;
+            result.scenario = scenario.name;
+            result.run = run;
+            RunResults first;
+            double timed = 0.0;
+            for (int repeat = 0; repeat < std::max(1, settings.repeats) ||
+                                 (timed < MIN_TIMED_SECONDS && repeat < MAX_TIMED_REPEATS);
+                 ++repeat) {
+                auto start = std::chrono::steady_clock::now();
+                RunResults results = simulate(config);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                timed += seconds;
+                if (repeat == 0 || seconds < result.wallSeconds) {
+                    result.wallSeconds = seconds;
+                }
+                if (repeat == 0) {
+                    first = std::move(results);
+                }
+            }
+            double steps = std::ceil(config.simHours * 3600.0 / config.simTimeStepSeconds - EPSILON);
+            result.vehicleStepsPerSecond = config.numVehicles * steps / std::max(result.wallSeconds, 1e-9);
+
+            if (run.isReference()) {
+                references[run.faultModel] = first.typeStats;
+            } else {
+                auto reference = references.find(run.faultModel);
+                if (reference == references.end()) {
+                    throw std::runtime_error("No reference run for fault model " + faultModelToString(run.faultModel));
+                }
+                result.mismatches = compareTypeStats(reference->second, first.typeStats, run.isExact(),
+                                                     settings.tolerance, config.simHours);
+            }
+            for (std::string& mismatch : checkFaultBounds(first.typeStats)) {
+                result.mismatches.push_back(std::move(mismatch));
+            }
+
+            auto stored = baseline.find(scenario.name + " " + run.label());
+            if (stored != baseline.end()) {
+                result.baselineStepsPerSecond = stored->second;
+            }
+            results.push_back(result);
+            if (progress) {
+                *progress << scenario.name << " " << run.label() << ": " << std::fixed << std::setprecision(3)
+                          << result.wallSeconds << " s" << (result.mismatches.empty() ? "" : ", MISMATCH") << std::endl;
+            }
+        }
+    }
+}
+
+void RegressionRunner::readBaseline(std::istream& in) {
+    baseline.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string scenario;
+        std::string label;
+        std::string speed;
+        std::string extra;
+        if (!(fields >> scenario)) {
+            continue;
+        }
+        double value = 0.0;
+        if (!(fields >> label >> speed) || (fields >> extra) || !parseDouble(speed, value) || value <= 0) {
+            throw std::runtime_error("Baseline line " + std::to_string(lineNumber) +
+                                     ": expected <scenario> <case> <vehicle-steps/s>");
+        }
+        baseline[scenario + " " + label] = value;
+    }
+}
+
+void RegressionRunner::writeBaseline(std::ostream& out) const {
+    out << "# scenario case vehicle-steps/s\n";
+    for (const RegressionResult& result : results) {
+        out << result.scenario << " " << result.run.label() << " " << std::setprecision(6)
+            << result.vehicleStepsPerSecond << "\n";
+    }
+}
+
+int RegressionRunner::getMismatchCount() const {
+    return static_cast<int>(std::count_if(results.begin(), results.end(),
+                                          [](const RegressionResult& result) { return !result.mismatches.empty(); }));
+}
+
+int RegressionRunner::getSlowerCount() const {
+    return static_cast<int>(std::count_if(results.begin(), results.end(), [this](const RegressionResult& result) {
+        return result.isSlower(settings.speedThreshold);
+    }));
+}
+
+void RegressionRunner::printReport(std::ostream& out) const {
+    out << std::left << std::setw(12) << "Scenario" << std::setw(24) << "Case" << std::right << std::setw(12)
+        << "Wall (s)" << std::setw(18) << "Vehicle-steps/s" << std::setw(12) << "Baseline" << "  Result\n";
+    for (const RegressionResult& result : results) {
+        std::ostringstream vsPerSecond;
+        vsPerSecond << std::scientific << std::setprecision(3) << result.vehicleStepsPerSecond;
+        std::ostringstream versus;
+        if (result.baselineStepsPerSecond > 0) {
+            versus << std::showpos << std::fixed << std::setprecision(1)
+                   << 100.0 * (result.vehicleStepsPerSecond / result.baselineStepsPerSecond - 1.0) << "%";
+        } else {
+            versus << "-";
+        }
+        std::string verdict = result.run.isReference() ? "reference" : (result.run.isExact() ? "exact" : "statistical");
+        if (!result.mismatches.empty()) {
+            verdict = "MISMATCH";
+        } else if (result.isSlower(settings.speedThreshold)) {
+            verdict = "SLOWER";
+        }
+        out << std::left << std::setw(12) << result.scenario << std::setw(24) << result.run.label() << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3) << result.wallSeconds << std::setw(18)
+            << vsPerSecond.str() << std::setw(12) << versus.str() << "  " << verdict << "\n";
+        for (const std::string& mismatch : result.mismatches) {
+            out << "    " << mismatch << "\n";
+        }
+    }
+}
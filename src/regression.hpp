@@ -0,0 +1,136 @@
+/**
+ * @file regression.hpp
+ * @brief Header file for the RegressionRunner class
+ *
+ * RegressionRunner runs the same seeded scenarios through every engine and checks each run
+ * against the reference run, the fixed step engine on one thread with the same fault model:
+ *
+ * - Exact cases, fixed step and soa on any number of threads, draw from the same streams in
+ *   the same order as the reference. Counts must match and totals agree within EPSILON,
+ *   relative to the reference.
+ * - Statistical cases, the adaptive and event-driven engines, move time in other steps and
+ *   always use the exponential fault model. Vehicle counts must match, the other totals of
+ *   every vehicle type agree within a relative tolerance, session counts within the
+ *   tolerance plus one Poisson standard deviation.
+ *
+ * The faults of every run, the reference included, must also be within FAULT_BOUND_SIGMAS
+ * standard deviations of a Poisson count with the expected fault rate over the flight hours.
+ *
+ * Every run is timed, the fastest of a number of repeats (more for runs shorter than
+ * MIN_TIMED_SECONDS), and reported in vehicle-steps per second: vehicles times the fixed
+ * time steps of the run, divided by the wall time, so the engines that skip steps are
+ * credited for them. A baseline file stores the speed of every scenario and case; a later
+ * run fails when it is slower by more than a threshold.
+ */
+
+#ifndef REGRESSION_HPP
+#define REGRESSION_HPP
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "run.hpp"
+#include "simulation.hpp"
+
+const double DEFAULT_REGRESSION_TOLERANCE = 0.02; // Relative tolerance of the statistical cases
+const double DEFAULT_SPEED_THRESHOLD = 0.25;      // Fraction slower than the baseline that fails a case
+const int DEFAULT_REGRESSION_REPEATS = 3;         // Timed runs per case, the fastest counts
+const double FAULT_BOUND_SIGMAS = 5.0;            // Width of the fault count bound in Poisson standard deviations
+const double MIN_TIMED_SECONDS = 0.2;             // Short cases repeat until they ran this long, for a stable fastest time
+const int MAX_TIMED_REPEATS = 1000;
+
+struct RegressionScenario {
+    std::string name;
+    RunConfig config; // Engine, threads and fault model are those of each case
+};
+
+struct RegressionCase {
+    SimulationEngine engine = SimulationEngine::FixedStep;
+    int threads = 1;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+
+    // Same draws in the same order as the reference, see the file comment
+    bool isExact() const { return engine == SimulationEngine::FixedStep || engine == SimulationEngine::StructOfArrays; }
+    bool isReference() const { return engine == SimulationEngine::FixedStep && threads == 1; }
+
+    // e.g. "soa/4/step"
+    std::string label() const;
+};
+
+struct RegressionSettings {
+    bool quick = false;                // Small scenarios, e.g. for every test run
+    int threads = 4;                   // Threads of the threaded cases
+    int repeats = DEFAULT_REGRESSION_REPEATS;
+    double tolerance = DEFAULT_REGRESSION_TOLERANCE;
+    double speedThreshold = DEFAULT_SPEED_THRESHOLD;
+    uint64_t seed = 1;
+};
+
+struct RegressionResult {
+    std::string scenario;
+    RegressionCase run;
+    double wallSeconds = 0.0;            // Fastest repeat
+    double vehicleStepsPerSecond = 0.0;
+    double baselineStepsPerSecond = 0.0; // 0 without a baseline for this case
+    std::vector<std::string> mismatches; // Results outside the tolerances, empty if equivalent
+
+    bool isSlower(double threshold) const {
+        return baselineStepsPerSecond > 0 && vehicleStepsPerSecond < baselineStepsPerSecond * (1.0 - threshold);
+    }
+};
+
+/**
+ * @brief Compare the statistics of a run with those of the reference run.
+ * @param simHours Run length, the scale of the time totals of the statistical cases.
+ * @return One message per vehicle type and total outside the tolerance.
+ */
+std::vector<std::string> compareTypeStats(const VehicleTypeStatsTable& reference, const VehicleTypeStatsTable& actual,
+                                          bool exact, double tolerance, double simHours);
+
+/**
+ * @brief Check the faults of every vehicle type against a Poisson count at the expected rate.
+ */
+std::vector<std::string> checkFaultBounds(const VehicleTypeStatsTable& typeStats);
+
+class RegressionRunner {
+public:
+    explicit RegressionRunner(const RegressionSettings& settings);
+
+    static std::vector<RegressionScenario> scenarios(bool quick);
+
+    /**
+     * @brief Cases of every scenario, the reference of each fault model first.
+     */
+    static std::vector<RegressionCase> cases(int threads);
+
+    /**
+     * @brief Run every case of every scenario, comparing results and speed as it goes.
+     * @param progress Receives a line per case, may be null.
+     */
+    void run(std::ostream* progress = nullptr);
+
+    /**
+     * @brief Read the speeds of a baseline file, "<scenario> <case> <vehicle-steps/s>" lines.
+     * @throws std::runtime_error for a malformed line.
+     */
+    void readBaseline(std::istream& in);
+    void writeBaseline(std::ostream& out) const;
+
+    const std::vector<RegressionResult>& getResults() const { return results; }
+
+    // Number of cases with mismatches, and slower than the baseline by more than the threshold
+    int getMismatchCount() const;
+    int getSlowerCount() const;
+
+    void printReport(std::ostream& out) const;
+
+private:
+    RegressionSettings settings;
+    std::map<std::string, double> baseline; // Vehicle-steps/s by "<scenario> <case>"
+    std::vector<RegressionResult> results;
+};
+
+#endif
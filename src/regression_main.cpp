@@ -0,0 +1,138 @@
+#include "regression.hpp"
+#include "scenario.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n";
+    std::cout << "\nRuns seeded scenarios through every engine and thread count, checks the results\n";
+    std::cout << "against the fixed step engine on one thread and reports the speed of every case.\n";
+    std::cout << "Exits with 1 if a case does not match or is slower than the baseline.\n";
+    std::cout << "\nOptions:\n";
+    std::cout << "  --quick                  Small scenarios, e.g. for every test run\n";
+    std::cout << "  --threads <num>          Threads of the threaded cases (default: 4)\n";
+    std::cout << "  --repeats <num>          Timed runs per case, the fastest counts (default: " << DEFAULT_REGRESSION_REPEATS << ")\n";
+    std::cout << "  --tolerance <fraction>   Relative tolerance of the adaptive and event engines (default: " << DEFAULT_REGRESSION_TOLERANCE << ")\n";
+    std::cout << "  --threshold <fraction>   Fail cases slower than the baseline by more than this (default: " << DEFAULT_SPEED_THRESHOLD << ")\n";
+    std::cout << "  --seed <num>             Seed of every run (default: 1)\n";
+    std::cout << "  --baseline <file>        Compare the speeds with a baseline file, written by this run\n";
+    std::cout << "                           if it does not exist yet\n";
+    std::cout << "  --update-baseline        Overwrite the baseline file with the speeds of this run\n";
+    std::cout << "  --help                   Show this help message\n";
+    std::cout << "\nLong options also accept the form --option=value.\n";
+}
+
+int main(int argc, char* argv[]) {
+    RegressionSettings settings;
+    std::string baselineFile;
+    bool updateBaseline = false;
+
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        if (arg.rfind("--", 0) == 0 && equals != std::string::npos) {
+            args.push_back(arg.substr(0, equals));
+            args.push_back(arg.substr(equals + 1));
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (arg == "--quick") {
+            settings.quick = true;
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!parseInt(args[++i], settings.threads) || settings.threads <= 0) {
+                std::cerr << "Error: Number of threads must be positive\n";
+                return 1;
+            }
+        }
+        else if (arg == "--repeats" && hasValue) {
+            if (!parseInt(args[++i], settings.repeats) || settings.repeats <= 0) {
+                std::cerr << "Error: Number of repeats must be positive\n";
+                return 1;
+            }
+        }
+        else if (arg == "--tolerance" && hasValue) {
+            if (!parseDouble(args[++i], settings.tolerance) || settings.tolerance <= 0) {
+                std::cerr << "Error: Tolerance must be positive\n";
+                return 1;
+            }
+        }
+        else if (arg == "--threshold" && hasValue) {
+            if (!parseDouble(args[++i], settings.speedThreshold) || settings.speedThreshold <= 0 ||
+                settings.speedThreshold >= 1) {
+                std::cerr << "Error: Speed threshold must be between 0 and 1\n";
+                return 1;
+            }
+        }
+        else if (arg == "--seed" && hasValue) {
+            if (!parseUint64(args[++i], settings.seed)) {
+                std::cerr << "Error: Seed must be a non-negative integer\n";
+                return 1;
+            }
+        }
+        else if (arg == "--baseline" && hasValue) {
+            baselineFile = args[++i];
+        }
+        else if (arg == "--update-baseline") {
+            updateBaseline = true;
+        }
+        else {
+            std::cerr << "Error: Unknown argument '" << arg << "'\n";
+            std::cerr << "Use --help for usage information\n";
+            return 1;
+        }
+    }
+    if (updateBaseline && baselineFile.empty()) {
+        std::cerr << "Error: --update-baseline needs --baseline\n";
+        return 1;
+    }
+
+    RegressionRunner runner(settings);
+    bool writeBaseline = !baselineFile.empty() && (updateBaseline || !std::filesystem::exists(baselineFile));
+    try {
+        if (!baselineFile.empty() && !writeBaseline) {
+            std::ifstream in(baselineFile);
+            if (!in) {
+                std::cerr << "Error: Could not read baseline " << baselineFile << "\n";
+                return 1;
+            }
+            runner.readBaseline(in);
+        }
+        runner.run(&std::cout);
+    } catch (const std::runtime_error& error) {
+        std::cerr << "Error: " << error.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "\n";
+    runner.printReport(std::cout);
+    if (writeBaseline) {
+        std::ofstream out(baselineFile);
+        runner.writeBaseline(out);
+        if (!out) {
+            std::cerr << "Error: Could not write baseline " << baselineFile << "\n";
+            return 1;
+        }
+        std::cout << "\nBaseline: written to " << baselineFile << "\n";
+    }
+
+    int mismatches = runner.getMismatchCount();
+    int slower = runner.getSlowerCount();
+    std::cout << "\n" << runner.getResults().size() << " cases, " << mismatches << " with mismatches, " << slower
+              << " slower than the baseline\n";
+    return (mismatches > 0 || slower > 0) ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file replay.cpp
+ * @brief Implementation file for the TraceReplay class
+ *
+ * See replay.hpp for class documentation.
+ */
+
+#include "replay.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+std::string formatFixedWidth(const std::string& text, int width) {
+    std::ostringstream oss;
+    oss << std::right << std::setw(width) << text;
+    return oss.str();
+}
+
+// Length of the overlap of [begin, end) with [from, to)
+double overlap(double begin, double end, double from, double to) {
+    return std::max(0.0, std::min(end, to) - std::max(begin, from));
+}
+
+} // namespace
+
+TraceReplay::TraceReplay(const MappedTrace& trace)
+    : trace(trace),
+      endTime(trace.getHeader().simHours) {
+    // Every vehicle has a record in the first step of the fixed step engines and in the
+    // departures (step 0) of the event engine
+    std::unordered_set<uint32_t> seen;
+    for (size_t i = 0; i < trace.size() && seen.size() < trace.getHeader().numVehicles; ++i) {
+        const TraceRecord& record = trace[i];
+        if (!record.isStep() && seen.insert(record.vehicleId).second) {
+            if (!VehicleTypeRegistry::instance().contains(record.getManufacturer())) {
+                knownTypes = false;
+                continue;
+            }
+            vehicleCounts[static_cast<size_t>(record.getManufacturer())]++;
+        }
+    }
+}
+
+template <typename Visitor>
+void TraceReplay::forEachRecord(const ReplayWindow& window, Visitor&& visitor) const {
+    // Records before the first step record belong to time 0. The event engine brings every
+    // vehicle up to the end in a final step at the end time, windows reaching the end include it.
+    const bool includesEnd = window.to >= endTime;
+    auto afterWindow = [&](double time) { return includesEnd ? time > window.to : time >= window.to; };
+
+    size_t index = (window.from <= 0.0) ? 0 : trace.findStep(window.from);
+    double time = 0.0;
+    for (; index < trace.size(); ++index) {
+        const TraceRecord& record = trace[index];
+        if (record.isStep()) {
+            time = record.asStep().time;
+            if (afterWindow(time)) {
+                break;
+            }
+        } else if (time >= window.from) {
+            visitor(record, time);
+        }
+    }
+}
+
+VehicleTypeStatsTable TraceReplay::typeStats(const ReplayWindow& window) const {
+    VehicleTypeStatsTable stats;
+    for (size_t type = 0; type < getNumVehicleTypes(); ++type) {
+        if (vehicleCounts[type] > 0) {
+            auto manufacturer = static_cast<Vehicle::Manufacturer>(type);
+            auto& typeData = stats[manufacturer];
+            typeData.manufacturer = manufacturer;
+            typeData.manufacturerName = getManufacturerName(manufacturer);
+            typeData.expectedFaultRate = getVehicleTypeSpec(manufacturer).faultProbability;
+            typeData.vehicleCount = vehicleCounts[type];
+        }
+    }
+
+    forEachRecord(window, [&stats](const TraceRecord& record, double) {
+        auto& typeData = stats[record.getManufacturer()];
+        typeData.totalFlights += record.flights;
+        typeData.totalCharges += record.getCharges();
+        typeData.totalFlightTime += record.flightTime;
+        typeData.totalDistance += record.distanceTraveled;
+        typeData.totalChargingTime += record.chargingTime;
+        typeData.totalQueuedTime += record.queuedTime;
+        typeData.totalFaults += record.getFaults();
+        typeData.totalPassengerMiles += record.passengerMiles;
+    });
+    return stats;
+}
+
+std::vector<UtilizationBucket> TraceReplay::utilization(const ReplayWindow& window, double bucketHours) const {
+    std::vector<UtilizationBucket> buckets;
+    const double from = std::max(window.from, 0.0);
+    const double to = std::min(window.to, endTime);
+    if (!(bucketHours > 0) || to <= from) {
+        return buckets;
+    }
+
+    size_t numBuckets = static_cast<size_t>(std::ceil((to - from) / bucketHours - 1e-9));
+    for (size_t i = 0; i < numBuckets; ++i) {
+        UtilizationBucket bucket;
+        bucket.start = from + i * bucketHours;
+        bucket.end = std::min(bucket.start + bucketHours, to);
+        buckets.push_back(bucket);
+    }
+
+    forEachRecord({from, to}, [&](const TraceRecord& record, double time) {
+        size_t type = static_cast<size_t>(record.getManufacturer());
+        if (type < getNumVehicleTypes()) {
+            size_t i = std::min(static_cast<size_t>((time - from) / bucketHours), numBuckets - 1);
+            buckets[i].utilization[type] += record.flightTime;
+        }
+    });
+
+    for (auto& bucket : buckets) {
+        for (size_t type = 0; type < getNumVehicleTypes(); ++type) {
+            double fleetHours = vehicleCounts[type] * (bucket.end - bucket.start);
+            bucket.utilization[type] = fleetHours > 0 ? bucket.utilization[type] / fleetHours : 0.0;
+        }
+    }
+    return buckets;
+}
+
+std::map<int, double> TraceReplay::queueLengthHistogram(const ReplayWindow& window) const {
+    // The states after a step's records hold from the start of that step to the next one.
+    // Vehicles only have records when they change in event traces, so the whole trace up to
+    // the end of the window is replayed to know the queue at the window start.
+    std::map<int, double> hours;
+    std::unordered_map<uint32_t, bool> queued;
+    int queueLength = 0;
+    double since = 0.0;
+
+    for (size_t index = 0; index < trace.size(); ++index) {
+        const TraceRecord& record = trace[index];
+        if (record.isStep()) {
+            double time = record.asStep().time;
+            hours[queueLength] += overlap(since, time, window.from, window.to);
+            since = time;
+            if (time >= window.to) {
+                break;
+            }
+            continue;
+        }
+
+        bool isQueued = record.getState() == Vehicle::State::Queued;
+        bool& wasQueued = queued[record.vehicleId];
+        queueLength += static_cast<int>(isQueued) - static_cast<int>(wasQueued);
+        wasQueued = isQueued;
+    }
+    hours[queueLength] += overlap(since, endTime, window.from, window.to);
+
+    // Lengths that were only passed through in zero-length steps are dropped
+    for (auto it = hours.begin(); it != hours.end();) {
+        it = (it->second > 0.0) ? std::next(it) : hours.erase(it);
+    }
+    return hours;
+}
+
+std::vector<FaultEvent> TraceReplay::faultTimeline(const ReplayWindow& window) const {
+    std::vector<FaultEvent> faults;
+    forEachRecord(window, [&faults](const TraceRecord& record, double time) {
+        for (int i = 0; i < record.getFaults(); ++i) {
+            faults.push_back({time, record.vehicleId, record.getManufacturer()});
+        }
+    });
+    return faults;
+}
+
+/* Print Helpers */
+void TraceReplay::printStatsTable(std::ostream& out, const ReplayWindow& window) const {
+    // Same columns as Simulation::printStatsTable
+    const int colWidth = 12;
+    const std::string separator(32 + 6*colWidth, '-');
+    out << "Results by vehicle type for [" << std::to_string(window.from) << ", "
+        << std::to_string(std::min(window.to, endTime)) << ") hours\n";
+    out << separator << '\n';
+    out << formatFixedWidth("Vehicle", colWidth) << " | " << formatFixedWidth("Count", colWidth) << " | "
+        << formatFixedWidth("Avg Flight", colWidth) << " | " << formatFixedWidth("Avg Dist", colWidth) << " | "
+        << formatFixedWidth("Avg Charge", colWidth) << " | " << formatFixedWidth("Faults", colWidth) << " | "
+        << formatFixedWidth("PAX Miles", colWidth) << " | \n";
+    out << formatFixedWidth("Type", colWidth) << " | " << formatFixedWidth("", colWidth) << " | "
+        << formatFixedWidth("Time (hrs)", colWidth) << " | " << formatFixedWidth("(miles)", colWidth) << " | "
+        << formatFixedWidth("Time (hrs)", colWidth) << " | " << formatFixedWidth("", colWidth) << " | "
+        << formatFixedWidth("(miles)", colWidth) << " | \n";
+    out << separator << '\n';
+
+    for (const auto& pair : typeStats(window)) {
+        const auto& stats = pair.second;
+        out << formatFixedWidth(stats.manufacturerName, colWidth) << " | "
+            << formatFixedWidth(std::to_string(stats.vehicleCount), colWidth) << " | "
+            << formatFixedWidth(std::to_string(stats.avgFlightTimePerFlight()), colWidth) << " | "
+            << formatFixedWidth(std::to_string(stats.avgDistancePerFlight()), colWidth) << " | "
+            << formatFixedWidth(std::to_string(stats.avgChargingTimePerSession()), colWidth) << " | "
+            << formatFixedWidth(std::to_string(stats.totalFaults), colWidth) << " | "
+            << formatFixedWidth(std::to_string(stats.totalPassengerMiles), colWidth) << " | \n";
+    }
+    out << separator << '\n';
+}
+
+void TraceReplay::printUtilization(std::ostream& out, const ReplayWindow& window, double bucketHours) const {
+    const int colWidth = 12;
+    out << "Utilization (share of fleet time flying) per vehicle type\n";
+    out << formatFixedWidth("Start (hrs)", colWidth) << " | " << formatFixedWidth("End (hrs)", colWidth);
+    for (size_t type = 0; type < getNumVehicleTypes(); ++type) {
+        if (vehicleCounts[type] > 0) {
+            out << " | " << formatFixedWidth(getManufacturerName(static_cast<Vehicle::Manufacturer>(type)), colWidth);
+        }
+    }
+    out << '\n';
+
+    for (const auto& bucket : utilization(window, bucketHours)) {
+        out << formatFixedWidth(std::to_string(bucket.start), colWidth) << " | "
+            << formatFixedWidth(std::to_string(bucket.end), colWidth);
+        for (size_t type = 0; type < getNumVehicleTypes(); ++type) {
+            if (vehicleCounts[type] > 0) {
+                out << " | " << formatFixedWidth(std::to_string(bucket.utilization[type]), colWidth);
+            }
+        }
+        out << '\n';
+    }
+}
+
+void TraceReplay::printQueueHistogram(std::ostream& out, const ReplayWindow& window) const {
+    const int colWidth = 12;
+    const auto hours = queueLengthHistogram(window);
+    double total = 0.0;
+    for (const auto& pair : hours) {
+        total += pair.second;
+    }
+
+    out << "Charging queue length distribution\n";
+    out << formatFixedWidth("Queue Length", colWidth) << " | " << formatFixedWidth("Hours", colWidth) << " | "
+        << formatFixedWidth("Share", colWidth) << '\n';
+    for (const auto& pair : hours) {
+        out << formatFixedWidth(std::to_string(pair.first), colWidth) << " | "
+            << formatFixedWidth(std::to_string(pair.second), colWidth) << " | "
+            << formatFixedWidth(std::to_string(total > 0 ? pair.second / total : 0.0), colWidth) << '\n';
+    }
+}
+
+void TraceReplay::printFaultTimeline(std::ostream& out, const ReplayWindow& window) const {
+    const int colWidth = 12;
+    const auto faults = faultTimeline(window);
+    out << "Fault timeline (" << faults.size() << " faults)\n";
+    out << formatFixedWidth("Time (hrs)", colWidth) << " | " << formatFixedWidth("Vehicle", colWidth) << " | "
+        << formatFixedWidth("Type", colWidth) << '\n';
+    for (const auto& fault : faults) {
+        out << formatFixedWidth(std::to_string(fault.time), colWidth) << " | "
+            << formatFixedWidth(std::to_string(fault.vehicleId), colWidth) << " | "
+            << formatFixedWidth(getManufacturerName(fault.manufacturer), colWidth) << '\n';
+    }
+}
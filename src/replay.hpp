@@ -0,0 +1,100 @@
+/**
+ * @file replay.hpp
+ * @brief Header file for the TraceReplay class
+ *
+ * TraceReplay answers questions about a finished run from its memory-mapped binary trace
+ * instead of re-running the simulation: the results table of the report, fleet utilization
+ * over time, the charging queue length distribution and the fault timeline, each one
+ * restricted to an arbitrary window of simulation time.
+ *
+ * A record belongs to the step it follows, a window [from, to) holds the steps that start
+ * inside it (a window reaching the end of the run also holds the event engine's final step
+ * at the end time). Queries stream through the mapping, only the records of the window are read
+ * except for the queue histogram, which needs every vehicle's state at the window start.
+ */
+
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <array>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "simulation.hpp"
+#include "trace.hpp"
+
+/**
+ * @brief Simulation time window [from, to) in hours.
+ */
+struct ReplayWindow {
+    double from = 0.0;
+    double to = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Share of fleet time spent flying per vehicle type during one bucket.
+ */
+struct UtilizationBucket {
+    double start; // [hours]
+    double end;   // [hours]
+    std::array<double, MAX_VEHICLE_TYPES> utilization{}; // Flight hours / (vehicles * bucket hours)
+};
+
+struct FaultEvent {
+    double time; // Start of the step in which the fault happened [hours]
+    uint32_t vehicleId;
+    Vehicle::Manufacturer manufacturer;
+};
+
+class TraceReplay {
+public:
+    explicit TraceReplay(const MappedTrace& trace);
+
+    /**
+     * @brief Number of vehicles of each type, taken from the records of the first steps.
+     */
+    const std::array<int, MAX_VEHICLE_TYPES>& getVehicleCounts() const { return vehicleCounts; }
+
+    /**
+     * @brief False if a vehicle of the trace has a type missing from the VehicleTypeRegistry,
+     *        e.g. the trace was written with a vehicle type file that is not loaded.
+     */
+    bool hasKnownTypes() const { return knownTypes; }
+
+    /**
+     * @brief Statistics per vehicle type for the window, as in Simulation::printStatsTable.
+     */
+    VehicleTypeStatsTable typeStats(const ReplayWindow& window) const;
+
+    /**
+     * @brief Utilization per vehicle type in consecutive buckets of the window.
+     */
+    std::vector<UtilizationBucket> utilization(const ReplayWindow& window, double bucketHours) const;
+
+    /**
+     * @brief Hours spent at each charging queue length (number of Queued vehicles) in the window.
+     */
+    std::map<int, double> queueLengthHistogram(const ReplayWindow& window) const;
+
+    std::vector<FaultEvent> faultTimeline(const ReplayWindow& window) const;
+
+    // Text output of the queries
+    void printStatsTable(std::ostream& out, const ReplayWindow& window) const;
+    void printUtilization(std::ostream& out, const ReplayWindow& window, double bucketHours) const;
+    void printQueueHistogram(std::ostream& out, const ReplayWindow& window) const;
+    void printFaultTimeline(std::ostream& out, const ReplayWindow& window) const;
+
+private:
+    const MappedTrace& trace;
+    std::array<int, MAX_VEHICLE_TYPES> vehicleCounts{};
+    bool knownTypes = true;
+    double endTime; // Simulation length [hours]
+
+    // Visit every vehicle record of the steps starting in the window with its step time
+    template <typename Visitor>
+    void forEachRecord(const ReplayWindow& window, Visitor&& visitor) const;
+};
+
+#endif
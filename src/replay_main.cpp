@@ -0,0 +1,142 @@
+#include "replay.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " <trace file> [options]\n";
+    std::cout << "\nAnswers queries on a binary trace written with --trace-format=binary without\n";
+    std::cout << "re-running the simulation. The trace is memory-mapped, not loaded into memory.\n";
+    std::cout << "\nOptions:\n";
+    std::cout << "  --from <hours>           Start of the time window (default: 0)\n";
+    std::cout << "  --to <hours>             End of the time window (default: end of the run)\n";
+    std::cout << "  --stats                  Results table by vehicle type for the window (default query)\n";
+    std::cout << "  --utilization <hours>    Share of fleet time flying per vehicle type, in buckets\n";
+    std::cout << "  --queue                  Hours spent at each charging queue length\n";
+    std::cout << "  --faults                 Time, vehicle and type of every fault\n";
+    std::cout << "  --vehicle-types <file>   Vehicle type file the trace was written with\n";
+    std::cout << "  --help                   Show this help message\n";
+    std::cout << "\nLong options also accept the form --option=value.\n";
+    std::cout << "\nExamples:\n";
+    std::cout << "  " << programName << " trace.evtrace --from=1 --to=2     # Results of the second hour\n";
+    std::cout << "  " << programName << " trace.evtrace --utilization=0.25 --queue --faults\n";
+}
+
+bool parseHours(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return *text != '\0' && *end == '\0' && value >= 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        if (arg.rfind("--", 0) == 0 && equals != std::string::npos) {
+            args.push_back(arg.substr(0, equals));
+            args.push_back(arg.substr(equals + 1));
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    std::string traceFile;
+    ReplayWindow window;
+    bool stats = false;
+    bool queue = false;
+    bool faults = false;
+    double bucketHours = 0.0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if ((arg == "--from" || arg == "--to") && hasValue) {
+            double hours;
+            if (!parseHours(args[++i].c_str(), hours)) {
+                std::cerr << "Error: Window bounds must be non-negative hours\n";
+                return 1;
+            }
+            (arg == "--from" ? window.from : window.to) = hours;
+        }
+        else if (arg == "--utilization" && hasValue) {
+            if (!parseHours(args[++i].c_str(), bucketHours) || bucketHours <= 0) {
+                std::cerr << "Error: Utilization bucket must be positive hours\n";
+                return 1;
+            }
+        }
+        else if (arg == "--vehicle-types" && hasValue) {
+            try {
+                VehicleTypeRegistry::instance().loadFile(args[++i]);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "Error: " << error.what() << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--stats") {
+            stats = true;
+        }
+        else if (arg == "--queue") {
+            queue = true;
+        }
+        else if (arg == "--faults") {
+            faults = true;
+        }
+        else if (traceFile.empty() && arg.rfind("-", 0) != 0) {
+            traceFile = arg;
+        }
+        else {
+            std::cerr << "Error: Unknown argument '" << arg << "'\n";
+            std::cerr << "Use --help for usage information\n";
+            return 1;
+        }
+    }
+
+    if (traceFile.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (window.to <= window.from) {
+        std::cerr << "Error: The window end must be after its start\n";
+        return 1;
+    }
+
+    MappedTrace trace;
+    if (!trace.open(traceFile)) {
+        std::cerr << "Error: " << traceFile << " is not a version " << TRACE_VERSION << " eVTOL trace\n";
+        return 1;
+    }
+    TraceReplay replay(trace);
+    if (!replay.hasKnownTypes()) {
+        std::cerr << "Error: " << traceFile << " has vehicle types that are not defined, pass its --vehicle-types file\n";
+        return 1;
+    }
+
+    const TraceFileHeader& header = trace.getHeader();
+    std::cout << "Trace: " << header.numVehicles << " vehicles, " << header.numChargers << " chargers, "
+              << std::to_string(header.simHours) << " hours, seed " << header.seed << "\n\n";
+
+    if (stats || (bucketHours <= 0 && !queue && !faults)) {
+        replay.printStatsTable(std::cout, window);
+        std::cout << '\n';
+    }
+    if (bucketHours > 0) {
+        replay.printUtilization(std::cout, window, bucketHours);
+        std::cout << '\n';
+    }
+    if (queue) {
+        replay.printQueueHistogram(std::cout, window);
+        std::cout << '\n';
+    }
+    if (faults) {
+        replay.printFaultTimeline(std::cout, window);
+    }
+    return 0;
+}
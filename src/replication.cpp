@@ -0,0 +1,186 @@
+/**
+ * @file replication.cpp
+ * @brief Implementation file for the ReplicationRunner class
+ *
+ * See replication.hpp for class documentation.
+ */
+
+#include "replication.hpp"
+#include "counter_rng.hpp"
+#include <cmath>
+
+namespace {
+const uint64_t REPLICATION_SEED_STREAM = 0x5245504CULL; // Keeps replication seeds apart from simulation streams
+}
+
+/* Statistics */
+double studentT95(int degreesOfFreedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    const int tableSize = static_cast<int>(sizeof(table) / sizeof(table[0]));
+
+    if (degreesOfFreedom <= 0) {
+        return 0.0;
+    }
+    if (degreesOfFreedom <= tableSize) {
+        return table[degreesOfFreedom - 1];
+    }
+    // Cornish-Fisher expansion around the normal quantile to second order, within 1e-4 above 30
+    const double z = 1.959964;
+    const double z3 = z * z * z;
+    const double z5 = z3 * z * z;
+    const double nu = degreesOfFreedom;
+    return z + (z3 + z) / (4.0 * nu) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * nu * nu);
+}
+
+MetricSummary MetricSummary::fromSamples(const std::vector<double>& values) {
+    MetricSummary summary;
+    summary.samples = static_cast<int>(values.size());
+    if (values.empty()) {
+        return summary;
+    }
+
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    summary.mean = sum / values.size();
+
+    if (values.size() > 1) {
+        double squares = 0.0;
+        for (double value : values) {
+            squares += (value - summary.mean) * (value - summary.mean);
+        }
+        summary.stddev = std::sqrt(squares / (values.size() - 1));
+        summary.ciHalfWidth = studentT95(summary.samples - 1) * summary.stddev / std::sqrt(static_cast<double>(values.size()));
+    }
+    return summary;
+}
+
+/* Metrics */
+const std::vector<ReplicationMetric>& ReplicationRunner::metrics() {
+    // Columns of printStatsTable followed by the remaining columns of printFaultStatsTable
+    static const std::vector<ReplicationMetric> list = {
+        {"Count",                [](const VehicleTypeStats& s) { return static_cast<double>(s.vehicleCount); }},
+        {"Avg Flight (hrs)",     [](const VehicleTypeStats& s) { return s.avgFlightTimePerFlight(); }},
+        {"Avg Dist (miles)",     [](const VehicleTypeStats& s) { return s.avgDistancePerFlight(); }},
+        {"Avg Charge (hrs)",     [](const VehicleTypeStats& s) { return s.avgChargingTimePerSession(); }},
+        {"Faults",               [](const VehicleTypeStats& s) { return static_cast<double>(s.totalFaults); }},
+        {"PAX Miles",            [](const VehicleTypeStats& s) { return s.totalPassengerMiles; }},
+        {"Flight Hours",         [](const VehicleTypeStats& s) { return s.totalFlightTime; }},
+        {"Fault Prb Per Hour",   [](const VehicleTypeStats& s) { return s.expectedFaultRate; }},
+        {"Actual Fault Rate",    [](const VehicleTypeStats& s) { return s.getActualFaultRate(); }},
+    };
+    return list;
+}
+
+/* Runner */
+ReplicationRunner::ReplicationRunner(const ReplicationSettings& settings)
+    : settings(settings) {
+}
+
+uint64_t ReplicationRunner::getReplicationSeed(int replication) const {
+    return CounterRandomGenerator::at(settings.seed, REPLICATION_SEED_STREAM, static_cast<uint64_t>(replication));
+}
+
+void ReplicationRunner::run() {
+    // Every replication is a single-threaded run, only the seed differs
+    std::vector<RunConfig> configs(settings.replications);
+    for (size_t i = 0; i < configs.size(); ++i) {
+        RunConfig& config = configs[i];
+        config.numVehicles = settings.numVehicles;
+        config.simHours = settings.simHours;
+        config.numChargers = settings.numChargers;
+        config.vertiports = settings.vertiports;
+        config.dispatchPolicy = settings.dispatchPolicy;
+        config.simTimeStepSeconds = settings.simTimeStepSeconds;
+        config.randomizeVehicles = settings.randomizeVehicles;
+        config.fleetComposition = settings.fleetComposition;
+        config.engine = settings.engine;
+        config.faultModel = settings.faultModel;
+        config.seed = getReplicationSeed(static_cast<int>(i));
+    }
+    results = batchRunner ? batchRunner(configs) : simulateBatch(configs, settings.threads);
+}
+
+std::map<Vehicle::Manufacturer, std::vector<MetricSummary>> ReplicationRunner::summarize() const {
+    const auto& list = metrics();
+
+    // Samples per vehicle type and metric, in replication order
+    std::map<Vehicle::Manufacturer, std::vector<std::vector<double>>> samples;
+    for (const auto& replication : results) {
+        for (const auto& pair : replication) {
+            auto& columns = samples[pair.first];
+            columns.resize(list.size());
+            for (size_t m = 0; m < list.size(); ++m) {
+                columns[m].push_back(list[m].value(pair.second));
+            }
+        }
+    }
+
+    std::map<Vehicle::Manufacturer, std::vector<MetricSummary>> summaries;
+    for (const auto& pair : samples) {
+        for (const auto& column : pair.second) {
+            summaries[pair.first].push_back(MetricSummary::fromSamples(column));
+        }
+    }
+    return summaries;
+}
+
+VehicleTypeStatsTable ReplicationRunner::pool() const {
+    VehicleTypeStatsTable pooled;
+    for (const auto& table : results) {
+        for (const auto& pair : table) {
+            VehicleTypeStats& stats = pooled[pair.first];
+            stats.manufacturer = pair.first;
+            stats.manufacturerName = pair.second.manufacturerName;
+            stats.expectedFaultRate = pair.second.expectedFaultRate;
+            stats.vehicleCount += pair.second.vehicleCount;
+            stats.add(pair.second);
+        }
+    }
+    return pooled;
+}
+
+void ReplicationRunner::printReport(Logger& logger) const {
+    const auto& list = metrics();
+    const auto summaries = summarize();
+
+    logger.logLine();
+    logger.logSectionDivider("Replication Results by Vehicle Type", true);
+    logger.logLine("Replications: " + std::to_string(results.size()) + ", base seed: " + std::to_string(settings.seed));
+
+    // Table header
+    const int colWidth = 12;
+    const int colWidthLarger = 20;
+    std::string separator(colWidth + colWidthLarger + 6 + 4*(colWidth + 3), '-');
+    logger.logLine();
+    logger.logLine(separator);
+    logger.log(logger.formatFixedWidth("Vehicle", colWidth) + " | ");
+    logger.log(logger.formatFixedWidth("Metric", colWidthLarger, false) + " | ", false);
+    logger.log(logger.formatFixedWidth("Mean", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("Std Dev", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("95% CI Low", colWidth) + " | ", false);
+    logger.logLine(logger.formatFixedWidth("95% CI High", colWidth) + " | ", false);
+    logger.logLine(separator);
+
+    for (const auto& pair : summaries) {
+        const std::string name = getManufacturerName(pair.first);
+        for (size_t m = 0; m < list.size(); ++m) {
+            const MetricSummary& summary = pair.second[m];
+            logger.log(logger.formatFixedWidth(m == 0 ? name : "", colWidth) + " | ");
+            logger.log(logger.formatFixedWidth(list[m].name, colWidthLarger, false) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(summary.mean), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(summary.stddev), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(summary.mean - summary.ciHalfWidth), colWidth) + " | ", false);
+            logger.logLine(logger.formatFixedWidth(std::to_string(summary.mean + summary.ciHalfWidth), colWidth) + " | ", false);
+        }
+        logger.logLine(separator);
+    }
+
+    // Percentiles over the sessions of every replication
+    logSessionTable(logger, pool());
+}
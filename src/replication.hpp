@@ -0,0 +1,123 @@
+/**
+ * @file replication.hpp
+ * @brief Header file for the ReplicationRunner class
+ *
+ * ReplicationRunner runs the same simulation configuration many times with independent
+ * seeds (Monte Carlo replications) and summarizes every column of the results tables with
+ * its mean, standard deviation and 95% confidence interval. Replications run in parallel
+ * on a ThreadPool, each one on a single thread and without any log output.
+ */
+
+#ifndef REPLICATION_HPP
+#define REPLICATION_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "run.hpp"
+#include "simulation.hpp"
+
+const int DEFAULT_REPLICATIONS = 1; // Default number of replications (1 = single run with a full report)
+
+/**
+ * @brief Configuration shared read-only by all replications.
+ */
+struct ReplicationSettings {
+    int numVehicles = DEFAULT_NUM_VEHICLES;
+    double simHours = DEFAULT_HRS_SIM;
+    int numChargers = DEFAULT_CHARGERS;
+    int vertiports = DEFAULT_VERTIPORTS;
+    DispatchPolicy dispatchPolicy = DEFAULT_DISPATCH_POLICY;
+    double simTimeStepSeconds = DEFAULT_TIME_STEP_SECONDS;
+    bool randomizeVehicles = true;
+    std::vector<int> fleetComposition; // Same fleet in every replication, see Simulation::setFleetComposition
+    SimulationEngine engine = DEFAULT_ENGINE;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+    int replications = DEFAULT_REPLICATIONS;
+    int threads = DEFAULT_THREADS; // Replications run concurrently
+    uint64_t seed = 0;             // Base seed, replication seeds are derived from it
+};
+
+/**
+ * @brief Mean, sample standard deviation and 95% confidence interval of one metric.
+ */
+struct MetricSummary {
+    int samples = 0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double ciHalfWidth = 0.0; // Student t interval, mean +/- ciHalfWidth
+
+    static MetricSummary fromSamples(const std::vector<double>& values);
+};
+
+/**
+ * @brief A column of printStatsTable or printFaultStatsTable.
+ */
+struct ReplicationMetric {
+    std::string name;
+    double (*value)(const VehicleTypeStats& stats);
+};
+
+class ReplicationRunner {
+public:
+    explicit ReplicationRunner(const ReplicationSettings& settings);
+
+    /**
+     * @brief Run all replications, replication i always uses getReplicationSeed(i).
+     */
+    void run();
+
+    /**
+     * @brief Run the replications with another BatchRunner, e.g. on remote workers.
+     *
+     * The default runs them on settings.threads local threads.
+     */
+    void setBatchRunner(BatchRunner runner) { batchRunner = std::move(runner); }
+
+    /**
+     * @brief Seed of replication i, a hash of the base seed and i.
+     */
+    uint64_t getReplicationSeed(int replication) const;
+
+    const ReplicationSettings& getSettings() const { return settings; }
+
+    // Per replication statistics by vehicle type, in replication order
+    const std::vector<VehicleTypeStatsTable>& getResults() const { return results; }
+
+    /**
+     * @brief Summaries of every metric for every vehicle type.
+     *
+     * A vehicle type only contributes samples from the replications it appeared in.
+     */
+    std::map<Vehicle::Manufacturer, std::vector<MetricSummary>> summarize() const;
+
+    /**
+     * @brief Statistics of all replications merged into one table, in replication order.
+     *
+     * Totals are summed and the session distributions pooled, so its percentiles are those
+     * of every session of every replication. Vehicle counts are summed as well.
+     */
+    VehicleTypeStatsTable pool() const;
+
+    /**
+     * @brief Log the replication summary table.
+     */
+    void printReport(Logger& logger) const;
+
+    static const std::vector<ReplicationMetric>& metrics();
+
+private:
+    ReplicationSettings settings;
+    BatchRunner batchRunner;
+    std::vector<VehicleTypeStatsTable> results;
+};
+
+/**
+ * @brief Two-sided 95% quantile of Student's t distribution.
+ */
+double studentT95(int degreesOfFreedom);
+
+#endif
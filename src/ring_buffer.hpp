@@ -0,0 +1,88 @@
+/**
+ * @file ring_buffer.hpp
+ * @brief Header file for the SpscRingBuffer class
+ *
+ * Lock-free single-producer/single-consumer ring buffer of preallocated slots.
+ * The producer fills a slot in place (beginWrite/endWrite) and the consumer
+ * reads it in place (beginRead/endRead), so no allocation or copy of the
+ * element type is needed after construction.
+ */
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscRingBuffer {
+public:
+    /**
+     * @param capacity Number of slots, rounded up to a power of two.
+     */
+    explicit SpscRingBuffer(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    size_t capacity() const { return slots.size(); }
+
+    /* Producer side */
+
+    // Returns the next free slot, or nullptr if the buffer is full
+    T* beginWrite() {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - cachedTail >= slots.size()) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (currentHead - cachedTail >= slots.size()) {
+                return nullptr;
+            }
+        }
+        return &slots[currentHead & mask];
+    }
+
+    // Publishes the slot returned by beginWrite() to the consumer
+    void endWrite() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /* Consumer side */
+
+    // Returns the oldest published slot, or nullptr if the buffer is empty
+    T* beginRead() {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (currentTail == cachedHead) {
+                return nullptr;
+            }
+        }
+        return &slots[currentTail & mask];
+    }
+
+    // Releases the slot returned by beginRead() back to the producer
+    void endRead() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask = 0;
+
+    // Producer and consumer indices live on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> head{0}; // next slot to write (producer)
+    size_t cachedTail = 0;                   // producer's last view of tail
+    alignas(64) std::atomic<size_t> tail{0}; // next slot to read (consumer)
+    size_t cachedHead = 0;                   // consumer's last view of head
+};
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file run.cpp
+ * @brief Implementation file for the in-process run API
+ *
+ * See run.hpp for documentation.
+ */
+
+#include "run.hpp"
+#include "thread_pool.hpp"
+
+RunResults simulate(const RunConfig& config) {
+    Simulation sim(config.numVehicles, config.simHours, config.numChargers, config.simTimeStepSeconds,
+                   config.logVerbosity, config.randomizeVehicles, false);
+    sim.setEngine(config.engine);
+    sim.setThreads(config.threads);
+    sim.setVertiports(config.vertiports);
+    sim.setDispatchPolicy(config.dispatchPolicy);
+    sim.setFaultModel(config.faultModel);
+    sim.setSeed(config.seed);
+    if (!config.fleetComposition.empty()) {
+        sim.setFleetComposition(config.fleetComposition);
+    }
+    if (config.logSink) {
+        sim.getLogger().setSink(config.logSink);
+        sim.getLogger().setLogMode(Logger::LogMode::SINK);
+    }
+    sim.runSimulation();
+
+    RunResults results;
+    results.typeStats = sim.getTypeStats();
+    results.chargerUtilization = sim.getChargerUtilization();
+    results.simulatedHours = sim.getCurrentTime();
+    results.steps = sim.getStepCount();
+
+    // The queued time of all vehicles is the integral of the queue length over the run
+    double queuedTime = 0.0;
+    double chargingTime = 0.0;
+    int charges = 0;
+    for (const auto& pair : results.typeStats) {
+        queuedTime += pair.second.totalQueuedTime;
+        chargingTime += pair.second.totalChargingTime;
+        charges += pair.second.totalCharges;
+    }
+    QueueMetrics& queue = results.queue;
+    if (results.simulatedHours > 0) {
+        queue.averageQueueLength = queuedTime / results.simulatedHours;
+        if (config.numChargers > 0) {
+            queue.chargerUtilization = chargingTime / (config.numChargers * results.simulatedHours);
+        }
+    }
+    queue.averageWaitTime = charges > 0 ? queuedTime / charges : 0.0;
+    queue.maxQueueLength = sim.getMaxQueueLength();
+    queue.queuedAtEnd = sim.getQueueLength();
+    return results;
+}
+
+std::vector<VehicleTypeStatsTable> simulateBatch(const std::vector<RunConfig>& configs, int threads) {
+    // Each run owns its simulation, results are written to the run's own slot
+    std::vector<VehicleTypeStatsTable> results(configs.size());
+    ThreadPool pool(threads);
+    pool.parallelFor(configs.size(), [&configs, &results](size_t i) {
+        results[i] = simulate(configs[i]).typeStats;
+    });
+    return results;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file run.hpp
+ * @brief Header file for the in-process run API of the evtol_core library
+ *
+ * simulate() runs one simulation from a RunConfig and returns its RunResults. A run has
+ * no side effects outside the call: it creates no files or directories and writes nothing
+ * to stdout, its log lines only go to the config's sink. Each call owns its simulation and
+ * shares no mutable state with other calls, vehicle ids included (they follow the vehicle
+ * index), so services may call simulate() from many threads at once and get the same
+ * results as from one thread. The vehicle type registry (see vehicle_registry.hpp) must be
+ * filled before the first call and not changed afterwards.
+ */
+
+#ifndef RUN_HPP
+#define RUN_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "logger.hpp"
+#include "simulation.hpp"
+
+/**
+ * @brief Inputs of one run.
+ */
+struct RunConfig {
+    int numVehicles = DEFAULT_NUM_VEHICLES;
+    double simHours = DEFAULT_HRS_SIM;
+    int numChargers = DEFAULT_CHARGERS;
+    int vertiports = DEFAULT_VERTIPORTS; // Sites the chargers are spread over
+    DispatchPolicy dispatchPolicy = DEFAULT_DISPATCH_POLICY;
+    double simTimeStepSeconds = DEFAULT_TIME_STEP_SECONDS;
+    bool randomizeVehicles = true;
+    std::vector<int> fleetComposition; // Vehicles per type id, see Simulation::setFleetComposition
+    SimulationEngine engine = DEFAULT_ENGINE;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+    int threads = DEFAULT_THREADS; // Threads updating the vehicles of this run
+    uint64_t seed = 0;             // Runs with the same config and seed are identical
+
+    // Log destination, no log output without one. Called on the calling thread.
+    Logger::Sink logSink;
+    int logVerbosity = DEFAULT_VERBOSITY;
+};
+
+/**
+ * @brief Charging queue and charger figures of one run.
+ */
+struct QueueMetrics {
+    double averageQueueLength = 0.0; // Time average of the vehicles waiting for a charger
+    size_t maxQueueLength = 0;       // Longest charging queue
+    double averageWaitTime = 0.0;    // Hours queued per completed charging session
+    double chargerUtilization = 0.0; // Share of the charger hours spent charging
+    size_t queuedAtEnd = 0;          // Vehicles still waiting when the run ended
+};
+
+/**
+ * @brief Outputs of one run.
+ */
+struct RunResults {
+    VehicleTypeStatsTable typeStats; // Statistics per vehicle type, as in the report table
+    FixedIntervalSeries chargerUtilization; // Charger hours per minute, see Simulation::getChargerUtilization
+    QueueMetrics queue;
+    double simulatedHours = 0.0;
+    int steps = 0; // Time steps, or events for the event engine
+};
+
+/**
+ * @brief Run one simulation without any file or console output.
+ */
+RunResults simulate(const RunConfig& config);
+
+/**
+ * @brief Runs a batch of configurations and returns the statistics of each, in batch order.
+ *
+ * Replications and sweeps hand their runs to a BatchRunner, simulateBatch() on local
+ * threads by default or a WorkCoordinator (work_queue.hpp) for workers on other nodes.
+ */
+using BatchRunner = std::function<std::vector<VehicleTypeStatsTable>(const std::vector<RunConfig>& configs)>;
+
+/**
+ * @brief Run the configurations concurrently on a ThreadPool of the given size.
+ */
+std::vector<VehicleTypeStatsTable> simulateBatch(const std::vector<RunConfig>& configs, int threads);
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file scenario.cpp
+ * @brief Implementation file for the Scenario structure
+ *
+ * See scenario.hpp for the file format.
+ */
+
+#include "scenario.hpp"
+#include "vehicle_registry.hpp"
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+/* Numbers */
+bool parseInt(const std::string& text, int& value) {
+    if (text.empty() || std::isspace(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    if (text.empty() || std::isspace(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    double parsed = std::strtod(text.c_str(), &end);
+    if (*end != '\0' || !std::isfinite(parsed)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool parseUint64(const std::string& text, uint64_t& value) {
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE) {
+        return false;
+    }
+    value = static_cast<uint64_t>(parsed);
+    return true;
+}
+
+/* Scenario */
+Scenario Scenario::load(std::istream& in, const std::string& source) {
+    Scenario scenario;
+    std::set<std::string> seen;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) {
+            continue; // Blank line
+        }
+        std::vector<std::string> values;
+        for (std::string value; fields >> value;) {
+            values.push_back(value);
+        }
+
+        auto fail = [&](const std::string& message) {
+            return std::runtime_error(source + ":" + std::to_string(lineNumber) + ": " + message);
+        };
+        if (!seen.insert(key).second) {
+            throw fail(key + " is given more than once");
+        }
+        if (values.empty() || (key != "fleet" && values.size() > 1)) {
+            throw fail("expected " + std::string(key == "fleet" ? "<key> <values>" : "<key> <value>"));
+        }
+        const std::string& value = values[0];
+
+        auto positiveInt = [&](std::optional<int>& setting) {
+            int parsed = 0;
+            if (!parseInt(value, parsed) || parsed <= 0) {
+                throw fail(key + " must be a positive integer");
+            }
+            setting = parsed;
+        };
+        auto positiveDouble = [&](std::optional<double>& setting) {
+            double parsed = 0.0;
+            if (!parseDouble(value, parsed) || parsed <= 0) {
+                throw fail(key + " must be a positive number");
+            }
+            setting = parsed;
+        };
+
+        if (key == "vehicles") {
+            positiveInt(scenario.numVehicles);
+        } else if (key == "hours") {
+            positiveDouble(scenario.simHours);
+        } else if (key == "chargers") {
+            positiveInt(scenario.numChargers);
+        } else if (key == "vertiports") {
+            positiveInt(scenario.vertiports);
+        } else if (key == "timestep") {
+            positiveDouble(scenario.simTimeStepSeconds);
+        } else if (key == "threads") {
+            positiveInt(scenario.threads);
+        } else if (key == "replications") {
+            positiveInt(scenario.replications);
+        } else if (key == "dispatch") {
+            DispatchPolicy policy;
+            if (!dispatchPolicyFromString(value, policy)) {
+                throw fail("dispatch must be one of [fifo, sjf, passengers, fair]");
+            }
+            scenario.dispatchPolicy = policy;
+        } else if (key == "engine") {
+            SimulationEngine engine;
+            if (!engineFromString(value, engine)) {
+                throw fail("engine must be one of [fixed, event, soa, adaptive]");
+            }
+            scenario.engine = engine;
+        } else if (key == "fault-model") {
+            Vehicle::FaultModel model;
+            if (!faultModelFromString(value, model)) {
+                throw fail("fault-model must be one of [step, exponential]");
+            }
+            scenario.faultModel = model;
+        } else if (key == "seed") {
+            uint64_t seed = 0;
+            if (!parseUint64(value, seed)) {
+                throw fail("seed must be a non-negative integer");
+            }
+            scenario.seed = seed;
+        } else if (key == "fleet") {
+            if (values.size() == 1 && (value == "random" || value == "equal")) {
+                scenario.randomizeVehicles = (value == "random");
+                continue;
+            }
+            if (values.size() % 2 != 0) {
+                throw fail("expected fleet random, equal or <type> <count> pairs");
+            }
+            std::vector<int> counts(getNumVehicleTypes(), 0);
+            int total = 0;
+            for (size_t i = 0; i < values.size(); i += 2) {
+                Vehicle::Manufacturer type;
+                if (!VehicleTypeRegistry::instance().find(values[i], type)) {
+                    throw fail("unknown vehicle type " + values[i]);
+                }
+                int count = 0;
+                if (!parseInt(values[i + 1], count) || count < 0 || count > INT_MAX - total) {
+                    throw fail("vehicle count of " + values[i] + " must be a non-negative integer");
+                }
+                counts[static_cast<size_t>(type)] += count;
+                total += count;
+            }
+            if (total == 0) {
+                throw fail("fleet has no vehicles");
+            }
+            while (counts.back() == 0) {
+                counts.pop_back(); // Same composition whatever the number of registered types
+            }
+            scenario.fleetComposition = std::move(counts);
+        } else {
+            throw fail("unknown key " + key);
+        }
+    }
+
+    if (!scenario.fleetComposition.empty()) {
+        int total = 0;
+        for (int count : scenario.fleetComposition) {
+            total += count;
+        }
+        if (scenario.numVehicles && *scenario.numVehicles != total) {
+            throw std::runtime_error(source + ": fleet has " + std::to_string(total) + " vehicles, vehicles is " +
+                                     std::to_string(*scenario.numVehicles));
+        }
+        scenario.numVehicles = total;
+    }
+    return scenario;
+}
+
+Scenario Scenario::loadFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open scenario file " + filename);
+    }
+    return load(file, filename);
+}
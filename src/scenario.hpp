@@ -0,0 +1,75 @@
+/**
+ * @file scenario.hpp
+ * @brief Header file for the Scenario structure
+ *
+ * A scenario file holds the settings of a run, replications or sweep instead of command
+ * line options, one setting per line, the key followed by its value:
+ *
+ *     # Morning peak at two vertiports
+ *     hours        6
+ *     chargers     8
+ *     vertiports   2
+ *     dispatch     fair
+ *     replications 50
+ *     seed         42
+ *     fleet        Alpha 40 Bravo 60 Charlie 100
+ *
+ * Keys are the long command line options: vehicles, hours, chargers, vertiports, dispatch,
+ * timestep, engine, fault-model, threads, replications and seed. A fleet line is either
+ * "random" (the default), "equal" (-e) or a fleet composition: vehicle type names, built-in
+ * or registered (see vehicle_registry.hpp), each followed by its number of vehicles. A
+ * composition also sets the number of vehicles.
+ *
+ * Blank lines and text after '#' are ignored, a key may only be given once. A file is parsed
+ * once into a Scenario, the settings it does not mention are left unset.
+ */
+
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "simulation.hpp"
+#include "vertiport.hpp"
+
+/**
+ * @brief Parse a whole string as a number.
+ * @return False for empty text, trailing characters, values out of range and non-finite values.
+ */
+bool parseInt(const std::string& text, int& value);
+bool parseDouble(const std::string& text, double& value);
+bool parseUint64(const std::string& text, uint64_t& value); // No sign
+
+struct Scenario {
+    std::optional<int> numVehicles;
+    std::optional<double> simHours;
+    std::optional<int> numChargers;
+    std::optional<int> vertiports;
+    std::optional<DispatchPolicy> dispatchPolicy;
+    std::optional<double> simTimeStepSeconds;
+    std::optional<SimulationEngine> engine;
+    std::optional<Vehicle::FaultModel> faultModel;
+    std::optional<int> threads;
+    std::optional<int> replications;
+    std::optional<uint64_t> seed;
+    std::optional<bool> randomizeVehicles;
+    std::vector<int> fleetComposition; // Vehicles per type id, see Simulation::setFleetComposition
+
+    /**
+     * @brief Parse a scenario, vehicle types are looked up in the registry.
+     * @param source Name used in error messages, e.g. the file name.
+     * @throws std::runtime_error with the line number for a malformed line.
+     */
+    static Scenario load(std::istream& in, const std::string& source);
+
+    /**
+     * @throws std::runtime_error if the file cannot be read or is malformed.
+     */
+    static Scenario loadFile(const std::string& filename);
+};
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file seqlock.hpp
+ * @brief Header file for the SeqLock class
+ *
+ * Single-writer sequence lock for publishing a trivially copyable value to any number of
+ * readers. The writer never waits: it makes the sequence odd, stores the value and makes
+ * the sequence even again. A reader copies the value and retries if the sequence was odd
+ * or changed while it copied. The value is stored in atomic words so the concurrent copy
+ * is not a data race.
+ */
+
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied bytewise");
+
+public:
+    SeqLock() {
+        uint64_t words[NUM_WORDS] = {};
+        const T value{};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < NUM_WORDS; ++i) {
+            data[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    // Writer side, one thread only
+    void store(const T& value) {
+        uint64_t words[NUM_WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < NUM_WORDS; ++i) {
+            data[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    // Reader side, any thread
+    T load() const {
+        uint64_t words[NUM_WORDS];
+        uint64_t before;
+        uint64_t after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < NUM_WORDS; ++i) {
+                words[i] = data[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // Number of completed store() calls
+    uint64_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> data[NUM_WORDS];
+};
+
+#endif
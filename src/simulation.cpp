@@ -1,12 +1,22 @@
 // simulation.cpp
 #include "simulation.hpp"
+#include "checkpoint.hpp"
+#include "fleet_kernels.hpp"
+#include "trace.hpp"
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <random>
+#include <stdexcept>
 
 
 /* Constructor*/
@@ -16,40 +26,217 @@ Simulation::Simulation(
         int numChargers,
         double simTimeStepSeconds,
         int simLogVerbosity,
-        bool randomizeVehicles)
+        bool randomizeVehicles,
+        bool writeReport)
     : numVehicles(numVehicles),
       simHours(simHours),
       numChargers(numChargers),
       simLogVerbosity(simLogVerbosity),
       simTimeStepSeconds(simTimeStepSeconds),
       randomizeVehicles(randomizeVehicles),
+      writeReport(writeReport),
+      seed(std::random_device{}()),
       chargingStations(numChargers, nullptr) {
 
+        logger.setVerbosityLevel(simLogVerbosity);
+        if (!writeReport) {
+            // Batch runs only read the statistics, skip the file system work entirely
+            logger.setLogMode(Logger::LogMode::NONE);
+            return;
+        }
+
         // Create output directory if it doesn't exist
         std::filesystem::create_directories("output");
 
         std::string filename = "output/eVTOL_sim_report_" + logger.getCurrentTimestamp() + ".txt";
         logger.setLogFile(filename);
-        logger.setVerbosityLevel(simLogVerbosity);
+}
+
+namespace {
+
+const uint64_t VERTIPORT_ROUTE_STREAM = 1ULL << 63; // Route stream of vehicle i is this + i, apart from the vehicle streams
+
+} // namespace
+
+std::vector<int> expandFleetComposition(const std::vector<int>& counts) {
+    std::vector<int> types;
+    std::vector<int> remaining; // Types with vehicles left, in id order
+    size_t total = 0;
+    for (size_t type = 0; type < counts.size(); ++type) {
+        if (counts[type] > 0) {
+            remaining.push_back(static_cast<int>(type));
+            total += static_cast<size_t>(counts[type]);
+        }
+    }
+    types.reserve(total);
+    for (int round = 1; !remaining.empty(); ++round) {
+        size_t kept = 0;
+        for (int type : remaining) {
+            types.push_back(type);
+            if (counts[type] > round) {
+                remaining[kept++] = type;
+            }
+        }
+        remaining.resize(kept);
+    }
+    return types;
+}
+
+void Simulation::setFleetComposition(const std::vector<int>& counts) {
+    if (counts.size() > getNumVehicleTypes()) {
+        throw std::runtime_error("Fleet composition has an unknown vehicle type");
+    }
+    long total = 0;
+    for (int count : counts) {
+        if (count < 0) {
+            throw std::runtime_error("Fleet composition has a negative vehicle count");
+        }
+        total += count;
+    }
+    if (!counts.empty() && total != numVehicles) {
+        throw std::runtime_error("Fleet composition has " + std::to_string(total) + " vehicles, the simulation " +
+                                 std::to_string(numVehicles));
+    }
+    fleetComposition = counts;
+    fleetTypes = expandFleetComposition(counts);
+}
+
+void Simulation::setVertiports(int count) {
+    if (count < 1 || count > numChargers) {
+        throw std::runtime_error("Number of vertiports must be between 1 and the number of chargers (" +
+                                 std::to_string(numChargers) + ")");
+    }
+    numVertiports = count;
+}
+
+/* Engine Names */
+std::string engineToString(SimulationEngine engine) {
+    switch (engine) {
+        case SimulationEngine::FixedStep: return "fixed";
+        case SimulationEngine::EventDriven: return "event";
+        case SimulationEngine::StructOfArrays: return "soa";
+        case SimulationEngine::Adaptive: return "adaptive";
+        default: return "unknown";
+    }
+}
+
+bool engineFromString(const std::string& name, SimulationEngine& engine) {
+    if (name == "fixed") {
+        engine = SimulationEngine::FixedStep;
+    } else if (name == "event") {
+        engine = SimulationEngine::EventDriven;
+    } else if (name == "soa") {
+        engine = SimulationEngine::StructOfArrays;
+    } else if (name == "adaptive") {
+        engine = SimulationEngine::Adaptive;
+    } else {
+        return false;
+    }
+    return true;
 }
 
 /* Run Simulation*/
 bool Simulation::runSimulation() {
-    bool success = false;
-
     currentTime = 0.0;
     stepCount = 0;
     timeStep = nextTimeStep();
 
+    openTrace();
+    // Every vehicle is visited on every step anyway when each one is logged or traced
+    fastForward = fastForwardEnabled && engine != SimulationEngine::EventDriven && !trace.isOpen() && !logger.isEnabled(2);
     printInitialStatus();
     initializeVehicles();
+    resetCharging();
+    if (resumeState) {
+        restoreCheckpoint(*resumeState);
+    }
+    timeStep = nextTimeStep(); // Adaptive steps depend on the fleet
+    if (checkpointInterval > 0) {
+        nextCheckpointTime = checkpointInterval * (std::floor(currentTime / checkpointInterval + 1e-9) + 1);
+    }
+
+    // The event engine processes one vehicle at a time and does not use the pool
+    if (numThreads > 1 && engine != SimulationEngine::EventDriven) {
+        threadPool = std::make_unique<ThreadPool>(numThreads);
+    }
 
     // Save current logging mode and switch to file-only for detailed step output
     Logger::LogMode originalMode = logger.getLogMode();
-    logger.setLogMode(Logger::LogMode::FILE_ONLY);
+    if (writeReport) {
+        logger.setLogMode(Logger::LogMode::FILE_ONLY);
+    }
+
+    // Random draws are counted from the stream counters, not on every draw
+    auto countDraws = [this]() {
+        uint64_t draws = rng.getCounter();
+        for (const auto& vehicleRng : vehicleRngs) {
+            draws += vehicleRng.getCounter();
+        }
+        return draws;
+    };
+    const uint64_t initialDraws = Profiler::ENABLED ? countDraws() : 0;
+    if (Profiler::ENABLED) {
+        profiler.begin();
+    }
+    lastProgressPermille = -1;
+    if (!metricsFile.empty()) {
+        metrics = std::make_unique<MetricsExporter>(metricsFile, metricsIntervalMs);
+        metricsStart = lastMetricsTime = std::chrono::steady_clock::now();
+        lastMetricsStep = stepCount;
+        publishMetrics();
+    }
+
+    switch (engine) {
+        case SimulationEngine::EventDriven: runEventLoop(); break;
+        case SimulationEngine::StructOfArrays: runFleetLoop(); break;
+        default: runFixedStepLoop(); break; // Fixed and adaptive steps
+    }
+    threadPool.reset();
+    trace.close();
+    if (metrics) {
+        publishMetrics(true);
+        metrics.reset(); // Writes the final snapshot
+    }
+
+    if (Profiler::ENABLED) {
+        profiler.end();
+        profiler.setCount(Profiler::Counter::RngDraws, countDraws() - initialDraws);
+        writeProfile();
+    }
+    writeTimeSeries();
+
+    if (writeReport) {
+        logger.setLogMode(Logger::LogMode::STDOUT_ONLY);
+        logger.logLine("", false);
+        // Restore original logging mode
+        logger.setLogMode(originalMode);
+    } else if (!logger.isEnabled(1)) {
+        return true; // Batch runs only read the statistics, a log sink also gets the tables
+    }
+
+    printStatsTable();
+    if (Profiler::ENABLED) {
+        printProfileTable();
+    }
+    printFaultStatsTable();
+    printSessionTable();
+    printFinalStatus();
+
+    return true;
+}
+
+void Simulation::runFixedStepLoop() {
+    if (!fastForward) {
+        unparkAll(); // Parked in the checkpoint this run resumed from
+    }
+
     while (currentTime < simHours) {
-        logger.logSubSectionDivider(2, "Simulation Step " + std::to_string(stepCount + 1));
-        logger.logLine(2, "Current Time: " + std::to_string(currentTime) + " hours (Delta +" + std::to_string(timeStep) + " hours from previous step)");
+        if (logger.isEnabled(2)) {
+            EVTOL_PROFILE_SCOPE(profiler, Logging);
+            logger.logSubSectionDivider("Simulation Step " + std::to_string(stepCount + 1));
+            logger.logLine("Current Time: " + std::to_string(currentTime) + " hours (Delta +" + std::to_string(timeStep) + " hours from previous step)");
+        }
+        traceStep(stepCount + 1, currentTime);
 
         processChargingVehicles();
         updateAllVehicles(timeStep);
@@ -57,91 +244,603 @@ bool Simulation::runSimulation() {
 
         currentTime += timeStep;
         stepCount++;
+        parkIdleVehicles();
         timeStep = nextTimeStep();
+        writeCheckpointIfDue(currentTime);
+        publishMetricsIfDue();
 
         // Update progress every few steps to avoid excessive output
         if (stepCount % 5 == 0 || currentTime >= simHours) {
             showProgress(currentTime, simHours);
         }
     }
+    unparkAll();
+}
 
-    logger.setLogMode(Logger::LogMode::STDOUT_ONLY);
-    logger.logLine("", false);
-    // Restore original logging mode
-    logger.setLogMode(originalMode);
+void Simulation::runFleetLoop() {
+    // Same step order as runFixedStepLoop, but the vehicles are advanced in the FleetSoA
+    // store. The Vehicle objects are only refreshed when per-vehicle lines are logged.
+    loadFleet();
+    if (!fastForward) {
+        unparkAll(); // Parked in the checkpoint this run resumed from
+    }
 
-    printStatsTable();
-    printFaultStatsTable();
-    printFinalStatus();
+    while (currentTime < simHours) {
+        if (logger.isEnabled(2)) {
+            EVTOL_PROFILE_SCOPE(profiler, Logging);
+            logger.logSubSectionDivider("Simulation Step " + std::to_string(stepCount + 1));
+            logger.logLine("Current Time: " + std::to_string(currentTime) + " hours (Delta +" + std::to_string(timeStep) + " hours from previous step)");
+        }
+        traceStep(stepCount + 1, currentTime);
+
+        processChargingVehicles();
+        updateFleet(timeStep);
+        manageCharging();
+
+        currentTime += timeStep;
+        stepCount++;
+        parkIdleVehicles();
+        timeStep = nextTimeStep();
+        writeCheckpointIfDue(currentTime);
+        publishMetricsIfDue();
 
-    return success;
+        if (stepCount % 5 == 0 || currentTime >= simHours) {
+            showProgress(currentTime, simHours);
+        }
+    }
+    unparkAll();
+
+    // Sync the facades so the final state can be inspected through the vehicles
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        fleet.store(i, *vehicles[i]);
+    }
+}
+
+void Simulation::loadFleet() {
+    fleet.clear();
+    fleet.reserve(vehicles.size());
+    for (const auto& vehicle : vehicles) {
+        fleet.load(*vehicle);
+    }
+}
+
+void Simulation::updateFleet(double timeStep) {
+    // Same chunks as updateAllVehicles, over the fleet columns
+    {
+        EVTOL_PROFILE_SCOPE(profiler, UpdateVehicles);
+        forEachChunk([this, timeStep](size_t chunk, size_t begin, size_t end) {
+            // Nearby active vehicles are stepped together, the parked ones between them skipped
+            for (size_t first = begin; first < end;) {
+                size_t last = first + 1;
+                while (last < end && activeVehicles[last] - activeVehicles[first] < FLEET_BLOCK_SIZE &&
+                       activeVehicles[last] - activeVehicles[last - 1] - 1 <= MAX_PARKED_GAP) {
+                    last++;
+                }
+                updateFleetSpan(chunk, &activeVehicles[first], last - first, timeStep);
+                first = last;
+            }
+        });
+        mergeChunkStats();
+    }
+
+    if (trace.isOpen()) {
+        // Straight from the columns, the facades are not needed for the trace
+        EVTOL_PROFILE_SCOPE(profiler, Trace);
+        for (size_t i = 0; i < fleet.size(); ++i) {
+            trace.write(static_cast<uint32_t>(vehicles[i]->getId()), fleet.getManufacturer(i),
+                        fleet.getState(i), fleet.getBatteryLevel(i), fleet.getStepStats(i));
+        }
+    } else if (logger.isEnabled(2)) {
+        EVTOL_PROFILE_SCOPE(profiler, Logging);
+        for (size_t i = 0; i < fleet.size(); ++i) {
+            fleet.store(i, *vehicles[i]);
+            printVehicleStats(vehicles[i].get(), vehicles[i]->getStepStats(), vehicles[i]->getTotalStats());
+        }
+    }
+}
+
+void Simulation::updateFleetSpan(size_t chunk, const size_t* active, size_t count, double timeStep) {
+    const size_t begin = active[0];
+    const size_t end = active[count - 1] + 1;
+    uint8_t previous[FLEET_BLOCK_SIZE];
+    std::copy(fleet.state.begin() + begin, fleet.state.begin() + end, previous);
+    if (end - begin == count) {
+        fleet.updateRange(begin, end, timeStep);
+    } else {
+        uint8_t parked[FLEET_BLOCK_SIZE];
+        std::fill_n(parked, end - begin, 1);
+        for (size_t k = 0; k < count; ++k) {
+            parked[active[k] - begin] = 0;
+        }
+        fleet.updateRange(begin, end, timeStep, parked);
+    }
+
+    // Statistics straight from the columns while the span is in the cache
+    VehicleTypeStats* partials = chunkTypeStats[chunk].data();
+    const FleetStatsColumns& step = fleet.step;
+    for (size_t k = 0; k < count; ++k) {
+        const size_t i = active[k];
+        VehicleTypeStats& partial = partials[fleet.manufacturer[i]];
+        partial.totalFlights += step.flights[i];
+        partial.totalCharges += step.charges[i];
+        partial.totalFlightTime += step.flightTime[i];
+        partial.totalDistance += step.distanceTraveled[i];
+        partial.totalChargingTime += step.chargingTime[i];
+        partial.totalQueuedTime += step.queuedTime[i];
+        partial.totalFaults += step.faults[i];
+        partial.totalPassengerMiles += step.passengerMiles[i];
+    }
+    for (size_t k = 0; k < count; ++k) {
+        const size_t i = active[k];
+        if (step.flights[i] > 0 || step.charges[i] > 0) {
+            completeSessions(i, step.get(i), fleet.getTotalStats(i), partials[fleet.manufacturer[i]]);
+        }
+        recordTransition(chunk, i, static_cast<Vehicle::State>(previous[i - begin]), fleet.getState(i));
+    }
+}
+
+void Simulation::runEventLoop() {
+    // Each vehicle has at most one pending event: its next deterministic transition
+    // (battery depleted, charge complete) or its sampled fault, whichever is first.
+    // Queued and Faulted vehicles have no pending event, they are only touched again
+    // when a charger is handed to them or at the end of the run.
+    // A resumed run continues with the restored event queue
+    if (!resumeState) {
+        eventQueue = EventQueue(std::greater<VehicleEvent>(), std::pmr::vector<VehicleEvent>(&arena));
+        eventSequence = 0;
+        lastUpdateTime.assign(vehicles.size(), 0.0);
+
+        traceStep(0, 0.0);
+        for (size_t i = 0; i < vehicles.size(); ++i) {
+            advanceVehicleTo(i, 0.0); // Ready -> Flying
+            scheduleNextTransition(i, 0.0);
+        }
+    }
+
+    const double progressInterval = simHours / 100.0;
+    double nextProgressTime = currentTime + progressInterval;
+
+    while (!eventQueue.empty() && eventQueue.top().time < simHours) {
+        // Checkpoints are taken between events, before the first event past the checkpoint time
+        writeCheckpointIfDue(eventQueue.top().time);
+
+        VehicleEvent event;
+        {
+            EVTOL_PROFILE_SCOPE(profiler, ScheduleEvents);
+            event = eventQueue.top();
+            eventQueue.pop();
+        }
+
+        currentTime = event.time;
+        stepCount++;
+
+        if (logger.isEnabled(2)) {
+            EVTOL_PROFILE_SCOPE(profiler, Logging);
+            logger.logSubSectionDivider("Simulation Event " + std::to_string(stepCount));
+            logger.logLine("Current Time: " + std::to_string(currentTime) + " hours");
+        }
+        traceStep(stepCount, currentTime);
+
+        Vehicle* vehicle = vehicles[event.vehicleIndex].get();
+        Vehicle::State previousState = vehicle->getCurrentState();
+        advanceVehicleTo(event.vehicleIndex, event.time);
+
+        // Vehicle finished charging, release its charger for the next queued vehicle
+        if (previousState == Vehicle::State::Charging && vehicle->getCurrentState() != Vehicle::State::Charging) {
+            releaseCharger(event.vehicleIndex);
+        }
+
+        if (vehicle->getCurrentState() == Vehicle::State::Queued) {
+            landAtVertiport(event.vehicleIndex);
+            EVTOL_PROFILE_COUNT(profiler, QueuePushes, 1);
+            maxQueueLength = std::max(maxQueueLength, vertiports.getQueueLength());
+        }
+
+        scheduleNextTransition(event.vehicleIndex, event.time);
+        dispatchChargers(event.time);
+        publishMetricsIfDue();
+
+        if (currentTime >= nextProgressTime) {
+            showProgress(currentTime, simHours);
+            nextProgressTime = currentTime + progressInterval;
+        }
+    }
+
+    // Bring every vehicle up to the end of the run (partial flights, waiting and faulted time)
+    currentTime = simHours;
+    if (logger.isEnabled(2)) {
+        logger.logSubSectionDivider("Simulation End");
+    }
+    traceStep(stepCount + 1, simHours);
+    for (size_t i = 0; i < vehicles.size(); ++i) {
+        advanceVehicleTo(i, simHours);
+    }
+    showProgress(currentTime, simHours);
+}
+
+void Simulation::advanceVehicleTo(size_t index, double time) {
+    Vehicle* vehicle = vehicles[index].get();
+
+    // Vehicles use the exponential fault model, a fault time is sampled when each flight starts
+    {
+        EVTOL_PROFILE_SCOPE(profiler, UpdateVehicles);
+#ifdef EVTOL_PROFILING
+        Vehicle::State previous = vehicle->getCurrentState();
+#endif
+        vehicle->updateState(time - lastUpdateTime[index]);
+        EVTOL_PROFILE_COUNT(profiler, StateTransitions, previous != vehicle->getCurrentState());
+    }
+
+    // A vehicle only charges at the start of an update, from a charger handed over before it
+    const VehicleStats& stepStats = vehicle->getStepStats();
+    if (stepStats.flights > 0 || stepStats.charges > 0) {
+        completeSessions(index, stepStats, vehicle->getTotalStats(), typeStats[vehicle->getManufacturer()]);
+    }
+    if (stepStats.chargingTime > 0) {
+        chargerUtilization.add(lastUpdateTime[index], stepStats.chargingTime, stepStats.chargingTime);
+    }
+    lastUpdateTime[index] = time;
+
+    updateVehicleStats(vehicle);
+}
+
+void Simulation::scheduleNextTransition(size_t index, double time) {
+    const Vehicle* vehicle = vehicles[index].get();
+    double duration;
+
+    switch (vehicle->getCurrentState()) {
+        case Vehicle::State::Flying:
+            duration = std::min(vehicle->getMaxFlightTime(), vehicle->getFlightTimeToFault());
+            break;
+        case Vehicle::State::Charging:
+            duration = vehicle->getTimeToFullCharge();
+            break;
+        default:
+            return; // Waiting for a charger or grounded, nothing to schedule
+    }
+
+    EVTOL_PROFILE_SCOPE(profiler, ScheduleEvents);
+    eventQueue.push({time + std::max(duration, 0.0), eventSequence++, index});
+    EVTOL_PROFILE_COUNT(profiler, EventPushes, 1);
+}
+
+void Simulation::dispatchChargers(double time) {
+    EVTOL_PROFILE_SCOPE(profiler, AssignChargers);
+    vertiports.dispatch([this, time](size_t index, int charger) {
+        Vehicle* vehicle = vehicles[index].get();
+
+        // Account for the time spent waiting before taking the charger
+        advanceVehicleTo(index, time);
+        endQueueWait(index);
+        occupyCharger(index, charger);
+        vehicle->startCharging();
+        scheduleNextTransition(index, time);
+        return true;
+    });
+
+    printChargingQueue();
+    printChargingStations();
 }
 
 double Simulation::nextTimeStep() const {
-    return std::min(simTimeStepSeconds * SECONDS_TO_HOURS, simHours - currentTime);
+    double step = (engine == SimulationEngine::Adaptive) ? nextAdaptiveStep() : simTimeStepSeconds * SECONDS_TO_HOURS;
+    return std::min(step, simHours - currentTime);
+}
+
+double Simulation::nextAdaptiveStep() const {
+    const double fixedStep = simTimeStepSeconds * SECONDS_TO_HOURS;
+
+    // A charger released at the start of the next step goes to the queue at its end, a fixed
+    // step keeps the hand-over as quick as in the fixed step engine
+    if (vertiports.getQueueLength() > 0) {
+        for (const auto& transitions : chunkTransitions) {
+            if (!transitions.doneCharging.empty()) {
+                return fixedStep;
+            }
+        }
+    }
+
+    // Nothing changes between the deterministic transitions of the vehicles (battery depleted,
+    // sampled fault, charge complete), queued and faulted vehicles only wait
+    double earliest = std::numeric_limits<double>::infinity();
+    for (size_t index : activeVehicles) {
+        const Vehicle* vehicle = vehicles[index].get();
+        switch (vehicle->getCurrentState()) {
+            case Vehicle::State::Ready:
+                earliest = std::min(earliest, fixedStep); // Takes off during the step
+                break;
+            case Vehicle::State::Flying: {
+                double toFault = vehicle->getFlightTimeToFault();
+                earliest = std::min(earliest, vehicle->getMaxFlightTime());
+                if (toFault >= 0) {
+                    earliest = std::min(earliest, toFault);
+                }
+                break;
+            }
+            case Vehicle::State::Charging:
+                earliest = std::min(earliest, vehicle->getTimeToFullCharge());
+                break;
+            default:
+                break;
+        }
+    }
+    return std::max(earliest, 0.0) + ADAPTIVE_STEP_MARGIN_HOURS;
 }
 
 void Simulation::updateAllVehicles(double timeStep) {
-    for (const auto& vehicle : vehicles) {
-            vehicle->updateState(timeStep);
-        updateVehicleStats(vehicle.get());
+    // Vehicles are independent between charging decisions, update them chunk by chunk
+    {
+        EVTOL_PROFILE_SCOPE(profiler, UpdateVehicles);
+        forEachChunk([this, timeStep](size_t chunk, size_t begin, size_t end) {
+            for (size_t position = begin; position < end; ++position) {
+                const size_t i = activeVehicles[position];
+                Vehicle* vehicle = vehicles[i].get();
+                Vehicle::State previous = vehicle->getCurrentState();
+                vehicle->updateState(timeStep);
+                VehicleTypeStats& partial = chunkTypeStats[chunk][static_cast<size_t>(vehicle->getManufacturer())];
+                const VehicleStats& step = vehicle->getStepStats();
+                updateTypeStats(partial, step);
+                if (step.flights > 0 || step.charges > 0) {
+                    completeSessions(i, step, vehicle->getTotalStats(), partial);
+                }
+                recordTransition(chunk, i, previous, vehicle->getCurrentState());
+            }
+        });
+        mergeChunkStats();
+    }
+
+    // Logging stays on this thread and in vehicle order
+    if (trace.isOpen()) {
+        EVTOL_PROFILE_SCOPE(profiler, Trace);
+        for (const auto& vehicle : vehicles) {
+            trace.write(*vehicle);
+        }
+    } else if (logger.isEnabled(2)) {
+        EVTOL_PROFILE_SCOPE(profiler, Logging);
+        for (const auto& vehicle : vehicles) {
+            printVehicleStats(vehicle.get(), vehicle->getStepStats(), vehicle->getTotalStats());
+        }
+    }
+}
+
+void Simulation::forEachChunk(const std::function<void(size_t chunk, size_t begin, size_t end)>& task) {
+    const size_t numActive = activeVehicles.size();
+    const size_t numChunks = (numActive + VEHICLES_PER_CHUNK - 1) / VEHICLES_PER_CHUNK;
+    auto runChunk = [&](size_t chunk) {
+        size_t begin = chunk * VEHICLES_PER_CHUNK;
+        task(chunk, begin, std::min(begin + VEHICLES_PER_CHUNK, numActive));
+    };
+
+    if (threadPool) {
+        threadPool->parallelFor(numChunks, runChunk);
+    } else {
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            runChunk(chunk);
+        }
+    }
+}
+
+void Simulation::mergeChunkStats() {
+    // Always merged in chunk order so the floating point sums do not depend on the thread count
+    double chargingHours = 0.0;
+    for (auto& chunk : chunkTypeStats) {
+        for (auto& pair : typeStats) {
+            auto& partial = chunk[static_cast<size_t>(pair.first)];
+            chargingHours += partial.totalChargingTime;
+            pair.second.add(partial);
+            partial.reset();
+        }
+    }
+    // Spread over the step, exact for steps that do not straddle a minute
+    if (chargingHours > 0) {
+        chargerUtilization.add(currentTime, timeStep, chargingHours);
     }
 }
 
 void Simulation::updateVehicleStats(Vehicle* vehicle) {
-    const Vehicle::Manufacturer manufacturer = vehicle->getManufacturer();
     const auto& stepStats = vehicle->getStepStats();
     const auto& totalStats = vehicle->getTotalStats();
 
-    // Track flight and charge counts for averages
-    static std::map<Vehicle*, Vehicle::State> lastState;
-    Vehicle::State currentState = vehicle->getCurrentState();
+    updateTypeStats(typeStats[vehicle->getManufacturer()], stepStats);
 
-    // Initialize if first time
-    if (lastState.find(vehicle) == lastState.end()) {
-        lastState[vehicle] = currentState;
-    }
-
-    if (lastState[vehicle] == Vehicle::State::Charging && currentState != Vehicle::State::Charging) {
-        // Vehicle just finished charging
-        typeStats[manufacturer].totalCharges++;
-    } else if (lastState[vehicle] == Vehicle::State::Flying && currentState != Vehicle::State::Flying) {
-        // Vehicle just finished flying
-        // TODO: This would count even Faulted flight as flights, which may not be desired
-        // need to decide if we want to count Faulted flights
-        typeStats[manufacturer].totalFlights++;
+    if (trace.isOpen()) {
+        EVTOL_PROFILE_SCOPE(profiler, Trace);
+        trace.write(*vehicle);
+    } else if (logger.isEnabled(2)) {
+        EVTOL_PROFILE_SCOPE(profiler, Logging);
+        printVehicleStats(vehicle, stepStats, totalStats);
     }
+}
 
-    // Update type statistics
-    auto& typeData = typeStats[manufacturer];
+void Simulation::updateTypeStats(VehicleTypeStats& typeData, const VehicleStats& stepStats) {
+    // Flights and charging sessions are counted by the vehicle when they complete
+    // TODO: Faulted flights are counted as flights, which may not be desired
+    typeData.totalFlights += stepStats.flights;
+    typeData.totalCharges += stepStats.charges;
 
     typeData.totalFlightTime += stepStats.flightTime;
     typeData.totalDistance += stepStats.distanceTraveled;
     typeData.totalChargingTime += stepStats.chargingTime;
+    typeData.totalQueuedTime += stepStats.queuedTime;
     typeData.totalFaults += stepStats.faults;
     typeData.totalPassengerMiles += stepStats.passengerMiles;
+}
+
+void Simulation::completeSessions(size_t index, const VehicleStats& stepStats, const VehicleStats& totalStats,
+                                  VehicleTypeStats& typeData) {
+    // A step ends at most one flight and one charging session: after a flight the vehicle waits
+    // for a charger, which is only handed out between steps. A long step may complete a charge
+    // and then start and end a flight, but flight time only accrues while flying and charging
+    // time while charging, so the time since the last completion of each belongs to the one
+    // session completed
+    SessionClock& clock = sessionClocks[index];
+    if (stepStats.flights > 0) {
+        typeData.flightTimes.add(totalStats.flightTime - clock.flight);
+        clock.flight = totalStats.flightTime;
+    }
+    if (stepStats.charges > 0) {
+        typeData.chargeTimes.add(totalStats.chargingTime - clock.charging);
+        clock.charging = totalStats.chargingTime;
+    }
+}
+
+void Simulation::endQueueWait(size_t index) {
+    // Queueing ends between steps, when the vehicle gets a charger
+    const double queued = (engine == SimulationEngine::StructOfArrays) ? fleet.getTotalStats(index).queuedTime
+                                                                       : vehicles[index]->getTotalStats().queuedTime;
+    SessionClock& clock = sessionClocks[index];
+    typeStats[vehicles[index]->getManufacturer()].queueWaitTimes.add(queued - clock.queued);
+    clock.queued = queued;
+}
+
+void Simulation::parkIdleVehicles() {
+    // Vehicles handed a charger during the step rejoin in index order
+    if (!unparkedVehicles.empty()) {
+        std::sort(unparkedVehicles.begin(), unparkedVehicles.end());
+        const size_t middle = activeVehicles.size();
+        activeVehicles.insert(activeVehicles.end(), unparkedVehicles.begin(), unparkedVehicles.end());
+        std::inplace_merge(activeVehicles.begin(), activeVehicles.begin() + middle, activeVehicles.end());
+        unparkedVehicles.clear();
+    }
+    if (!fastForward) {
+        return;
+    }
+
+    // Queued vehicles without a charger and faulted vehicles only wait until something
+    // hands them a charger, or for good
+    size_t kept = 0;
+    for (size_t index : activeVehicles) {
+        Vehicle::State state = getVehicleState(index);
+        if (state == Vehicle::State::Queued || state == Vehicle::State::Faulted) {
+            parkedSince[index] = currentTime;
+        } else {
+            activeVehicles[kept++] = index;
+        }
+    }
+    activeVehicles.resize(kept);
+}
+
+void Simulation::unparkVehicle(size_t index, double time) {
+    settleParkedTime(index, time);
+    parkedSince[index] = -1.0;
+    unparkedVehicles.push_back(index);
+}
+
+void Simulation::unparkAll() {
+    for (size_t index = 0; index < parkedSince.size(); ++index) {
+        if (isParked(index)) {
+            settleParkedTime(index, currentTime);
+            parkedSince[index] = -1.0;
+        }
+    }
+    activeVehicles.resize(vehicles.size());
+    std::iota(activeVehicles.begin(), activeVehicles.end(), size_t{0});
+    unparkedVehicles.clear();
+}
+
+void Simulation::settleParkedTime(size_t index, double time) {
+    // The time every skipped step would have added, in one go
+    const double hours = time - parkedSince[index];
+    parkedSince[index] = time;
+    const bool queued = getVehicleState(index) == Vehicle::State::Queued;
+    if (engine == SimulationEngine::StructOfArrays) {
+        (queued ? fleet.total.queuedTime : fleet.total.faultedTime)[index] += hours;
+    } else {
+        VehicleStats& total = vehicles[index]->getTotalStats();
+        (queued ? total.queuedTime : total.faultedTime) += hours;
+    }
+    if (queued) {
+        typeStats[vehicles[index]->getManufacturer()].totalQueuedTime += hours;
+    }
+}
+
+void Simulation::resetCharging() {
+    // Every charger free, the lowest index of a site is handed out first
+    vertiports.reset(numVertiports, numChargers, vehicles.size(), getNumVehicleTypes());
+    maxQueueLength = 0;
+    chargingStations.assign(numChargers, nullptr);
+    vehicleCharger.assign(vehicles.size(), -1);
+    vehicleSite.resize(vehicles.size());
+    for (size_t i = 0; i < vehicleSite.size(); ++i) {
+        vehicleSite[i] = static_cast<int>(i % static_cast<size_t>(numVertiports));
+    }
+    chunkTransitions.assign(chunkTypeStats.size(), {});
+}
+
+void Simulation::recordTransition(size_t chunk, size_t index, Vehicle::State previous, Vehicle::State current) {
+    EVTOL_PROFILE_COUNT(profiler, StateTransitions, previous != current);
+    if (previous == Vehicle::State::Charging && current != Vehicle::State::Charging) {
+        chunkTransitions[chunk].doneCharging.push_back(index);
+    }
+    if (current == Vehicle::State::Queued && previous != Vehicle::State::Queued) {
+        chunkTransitions[chunk].queued.push_back(index);
+    }
+}
 
-    lastState[vehicle] = currentState;
+void Simulation::occupyCharger(size_t index, int charger) {
+    chargingStations[charger] = vehicles[index].get();
+    vehicleCharger[index] = charger;
+}
+
+void Simulation::releaseCharger(size_t index) {
+    int charger = vehicleCharger[index];
+    if (charger >= 0) {
+        chargingStations[charger] = nullptr;
+        vehicleCharger[index] = -1;
+        vertiports.releaseCharger(charger);
+    }
+}
+
+void Simulation::landAtVertiport(size_t index) {
+    int site = chooseLandingSite(index);
+    vehicleSite[index] = site;
+
+    // The soa engine keeps the battery level in the fleet store
+    const Vehicle& vehicle = *vehicles[index];
+    const double battery = (engine == SimulationEngine::StructOfArrays) ? fleet.getBatteryLevel(index) : vehicle.getBatteryLevel();
+    ChargeRequest request;
+    request.chargeHours = vehicle.getTimeToCharge() * std::max(0.0, 1.0 - battery / vehicle.getBatteryCapacity());
+    request.passengers = vehicle.getPassengerCount();
+    request.type = static_cast<size_t>(vehicle.getManufacturer());
+    vertiports.enqueue(site, index, request);
+}
 
-    printVehicleStats(vehicle, stepStats, totalStats);
+int Simulation::chooseLandingSite(size_t index) const {
+    const int sites = vertiports.getSiteCount();
+    if (sites == 1) {
+        return 0;
+    }
+
+    // The flight's destination and an alternate, both other than the site the vehicle left.
+    // Drawn from the vehicle's route stream at the landing step, a vehicle lands at most once
+    // per step, so its own random stream is untouched.
+    const uint64_t route = CounterRandomGenerator::at(seed, VERTIPORT_ROUTE_STREAM + index, static_cast<uint64_t>(stepCount));
+    const uint64_t others = static_cast<uint64_t>(sites - 1);
+    const int origin = vehicleSite[index];
+    const int planned = static_cast<int>((origin + 1 + (route & 0xffffffffULL) % others) % sites);
+    const int alternate = static_cast<int>((origin + 1 + (route >> 32) % others) % sites);
+
+    // Divert if fewer vehicles wait per free charger at the alternate
+    return vertiports.getBacklog(alternate) < vertiports.getBacklog(planned) ? alternate : planned;
 }
 
 void Simulation::manageCharging() {
+    EVTOL_PROFILE_SCOPE(profiler, QueueVehicles);
 
-    logger.logLine(2);
-    logger.logLine(2, "Manage Charging Queue");
+    if (logger.isEnabled(2)) {
+        logger.logLine();
+        logger.logLine("Manage Charging Queue");
+    }
 
-    // Add vehicles that need charging to queue
-    for (const auto& vehicle : vehicles) {
-        if (vehicle->getCurrentState() == Vehicle::State::Queued) {
-            // If a vehicle is in queued state add it
-            // to the charging queue if it is not already in the queue
-            if (queuedVehicles.find(vehicle.get()) == queuedVehicles.end()) {
-                chargingQueue.push(vehicle.get());
-                queuedVehicles.insert(vehicle.get());
-            }
+    // Vehicles that became Queued during this step land and join their site's queue, in vehicle order
+    for (auto& transitions : chunkTransitions) {
+        for (size_t index : transitions.queued) {
+            landAtVertiport(index);
         }
+        EVTOL_PROFILE_COUNT(profiler, QueuePushes, transitions.queued.size());
+        transitions.queued.clear();
     }
+    maxQueueLength = std::max(maxQueueLength, vertiports.getQueueLength());
 
     printChargingQueue();
     logger.logLine(2);
@@ -150,83 +849,151 @@ void Simulation::manageCharging() {
 }
 
 void Simulation::assignAvailableChargers() {
+    EVTOL_PROFILE_SCOPE(profiler, AssignChargers);
 
-    logger.logLine(2);
-    logger.logLine(2, "Assign Available Chargers");
-
-    // Assign available chargers to queued vehicles
-    for (int i = 0; i < numChargers && !chargingQueue.empty(); i++) {
-        if (chargingStations[i] == nullptr) {
-            Vehicle* vehicle = chargingQueue.front();
-            chargingQueue.pop();
-            queuedVehicles.erase(vehicle);
-
-            if (vehicle->getCurrentState() == Vehicle::State::Queued) {
-                chargingStations[i] = vehicle;
-                vehicle->startCharging();
-            }
-        }
+    if (logger.isEnabled(2)) {
+        logger.logLine();
+        logger.logLine("Assign Available Chargers");
     }
 
+    // Assign the available chargers of each site that changed to its queued vehicles
+    vertiports.dispatch([this](size_t index, int charger) {
+        if (getVehicleState(index) != Vehicle::State::Queued) {
+            return false;
+        }
+        // The vehicle waited until the end of this step
+        if (isParked(index)) {
+            unparkVehicle(index, currentTime + timeStep);
+        }
+        endQueueWait(index);
+        occupyCharger(index, charger);
+        // The soa engine keeps the vehicle state in the fleet store
+        if (engine == SimulationEngine::StructOfArrays) {
+            fleet.startCharging(index);
+        } else {
+            vehicles[index]->startCharging();
+        }
+        return true;
+    });
+
     printChargingStations();
     logger.logLine(2);
 }
 
 void Simulation::processChargingVehicles() {
-    for (int i = 0; i < numChargers; ++i) {
-        if (chargingStations[i] != nullptr) {
-            Vehicle* vehicle = chargingStations[i];
-
-            if (vehicle->getCurrentState() != Vehicle::State::Charging) {
-                    // Vehicle is no longer charging, free the charger
-                    chargingStations[i] = nullptr;
-            }
+    EVTOL_PROFILE_SCOPE(profiler, ReleaseChargers);
+    // Free the chargers of vehicles that stopped charging during the previous step
+    for (auto& transitions : chunkTransitions) {
+        for (size_t index : transitions.doneCharging) {
+            releaseCharger(index);
         }
+        transitions.doneCharging.clear();
     }
 }
 
 /* Initialization */
-std::unique_ptr<Vehicle> Simulation::createVehicle(int type) {
+namespace {
+
+// Every vehicle class shares the layout of Vehicle, so the arena blocks of all vehicles have one size
+template <typename VehicleClass, typename... Args>
+VehicleClass* newArenaVehicle(std::pmr::memory_resource& arena, Args&&... args) {
+    static_assert(sizeof(VehicleClass) == sizeof(Vehicle) && alignof(VehicleClass) == alignof(Vehicle),
+                  "Arena vehicle blocks are freed with the size of Vehicle");
+    void* block = arena.allocate(sizeof(Vehicle), alignof(Vehicle));
+    try {
+        return new (block) VehicleClass(std::forward<Args>(args)...);
+    } catch (...) {
+        arena.deallocate(block, sizeof(Vehicle), alignof(Vehicle));
+        throw;
+    }
+}
+
+} // namespace
+
+void Simulation::ArenaDelete::operator()(Vehicle* vehicle) const {
+    vehicle->~Vehicle();
+    resource->deallocate(vehicle, sizeof(Vehicle), alignof(Vehicle));
+}
+
+Simulation::VehiclePtr Simulation::createVehicle(int type, RandomGenerator& rng) {
+    ArenaDelete deleter{&arena};
     switch (type) {
-        case 0: return std::make_unique<AlphaCompanyVehicle>();
-        case 1: return std::make_unique<BravoCompanyVehicle>();
-        case 2: return std::make_unique<CharlieCompanyVehicle>();
-        case 3: return std::make_unique<DeltaCompanyVehicle>();
-        case 4: return std::make_unique<EchoCompanyVehicle>();
-        default: return nullptr;
+        case 0: return VehiclePtr(newArenaVehicle<AlphaCompanyVehicle>(arena, rng), deleter);
+        case 1: return VehiclePtr(newArenaVehicle<BravoCompanyVehicle>(arena, rng), deleter);
+        case 2: return VehiclePtr(newArenaVehicle<CharlieCompanyVehicle>(arena, rng), deleter);
+        case 3: return VehiclePtr(newArenaVehicle<DeltaCompanyVehicle>(arena, rng), deleter);
+        case 4: return VehiclePtr(newArenaVehicle<EchoCompanyVehicle>(arena, rng), deleter);
+        default: break;
     }
+
+    // Registered types have no class of their own
+    auto manufacturer = static_cast<Vehicle::Manufacturer>(type);
+    if (type < 0 || !VehicleTypeRegistry::instance().contains(manufacturer)) {
+        return nullptr;
+    }
+    return VehiclePtr(newArenaVehicle<Vehicle>(arena, manufacturer, getVehicleTypeSpec(manufacturer), rng), deleter);
 }
 
 void Simulation::initializeVehicles() {
 
     logger.logSectionDivider("Initialize Simulation Vehicles");
 
+    // Blocks of the previous run go back to the arena and are reused by this one
     vehicles.clear();
+    vehicleIndex.clear();
     typeStats.clear();
+    vehicles.reserve(numVehicles);
+    vehicleIndex.reserve(numVehicles);
+
+    // Stream 0 is the simulation's own, vehicle i draws from stream i + 1. Each stream is a
+    // function of (seed, stream, draw index) only, so the draws do not depend on the thread count.
+    rng = CounterRandomGenerator(seed, 0);
+    vehicleRngs.clear();
+    vehicleRngs.reserve(numVehicles); // Vehicles keep references, must not reallocate
+    for (int i = 0; i < numVehicles; ++i) {
+        vehicleRngs.emplace_back(seed, static_cast<uint64_t>(i) + 1);
+    }
 
-    std::map<std::string, int> vehicleCounts;
+    size_t numChunks = (static_cast<size_t>(numVehicles) + VEHICLES_PER_CHUNK - 1) / VEHICLES_PER_CHUNK;
+    const size_t numTypes = getNumVehicleTypes();
+    chunkTypeStats.assign(numChunks, std::vector<VehicleTypeStats>(numTypes));
+    sessionClocks.assign(numVehicles, {});
+    chargerUtilization.clear();
 
-    // Generate vehicles
-    for(int i = 0; i < numVehicles; ++i) {
-        int type;
-        if (randomizeVehicles) {
-            type = rng.uniformInt(0, NUM_VEHICLE_TYPES - 1);
-        } else {
-            type = i % NUM_VEHICLE_TYPES; // Round-robin selection (equal distribution, for testing)
+    std::vector<int> types(numVehicles);
+    if (resumeState) {
+        for (int i = 0; i < numVehicles; ++i) {
+            types[i] = static_cast<int>(resumeState->vehicles[i].manufacturer);
         }
+    } else if (!fleetTypes.empty()) {
+        types = fleetTypes; // Expanded once by setFleetComposition, no random draws
+    } else if (randomizeVehicles) {
+        rng.fillUniformInt(0, static_cast<int>(numTypes) - 1, types.data(), types.size());
+    } else {
+        for (int i = 0; i < numVehicles; ++i) {
+            types[i] = i % static_cast<int>(numTypes); // Round-robin selection (equal distribution, for testing)
+        }
+    }
 
-        auto vehicle = createVehicle(type);
+    // Generate vehicles
+    for(int i = 0; i < numVehicles; ++i) {
+        auto vehicle = createVehicle(types[i], vehicleRngs[i]);
         if (vehicle) {
-            std::string name = vehicle->getManufacturerString();
-            vehicleCounts[name]++;
+            vehicle->setFaultModel(getEffectiveFaultModel());
+            // Ids follow the vehicle index, not a process-wide counter, so runs on other threads
+            // and earlier runs do not change them
+            vehicle->setId(static_cast<int>(vehicles.size()) + 1);
+            vehicleIndex[vehicle.get()] = vehicles.size();
             vehicles.push_back(std::move(vehicle));
         }
 
     }
+    parkedSince.assign(vehicles.size(), -1.0);
+    unparkAll();
 
     // Initialize type statistics
     for (const auto& vehicle : vehicles) {
-        if (typeStats.find(vehicle->getManufacturer()) == typeStats.end()) {
+        if (!typeStats.contains(vehicle->getManufacturer())) {
             typeStats[vehicle->getManufacturer()].manufacturerName = vehicle->getManufacturerString();
             typeStats[vehicle->getManufacturer()].expectedFaultRate = vehicle->getFaultProbability();
         }
@@ -235,40 +1002,277 @@ void Simulation::initializeVehicles() {
 
     logger.logLine("Vehicle type counts:");
     int totalVehicles = 0;
-    for (const auto& pair : vehicleCounts) {
-        logger.logLine("  " + pair.first + ": " + std::to_string(pair.second));
-        totalVehicles += pair.second;
+    for (const auto& pair : typeStats) {
+        logger.logLine("  " + pair.second.manufacturerName + ": " + std::to_string(pair.second.vehicleCount));
+        totalVehicles += pair.second.vehicleCount;
     }
     logger.logLine("  Total vehicles: " + std::to_string(totalVehicles));
     logger.logLine();
 }
 
 
+/* Checkpoints */
+bool Simulation::resumeFrom(const SimulationCheckpoint& checkpoint) {
+    if (checkpoint.numVehicles != numVehicles || checkpoint.numChargers != numChargers ||
+        checkpoint.numVertiports != numVertiports || checkpoint.dispatchPolicy != vertiports.getPolicy() ||
+        checkpoint.queuePriorities.size() != checkpoint.chargingQueue.size() ||
+        checkpoint.engine != engine || checkpoint.vehicles.size() != static_cast<size_t>(numVehicles) ||
+        checkpoint.chargingStations.size() != static_cast<size_t>(numChargers) ||
+        checkpoint.vehicleSites.size() != static_cast<size_t>(numVehicles)) {
+        return false;
+    }
+
+    // Every index must refer to a vehicle or charger of this simulation
+    const uint64_t count = static_cast<uint64_t>(numVehicles);
+    auto isVehicle = [count](uint64_t index) { return index < count; };
+    bool valid = std::all_of(checkpoint.chargingQueue.begin(), checkpoint.chargingQueue.end(), isVehicle) &&
+                 std::all_of(checkpoint.doneCharging.begin(), checkpoint.doneCharging.end(), isVehicle) &&
+                 std::all_of(checkpoint.chargingStations.begin(), checkpoint.chargingStations.end(),
+                             [count](int64_t index) { return index < static_cast<int64_t>(count); }) &&
+                 std::all_of(checkpoint.freeChargers.begin(), checkpoint.freeChargers.end(),
+                             [this](int32_t charger) { return charger >= 0 && charger < numChargers; }) &&
+                 std::all_of(checkpoint.vehicleSites.begin(), checkpoint.vehicleSites.end(),
+                             [this](int32_t site) { return site >= 0 && site < numVertiports; }) &&
+                 std::all_of(checkpoint.events.begin(), checkpoint.events.end(),
+                             [count](const EventCheckpoint& event) { return event.vehicleIndex < count; }) &&
+                 std::all_of(checkpoint.vehicles.begin(), checkpoint.vehicles.end(), [](const VehicleCheckpoint& vehicle) {
+                     return VehicleTypeRegistry::instance().contains(vehicle.manufacturer);
+                 });
+    if (engine == SimulationEngine::EventDriven) {
+        valid = valid && checkpoint.lastUpdateTime.size() == static_cast<size_t>(numVehicles);
+    }
+    const bool fairShare = vertiports.getPolicy() == DispatchPolicy::FairShare;
+    valid = valid && checkpoint.siteVirtualTimes.size() == (fairShare ? static_cast<size_t>(numVertiports) : 0) &&
+            checkpoint.siteFinishTags.size() == (fairShare ? static_cast<size_t>(numVertiports) * getNumVehicleTypes() : 0);
+    valid = valid && checkpoint.sessionClocks.size() == 3 * static_cast<size_t>(numVehicles) &&
+            checkpoint.utilizationValues.size() <= chargerUtilization.getCapacity() &&
+            checkpoint.parkedSince.size() == static_cast<size_t>(numVehicles);
+    // Only vehicles that wait can be parked, and not past the checkpoint
+    for (size_t i = 0; valid && i < checkpoint.parkedSince.size(); ++i) {
+        Vehicle::State state = checkpoint.vehicles[i].state;
+        valid = checkpoint.parkedSince[i] < 0 ||
+                ((state == Vehicle::State::Queued || state == Vehicle::State::Faulted) &&
+                 checkpoint.parkedSince[i] <= checkpoint.currentTime);
+    }
+    if (!valid) {
+        return false;
+    }
+
+    resumeState = std::make_shared<SimulationCheckpoint>(checkpoint);
+    return true;
+}
+
+SimulationCheckpoint Simulation::createCheckpoint() const {
+    SimulationCheckpoint checkpoint;
+    checkpoint.numVehicles = numVehicles;
+    checkpoint.simHours = simHours;
+    checkpoint.numChargers = numChargers;
+    checkpoint.numVertiports = numVertiports;
+    checkpoint.dispatchPolicy = vertiports.getPolicy();
+    checkpoint.simTimeStepSeconds = simTimeStepSeconds;
+    checkpoint.randomizeVehicles = randomizeVehicles;
+    checkpoint.engine = engine;
+    checkpoint.faultModel = faultModel;
+    checkpoint.seed = seed;
+    checkpoint.currentTime = currentTime;
+    checkpoint.stepCount = stepCount;
+    checkpoint.rngCounter = rng.getCounter();
+
+    for (size_t i = 0; i < vehicles.size(); ++i) {
+        const Vehicle& vehicle = *vehicles[i];
+        checkpoint.vehicles.push_back({vehicle.getManufacturer(), vehicle.getCurrentState(), vehicle.getFaultModel(),
+                                       vehicle.getBatteryLevel(), vehicle.getFlightTimeToFault(),
+                                       vehicle.getStepStats(), vehicle.getTotalStats(), vehicleRngs[i].getCounter()});
+    }
+
+    // Queues and free chargers site after site, every vehicle and charger belongs to one site
+    for (int site = 0; site < vertiports.getSiteCount(); ++site) {
+        for (const auto& entry : vertiports.getQueue(site)) {
+            checkpoint.chargingQueue.push_back(entry.handle);
+            checkpoint.queuePriorities.push_back(entry.key.value);
+        }
+        const std::vector<int>& free = vertiports.getFreeChargers(site);
+        checkpoint.freeChargers.insert(checkpoint.freeChargers.end(), free.begin(), free.end());
+    }
+    for (const Vehicle* vehicle : chargingStations) {
+        checkpoint.chargingStations.push_back(vehicle ? static_cast<int64_t>(vehicleIndex.at(vehicle)) : -1);
+    }
+    checkpoint.vehicleSites.assign(vehicleSite.begin(), vehicleSite.end());
+    checkpoint.siteVirtualTimes = vertiports.getVirtualTimes();
+    checkpoint.siteFinishTags = vertiports.getFinishTags();
+    for (const auto& transitions : chunkTransitions) {
+        checkpoint.doneCharging.insert(checkpoint.doneCharging.end(),
+                                       transitions.doneCharging.begin(), transitions.doneCharging.end());
+    }
+    for (const auto& pair : typeStats) {
+        checkpoint.typeStats.push_back(pair.second);
+        checkpoint.typeStats.back().manufacturer = pair.first;
+    }
+    for (const SessionClock& clock : sessionClocks) {
+        checkpoint.sessionClocks.insert(checkpoint.sessionClocks.end(), {clock.flight, clock.queued, clock.charging});
+    }
+    checkpoint.utilizationFirstWindow = chargerUtilization.getFirstWindow();
+    checkpoint.utilizationValues = chargerUtilization.getValues();
+    checkpoint.parkedSince = parkedSince;
+
+    auto events = eventQueue;
+    while (!events.empty()) {
+        checkpoint.events.push_back({events.top().time, events.top().sequence, events.top().vehicleIndex});
+        events.pop();
+    }
+    checkpoint.eventSequence = eventSequence;
+    checkpoint.lastUpdateTime = lastUpdateTime;
+    return checkpoint;
+}
+
+void Simulation::restoreCheckpoint(const SimulationCheckpoint& checkpoint) {
+    currentTime = checkpoint.currentTime;
+    stepCount = checkpoint.stepCount;
+    rng.setCounter(checkpoint.rngCounter);
+
+    for (size_t i = 0; i < vehicles.size(); ++i) {
+        const VehicleCheckpoint& saved = checkpoint.vehicles[i];
+        Vehicle& vehicle = *vehicles[i];
+        vehicle.setCurrentState(saved.state);
+        vehicle.setBatteryLevel(saved.batteryLevel);
+        vehicle.setFlightTimeToFault(saved.flightTimeToFault);
+        vehicle.setFaultModel(saved.faultModel);
+        vehicle.getStepStats() = saved.stepStats;
+        vehicle.getTotalStats() = saved.totalStats;
+        vehicleRngs[i].setCounter(saved.rngCounter);
+    }
+
+    vehicleSite.assign(checkpoint.vehicleSites.begin(), checkpoint.vehicleSites.end());
+    for (size_t i = 0; i < checkpoint.chargingQueue.size(); ++i) {
+        size_t index = checkpoint.chargingQueue[i];
+        vertiports.restoreQueued(vehicleSite[index], index, checkpoint.queuePriorities[i]);
+    }
+    vertiports.setFairShareState(checkpoint.siteVirtualTimes, checkpoint.siteFinishTags);
+    maxQueueLength = vertiports.getQueueLength();
+    for (size_t charger = 0; charger < checkpoint.chargingStations.size(); ++charger) {
+        int64_t index = checkpoint.chargingStations[charger];
+        if (index >= 0) {
+            chargingStations[charger] = vehicles[index].get();
+            vehicleCharger[index] = static_cast<int>(charger);
+        }
+    }
+    vertiports.setFreeChargers(checkpoint.freeChargers);
+    // Releases are drained in chunk order, keeping them all in the first chunk keeps their order
+    if (!chunkTransitions.empty()) {
+        chunkTransitions[0].doneCharging.assign(checkpoint.doneCharging.begin(), checkpoint.doneCharging.end());
+    }
+
+    for (const auto& saved : checkpoint.typeStats) {
+        auto entry = typeStats.find(saved.manufacturer);
+        if (entry != typeStats.end()) {
+            VehicleTypeStats& stats = entry->second;
+            stats.totalFlights = saved.totalFlights;
+            stats.totalCharges = saved.totalCharges;
+            stats.totalFlightTime = saved.totalFlightTime;
+            stats.totalDistance = saved.totalDistance;
+            stats.totalChargingTime = saved.totalChargingTime;
+            stats.totalQueuedTime = saved.totalQueuedTime;
+            stats.totalFaults = saved.totalFaults;
+            stats.totalPassengerMiles = saved.totalPassengerMiles;
+            stats.queueWaitTimes = saved.queueWaitTimes;
+            stats.chargeTimes = saved.chargeTimes;
+            stats.flightTimes = saved.flightTimes;
+        }
+    }
+    for (size_t i = 0; i < sessionClocks.size(); ++i) {
+        sessionClocks[i] = {checkpoint.sessionClocks[3 * i], checkpoint.sessionClocks[3 * i + 1], checkpoint.sessionClocks[3 * i + 2]};
+    }
+    chargerUtilization.restore(checkpoint.utilizationFirstWindow, checkpoint.utilizationValues);
+    parkedSince = checkpoint.parkedSince;
+    activeVehicles.clear();
+    for (size_t i = 0; i < parkedSince.size(); ++i) {
+        if (!isParked(i)) {
+            activeVehicles.push_back(i);
+        }
+    }
+
+    eventQueue = EventQueue(std::greater<VehicleEvent>(), std::pmr::vector<VehicleEvent>(&arena));
+    for (const auto& event : checkpoint.events) {
+        eventQueue.push({event.time, static_cast<unsigned long>(event.sequence), static_cast<size_t>(event.vehicleIndex)});
+    }
+    eventSequence = static_cast<unsigned long>(checkpoint.eventSequence);
+    lastUpdateTime = checkpoint.lastUpdateTime;
+}
+
+void Simulation::writeCheckpointIfDue(double time) {
+    // No checkpoint at the end of the run, a tiny last step is left when the steps do not sum exactly
+    if (checkpointInterval <= 0 || time < nextCheckpointTime - 1e-9 || time >= simHours - 1e-9) {
+        return;
+    }
+    while (nextCheckpointTime <= time + 1e-9) {
+        nextCheckpointTime += checkpointInterval;
+    }
+
+    EVTOL_PROFILE_SCOPE(profiler, Checkpoint);
+    // The soa engine keeps the vehicle state in the fleet store
+    if (engine == SimulationEngine::StructOfArrays) {
+        for (size_t i = 0; i < fleet.size(); ++i) {
+            fleet.store(i, *vehicles[i]);
+        }
+    }
+
+    if (createCheckpoint().write(checkpointFile)) {
+        logger.logLine("Checkpoint at " + std::to_string(currentTime) + " hours: " + checkpointFile);
+    } else {
+        std::cerr << "\nError: Could not write checkpoint " << checkpointFile << "\n";
+    }
+}
+
 /* Print Helpers */
 void Simulation::printVehicleStats(const Vehicle* vehicle, const VehicleStats& stepStats, const VehicleStats& totalStats) {
-    int batteryPercent = static_cast<int>(vehicle->getBatteryPercent() + 0.5);
-    std::string batteryDisplay = "Battery " + std::to_string(batteryPercent) + "%";
-    std::string stepSection = stepStats.toShortString();
-    std::string totalSection = totalStats.toLongString();
-
-    const int stepWidth = 40;
-    const int totalWidth = 140;
+    // Called for every vehicle every step, only format if the line will be logged
+    logger.logLineLazy(2, [&]() {
+        return formatVehicleStatsLine(vehicle->getId(), vehicle->getManufacturer(), vehicle->getCurrentState(),
+                                      vehicle->getBatteryPercent(), stepStats, totalStats);
+    });
+}
 
-    stepSection.resize(stepWidth, ' ');   // Pad with spaces
-    totalSection.resize(totalWidth, ' '); // Pad with spaces
+bool Simulation::openTrace() {
+    if (traceFormat != TraceFormat::Binary) {
+        return false;
+    }
+    if (traceFile.empty()) {
+        std::filesystem::create_directories("output");
+        traceFile = "output/eVTOL_sim_trace_" + logger.getCurrentTimestamp() + ".evtrace";
+    }
+    if (!trace.open(traceFile, static_cast<uint32_t>(numVehicles), static_cast<uint32_t>(numChargers), simHours, seed)) {
+        std::cerr << "Error: Could not open trace file " << traceFile << ", per-vehicle lines go to the report\n";
+        traceFormat = TraceFormat::Text;
+        return false;
+    }
+    return true;
+}
 
-    logger.logLine(2, logger.formatFixedWidth("Vehicle " + std::to_string(vehicle->getId()) + " (" + vehicle->getManufacturerString() + ")   ", 30) +
-                   "[" + logger.formatFixedWidth(vehicle->getStateString(), 8) + "]   " +
-                   "[" + logger.formatFixedWidth(batteryDisplay, 12) + "]   " +
-                   "Step: " + stepSection + " | Total: " + totalSection);
+void Simulation::traceStep(uint32_t step, double time) {
+    if (trace.isOpen()) {
+        EVTOL_PROFILE_SCOPE(profiler, Trace);
+        trace.beginStep(step, time);
+    }
 }
 
 void Simulation::showProgress(double currentTime, double totalTime) {
-    const int barWidth = 50;
+    if (!writeReport || !showProgressBar) {
+        return;
+    }
+
+    // The bar shows tenths of a percent, redrawing an unchanged bar is wasted output
     double progress = currentTime / totalTime;
+    int permille = static_cast<int>(progress * 1000.0);
+    if (permille == lastProgressPermille) {
+        return;
+    }
+    lastProgressPermille = permille;
+    EVTOL_PROFILE_SCOPE(profiler, Logging);
+
+    const int barWidth = 50;
     int pos = static_cast<int>(barWidth * progress);
 
-    std::cout << "\r[" << logger.getCurrentTimestamp() << "] [";
+    std::cout << "\r[" << Logger::currentTimestamp() << "] [";
     for (int i = 0; i < barWidth; ++i) {
         if (i < pos) std::cout << "=";
         else if (i == pos) std::cout << ">";
@@ -280,6 +1284,52 @@ void Simulation::showProgress(double currentTime, double totalTime) {
     std::cout.flush();
 }
 
+void Simulation::publishMetrics(bool done) {
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - lastMetricsTime).count();
+    double stepsPerSecond = interval > 0 ? (stepCount - lastMetricsStep) / interval : 0.0;
+
+    MetricsSnapshot snapshot{};
+    snapshot.simTime = currentTime;
+    snapshot.simHours = simHours;
+    snapshot.steps = static_cast<uint64_t>(stepCount);
+    snapshot.wallSeconds = std::chrono::duration<double>(now - metricsStart).count();
+    snapshot.stepsPerSecond = stepsPerSecond;
+    snapshot.numVehicles = static_cast<uint32_t>(vehicles.size());
+    snapshot.numChargers = static_cast<uint32_t>(numChargers);
+    snapshot.chargersBusy = static_cast<uint32_t>(numChargers - vertiports.getFreeChargerCount());
+    snapshot.queueLength = static_cast<uint32_t>(vertiports.getQueueLength());
+    snapshot.done = done ? 1 : 0;
+    for (const auto& pair : typeStats) {
+        const auto& stats = pair.second;
+        auto& totals = snapshot.types[static_cast<size_t>(pair.first)];
+        totals.vehicles = static_cast<uint32_t>(stats.vehicleCount);
+        totals.flights = static_cast<uint64_t>(stats.totalFlights);
+        totals.charges = static_cast<uint64_t>(stats.totalCharges);
+        totals.faults = static_cast<uint64_t>(stats.totalFaults);
+        totals.flightTime = stats.totalFlightTime;
+        totals.distance = stats.totalDistance;
+        totals.chargingTime = stats.totalChargingTime;
+        totals.queuedTime = stats.totalQueuedTime;
+        totals.passengerMiles = stats.totalPassengerMiles;
+    }
+    // Parked vehicles are settled when they leave, add the queued time they have so far
+    for (size_t index = 0; index < parkedSince.size(); ++index) {
+        if (isParked(index) && getVehicleState(index) == Vehicle::State::Queued) {
+            snapshot.types[static_cast<size_t>(vehicles[index]->getManufacturer())].queuedTime += currentTime - parkedSince[index];
+        }
+    }
+    metrics->publish(snapshot);
+
+    // Aim for one snapshot every METRICS_PUBLISH_SECONDS without reading the clock every step
+    if (interval > 0) {
+        lastMetricsTime = now;
+        lastMetricsStep = stepCount;
+    }
+    int stride = static_cast<int>(std::min(stepsPerSecond * METRICS_PUBLISH_SECONDS, 1e9));
+    nextMetricsStep = stepCount + std::max(1, stride);
+}
+
 void Simulation::printInitialStatus() {
 
     logger.logSectionDivider("eVTOL Simulation START");
@@ -288,10 +1338,32 @@ void Simulation::printInitialStatus() {
     logger.logLine("  Number of vehicles: " + std::to_string(numVehicles));
     logger.logLine("  Simulation hours: " + std::to_string(simHours));
     logger.logLine("  Number of chargers: " + std::to_string(numChargers));
+    if (numVertiports > 1) {
+        logger.logLine("  Vertiports: " + std::to_string(numVertiports));
+    }
+    if (vertiports.getPolicy() != DEFAULT_DISPATCH_POLICY) {
+        logger.logLine("  Dispatch policy: " + dispatchPolicyToString(vertiports.getPolicy()));
+    }
     logger.logLine("  Time step: " + std::to_string(simTimeStepSeconds) + " seconds (" +
                                      std::to_string(simTimeStepSeconds / 3600.0) + " hours)");
     logger.logLine("  Log verbosity level: " + std::to_string(simLogVerbosity));
-    logger.logLine("  Vehicle selection: " + std::string(randomizeVehicles ? "Random" : "Equal distribution"));
+    logger.logLine("  Engine: " + engineToString(engine));
+    logger.logLine("  Threads: " + std::to_string(numThreads));
+    logger.logLine("  Seed: " + std::to_string(seed));
+    logger.logLine("  Fault model: " + faultModelToString(getEffectiveFaultModel()));
+    logger.logLine("  Trace format: " + traceFormatToString(traceFormat));
+    if (checkpointInterval > 0) {
+        logger.logLine("  Checkpoints: every " + std::to_string(checkpointInterval) + " hours to " + checkpointFile);
+    }
+    if (resumeState) {
+        logger.logLine("  Resumed at: " + std::to_string(resumeState->currentTime) + " hours (step " +
+                       std::to_string(resumeState->stepCount) + ")");
+    }
+    if (engine == SimulationEngine::StructOfArrays) {
+        logger.logLine("  Kernel: " + kernelIsaToString(getKernelIsa()));
+    }
+    logger.logLine("  Vehicle selection: " + std::string(!fleetTypes.empty() ? "Fleet composition" :
+                                                         randomizeVehicles ? "Random" : "Equal distribution"));
     logger.logLine();
 
     logger.logLine("Initial Status:");
@@ -342,6 +1414,84 @@ void Simulation::printStatsTable() {
     logger.logLine(separator);
 }
 
+void Simulation::printProfileTable() {
+    logger.logLine();
+    logger.logSectionDivider("Simulation Profile", true);
+
+    const int colWidth = 12;
+    const int nameWidth = 18;
+    const double total = profiler.getTotalSeconds();
+    auto share = [total](double seconds) { return std::to_string(total > 0 ? 100.0 * seconds / total : 0.0); };
+    std::string separator(nameWidth + 2 + 4*(colWidth + 3), '-');
+
+    logger.logLine();
+    logger.logLine(separator);
+    logger.log(logger.formatFixedWidth("Phase",              nameWidth) + " | ");
+    logger.log(logger.formatFixedWidth("Category",           colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("Time (s)",           colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("Share (%)",          colWidth) + " | ", false);
+    logger.logLine(logger.formatFixedWidth("Calls",          colWidth) + " | ", false);
+    logger.logLine(separator);
+
+    for (size_t i = 0; i < Profiler::NUM_PHASES; ++i) {
+        auto phase = static_cast<Profiler::Phase>(i);
+        double seconds = profiler.getSeconds(phase);
+        logger.log(logger.formatFixedWidth(Profiler::getPhaseName(phase),                           nameWidth) + " | ");
+        logger.log(logger.formatFixedWidth(Profiler::getCategoryName(Profiler::getCategory(phase)), colWidth) + " | ", false);
+        logger.log(logger.formatFixedWidth(std::to_string(seconds),                                 colWidth) + " | ", false);
+        logger.log(logger.formatFixedWidth(share(seconds),                                          colWidth) + " | ", false);
+        logger.logLine(logger.formatFixedWidth(std::to_string(profiler.getCalls(phase)),            colWidth) + " | ", false);
+    }
+    logger.logLine(separator);
+
+    for (auto category : {Profiler::Category::Physics, Profiler::Category::Scheduling,
+                          Profiler::Category::IO, Profiler::Category::Other}) {
+        double seconds = profiler.getCategorySeconds(category);
+        logger.logLine("  " + Profiler::getCategoryName(category) + ": " + std::to_string(seconds) +
+                       " s (" + share(seconds) + "%)");
+    }
+    for (size_t i = 0; i < Profiler::NUM_COUNTERS; ++i) {
+        auto counter = static_cast<Profiler::Counter>(i);
+        logger.logLine("  " + Profiler::getCounterName(counter) + ": " + std::to_string(profiler.getCount(counter)));
+    }
+}
+
+void Simulation::writeProfile() {
+    if (profileFile.empty()) {
+        return;
+    }
+    std::ofstream file(profileFile);
+    if (!file) {
+        std::cerr << "\nError: Could not write profile " << profileFile << "\n";
+        return;
+    }
+    profiler.writeJson(file);
+}
+
+void Simulation::writeTimeSeries() {
+    if (timeSeriesFile.empty()) {
+        return;
+    }
+    std::ofstream file(timeSeriesFile);
+    if (!file) {
+        std::cerr << "\nError: Could not write time series " << timeSeriesFile << "\n";
+        return;
+    }
+
+    // Every window of the run that is still in the ring, minutes without charging are 0
+    const double interval = chargerUtilization.getInterval();
+    const uint64_t windows = static_cast<uint64_t>(std::ceil(currentTime / interval - 1e-9));
+    file << "window_start_hours,charger_hours,charger_utilization\n";
+    file << std::setprecision(10);
+    for (uint64_t window = chargerUtilization.getFirstWindow(); window < windows; ++window) {
+        uint64_t offset = window - chargerUtilization.getFirstWindow();
+        double hours = offset < chargerUtilization.size() ? chargerUtilization.getValue(offset) : 0.0;
+        double length = std::min(interval, currentTime - static_cast<double>(window) * interval);
+        file << static_cast<double>(window) * interval << "," << hours << ","
+             << (numChargers > 0 && length > 0 ? hours / (numChargers * length) : 0.0) << "\n";
+    }
+}
+
 void Simulation::printFinalStatus() {
 
     logger.logLine();
@@ -352,47 +1502,68 @@ void Simulation::printFinalStatus() {
 
     logger.logLine("Outputs:");
     logger.logLine("  Log File: " + logger.getLogFile());
+    if (traceFormat == TraceFormat::Binary) {
+        logger.logLine("  Trace File: " + traceFile);
+    }
+    if (Profiler::ENABLED && !profileFile.empty()) {
+        logger.logLine("  Profile File: " + profileFile);
+    }
+    if (!metricsFile.empty()) {
+        logger.logLine("  Metrics File: " + metricsFile);
+    }
+    if (!timeSeriesFile.empty()) {
+        logger.logLine("  Time Series File: " + timeSeriesFile);
+    }
     logger.logLine();
 
     logger.logSectionDivider("eVTOL Simulation DONE");
 }
 
 void Simulation::printChargingQueue() {
-    logger.log(2, "Charging Queue: [");
-
-    std::queue<Vehicle*> tempQueue = chargingQueue;
-    bool first = true;
-
-    while (!tempQueue.empty()) {
-        if (!first) {
-            logger.log(2, ", ", false);
+    EVTOL_PROFILE_SCOPE(profiler, Logging);
+    // Copying the queue is only worth it if the line will be logged
+    logger.logLineLazy(2, [&]() {
+        std::string line = "Charging Queue: [";
+        bool first = true;
+
+        // Site after site, with the site of each vehicle once there is more than one
+        for (int site = 0; site < vertiports.getSiteCount(); ++site) {
+            for (const auto& entry : vertiports.getQueue(site)) {
+                if (!first) {
+                    line += ", ";
+                }
+                line += "Vehicle " + std::to_string(vehicles[entry.handle]->getId());
+                if (numVertiports > 1) {
+                    line += " at site " + std::to_string(site);
+                }
+                first = false;
+            }
         }
-        Vehicle* vehicle = tempQueue.front();
-        tempQueue.pop();
-        logger.log(2, "Vehicle " + std::to_string(vehicle->getId()), false);
-        first = false;
-    }
 
-    logger.logLine(2, "]", false);
+        return line + "]";
+    });
 }
 
 void Simulation::printChargingStations() {
-    logger.log(2, "Charging Stations: ");
+    EVTOL_PROFILE_SCOPE(profiler, Logging);
+    logger.logLineLazy(2, [&]() {
+        std::string line = "Charging Stations: ";
 
-    for (int i = 0; i < numChargers; i++) {
+        for (int i = 0; i < numChargers; i++) {
 
-        if (chargingStations[i] == nullptr) {
-            logger.log(2, "[--]", false);
-        } else {
-            logger.log(2, "[Vehicle " + std::to_string(chargingStations[i]->getId()) + "]", false);
-        }
+            if (chargingStations[i] == nullptr) {
+                line += "[--]";
+            } else {
+                line += "[Vehicle " + std::to_string(chargingStations[i]->getId()) + "]";
+            }
 
-        if (i < numChargers - 1) {
-            logger.log(2, " ", false);
+            if (i < numChargers - 1) {
+                line += " ";
+            }
         }
-    }
 
-    logger.logLine(2, "", false);
+        return line;
+    });
 }
 
 void Simulation::printFaultStatsTable() {
@@ -434,3 +1605,59 @@ void Simulation::printFaultStatsTable() {
     }
     logger.logLine(separator);
 }
+
+void Simulation::printSessionTable() {
+    logSessionTable(logger, typeStats);
+}
+
+void logSessionTable(Logger& logger, const VehicleTypeStatsTable& typeStats) {
+    logger.logLine();
+    logger.logSectionDivider("Session Durations by Vehicle Type", true);
+
+    // Table header, durations in minutes
+    const int colWidth = 12;
+    const int numColumns = 8;
+    std::string separator(colWidth + 3 + numColumns*(colWidth + 3), '-');
+    const double minutes = 60.0;
+    logger.logLine();
+    logger.logLine(separator);
+    logger.log(logger.formatFixedWidth("Vehicle", colWidth) + " | ");
+    logger.log(logger.formatFixedWidth("Session", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("Count", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("Mean", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("Std Dev", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("p50", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("p95", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("p99", colWidth) + " | ", false);
+    logger.logLine(logger.formatFixedWidth("Max", colWidth) + " | ", false);
+
+    logger.log(logger.formatFixedWidth("Type", colWidth) + " | ");
+    logger.log(logger.formatFixedWidth("", colWidth) + " | ", false);
+    logger.log(logger.formatFixedWidth("", colWidth) + " | ", false);
+    for (int i = 0; i < numColumns - 3; ++i) {
+        logger.log(logger.formatFixedWidth("(min)", colWidth) + " | ", false);
+    }
+    logger.logLine(logger.formatFixedWidth("(min)", colWidth) + " | ", false);
+
+    logger.logLine(separator);
+
+    for (const auto& pair : typeStats) {
+        const auto& stats = pair.second;
+        const std::pair<const char*, const StreamingDistribution*> sessions[] = {
+            {"Queue Wait", &stats.queueWaitTimes}, {"Charge", &stats.chargeTimes}, {"Flight", &stats.flightTimes}};
+        for (const auto& session : sessions) {
+            const StreamingDistribution& distribution = *session.second;
+            const RunningMoments& moments = distribution.getMoments();
+            logger.log(logger.formatFixedWidth(stats.manufacturerName, colWidth) + " | ");
+            logger.log(logger.formatFixedWidth(session.first, colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(distribution.getCount()), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(moments.getMean() * minutes), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(moments.getStdDev() * minutes), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(distribution.quantile(0.50) * minutes), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(distribution.quantile(0.95) * minutes), colWidth) + " | ", false);
+            logger.log(logger.formatFixedWidth(std::to_string(distribution.quantile(0.99) * minutes), colWidth) + " | ", false);
+            logger.logLine(logger.formatFixedWidth(std::to_string(moments.getMax() * minutes), colWidth) + " | ", false);
+        }
+    }
+    logger.logLine(separator);
+}
@@ -11,15 +11,34 @@
 #define SIMULATION_HPP
 
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <vector>
+#include <memory>
 #include <queue>
+#include <deque>
 #include <map>
-#include <unordered_set>
+#include <memory_resource>
+#include <unordered_map>
+#include <functional>
+#include <utility>
+#include <stdexcept>
+#include <string>
 
 #include "vehicle.hpp"
+#include "vehicle_registry.hpp"
+#include "fleet_soa.hpp"
 #include "logger.hpp"
+#include "thread_pool.hpp"
+#include "counter_rng.hpp"
+#include "trace.hpp"
+#include "profiler.hpp"
+#include "metrics.hpp"
+#include "vertiport.hpp"
+#include "streaming_stats.hpp"
 
-#include <gtest/gtest_prod.h>
+#include "test_access.hpp"
 
 const int DEFAULT_NUM_VEHICLES = 20; // Default number of vehicles to create
 const int DEFAULT_HRS_SIM = 3; // Default hours for simulation
@@ -27,8 +46,38 @@ const int DEFAULT_CHARGERS = 3; // Default number of charging stations
 const double DEFAULT_TIME_STEP_SECONDS = 1; //  Default time step in seconds
 const double SECONDS_TO_HOURS = 1/3600.0; // Conversion factor from seconds to hours
 const int DEFAULT_VERBOSITY = 1; // Default verbosity level for logging
+const int DEFAULT_THREADS = 1; // Default number of threads used to update vehicles
+const size_t VEHICLES_PER_CHUNK = 1024; // Vehicles per work chunk, fixed so results do not depend on the thread count
+const size_t MAX_PARKED_GAP = 32; // Parked vehicles the soa engine steps over to keep active ones in one span
+const std::string DEFAULT_CHECKPOINT_FILE = "output/eVTOL_sim_checkpoint.bin"; // Default checkpoint file
+const double ADAPTIVE_STEP_MARGIN_HOURS = 1e-9; // Adaptive steps end just past the transition they target
+const double METRICS_PUBLISH_SECONDS = 0.1; // Wall time between metrics snapshots of a running simulation
+const int SIMULATION_RESULTS_VERSION = 2; // Bump whenever a change alters simulation results, invalidates cached sweep results
 
-const int NUM_VEHICLE_TYPES = static_cast<int>(Vehicle::Manufacturer::NumManufacturers); // Number of different vehicle types
+/**
+ * @brief Engine used to advance simulation time.
+ */
+enum class SimulationEngine {
+    FixedStep,      // Advance every vehicle by a fixed time step (default, reference engine)
+    EventDriven,    // Jump directly between vehicle transitions using a priority queue
+    StructOfArrays, // Fixed time step over the contiguous FleetSoA store
+    Adaptive        // Fixed step loop with steps sized to reach the next vehicle transition
+};
+
+const SimulationEngine DEFAULT_ENGINE = SimulationEngine::FixedStep; // Default simulation engine
+const Vehicle::FaultModel DEFAULT_FAULT_MODEL = Vehicle::FaultModel::PerStep; // Default fault model for the stepping engines
+
+std::string engineToString(SimulationEngine engine);
+bool engineFromString(const std::string& name, SimulationEngine& engine);
+
+/**
+ * @brief Vehicle type of every vehicle of a fleet composition, in creation order.
+ *
+ * Vehicles take the types in turn, a type drops out once its count is used up, so equal
+ * counts give the round-robin fleet of randomizeVehicles = false.
+ * @param counts Vehicles per type id.
+ */
+std::vector<int> expandFleetComposition(const std::vector<int>& counts);
 
 // Structure to hold aggregated statistics per vehicle type
 struct VehicleTypeStats {
@@ -40,10 +89,16 @@ struct VehicleTypeStats {
     double totalFlightTime = 0.0;
     double totalDistance = 0.0;
     double totalChargingTime = 0.0;
+    double totalQueuedTime = 0.0;
     int totalFaults = 0;
     double totalPassengerMiles = 0.0;
     double expectedFaultRate = 0.0; // Expected fault rate per hour
 
+    // Durations of the completed sessions [hours], sessions still open at the end are not included
+    StreamingDistribution queueWaitTimes;  // Queued until a charger was handed over
+    StreamingDistribution chargeTimes;     // Charging sessions
+    StreamingDistribution flightTimes;     // Flights, until the battery ran out or a fault
+
     double getActualFaultRate() const {
         return (totalFlightTime > 0) ? (static_cast<double>(totalFaults) / totalFlightTime) : 0.0;
     }
@@ -60,6 +115,21 @@ struct VehicleTypeStats {
         return totalCharges > 0 ? totalChargingTime / totalCharges : 0.0;
     }
 
+    // Add the accumulated counters of another partial result (vehicle count and names are not touched)
+    void add(const VehicleTypeStats& other) {
+        totalFlights += other.totalFlights;
+        totalCharges += other.totalCharges;
+        totalFlightTime += other.totalFlightTime;
+        totalDistance += other.totalDistance;
+        totalChargingTime += other.totalChargingTime;
+        totalQueuedTime += other.totalQueuedTime;
+        totalFaults += other.totalFaults;
+        totalPassengerMiles += other.totalPassengerMiles;
+        queueWaitTimes.merge(other.queueWaitTimes);
+        chargeTimes.merge(other.chargeTimes);
+        flightTimes.merge(other.flightTimes);
+    }
+
     void reset() {
         vehicleCount = 0;
         totalFlights = 0;
@@ -67,8 +137,12 @@ struct VehicleTypeStats {
         totalFlightTime = 0.0;
         totalDistance = 0.0;
         totalChargingTime = 0.0;
+        totalQueuedTime = 0.0;
         totalFaults = 0;
         totalPassengerMiles = 0.0;
+        queueWaitTimes.clear();
+        chargeTimes.clear();
+        flightTimes.clear();
     }
 
     std::string toString() const {
@@ -79,12 +153,98 @@ struct VehicleTypeStats {
                ", Flight Time: " + std::to_string(totalFlightTime) +
                ", Distance: " + std::to_string(totalDistance) +
                ", Charging Time: " + std::to_string(totalChargingTime) +
+               ", Queued Time: " + std::to_string(totalQueuedTime) +
                ", Faults: " + std::to_string(totalFaults) +
                ", Passenger Miles: " + std::to_string(totalPassengerMiles);
     }
 
 };
 
+/**
+ * @brief Statistics per vehicle type in a flat table indexed by type id.
+ *
+ * Drop-in for the std::map it replaces: iteration visits the types with statistics in
+ * ascending id order as (type, statistics) pairs, but a lookup is an array index instead of
+ * a tree walk. Adding a type invalidates references into the table.
+ */
+class VehicleTypeStatsTable {
+public:
+    using value_type = std::pair<Vehicle::Manufacturer, VehicleTypeStats>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    /**
+     * @brief Statistics of a type, empty statistics are added for a type seen the first time.
+     * @throws std::out_of_range for an id past MAX_VEHICLE_TYPES.
+     */
+    VehicleTypeStats& operator[](Vehicle::Manufacturer type) {
+        auto id = static_cast<size_t>(type);
+        if (id >= MAX_VEHICLE_TYPES) {
+            throw std::out_of_range("Vehicle type id past MAX_VEHICLE_TYPES");
+        }
+        if (slots[id] != 0) {
+            return entries[slots[id] - 1].second;
+        }
+
+        // New types are rare (once per type and run), keep the entries sorted and renumber the slots
+        auto position = std::lower_bound(entries.begin(), entries.end(), type,
+                                         [](const value_type& entry, Vehicle::Manufacturer id) { return entry.first < id; });
+        position = entries.insert(position, {type, VehicleTypeStats{}});
+        for (size_t i = 0; i < entries.size(); ++i) {
+            slots[static_cast<size_t>(entries[i].first)] = static_cast<uint8_t>(i + 1);
+        }
+        return position->second;
+    }
+
+    /**
+     * @throws std::out_of_range if the type has no statistics.
+     */
+    VehicleTypeStats& at(Vehicle::Manufacturer type) {
+        if (!contains(type)) {
+            throw std::out_of_range("No statistics for this vehicle type");
+        }
+        return entries[slot(type) - 1].second;
+    }
+    const VehicleTypeStats& at(Vehicle::Manufacturer type) const {
+        if (!contains(type)) {
+            throw std::out_of_range("No statistics for this vehicle type");
+        }
+        return entries[slot(type) - 1].second;
+    }
+
+    iterator find(Vehicle::Manufacturer type) { return contains(type) ? entries.begin() + slot(type) - 1 : entries.end(); }
+    const_iterator find(Vehicle::Manufacturer type) const { return contains(type) ? entries.begin() + slot(type) - 1 : entries.end(); }
+    bool contains(Vehicle::Manufacturer type) const { return slot(type) != 0; }
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    void clear() {
+        entries.clear();
+        slots.fill(0);
+    }
+
+    iterator begin() { return entries.begin(); }
+    iterator end() { return entries.end(); }
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+private:
+    size_t slot(Vehicle::Manufacturer type) const {
+        auto id = static_cast<size_t>(type);
+        return id < MAX_VEHICLE_TYPES ? slots[id] : 0;
+    }
+
+    std::vector<value_type> entries;             // Sorted by type id
+    std::array<uint8_t, MAX_VEHICLE_TYPES> slots{}; // Index into entries + 1 per type id, 0 = no statistics
+};
+
+/**
+ * @brief Log the session duration percentiles (queue wait, charge, flight) of every vehicle type.
+ */
+void logSessionTable(Logger& logger, const VehicleTypeStatsTable& typeStats);
+
+struct SimulationCheckpoint;
+
 class Simulation {
 public:
     Simulation(
@@ -93,17 +253,200 @@ public:
         int numChargers = DEFAULT_CHARGERS,
         double simTimeStepSeconds = DEFAULT_TIME_STEP_SECONDS,
         int simLogVerbosity = DEFAULT_VERBOSITY,
-        bool randomizeVehicles = true);
+        bool randomizeVehicles = true,
+        bool writeReport = false);
 
     ~Simulation() = default;
 
-    bool runSimulation(); // Main simulation loop
+    bool runSimulation(); // Main simulation loop, true once the run has completed
+
+    void setEngine(SimulationEngine engine) { this->engine = engine; }
+    SimulationEngine getEngine() const { return engine; }
+
+    /**
+     * @brief Number of threads used to update the vehicles (fixed and soa engines).
+     *
+     * Every vehicle has its own random number stream and vehicles are updated in
+     * fixed-size chunks whose partial statistics are merged in chunk order, so results
+     * for a given seed are the same for any thread count.
+     */
+    void setThreads(int threads) { numThreads = threads; }
+    int getThreads() const { return numThreads; }
+
+    /**
+     * @brief Spread the chargers over a number of vertiports (see vertiport.hpp).
+     *
+     * Vehicles start at site i % vertiports and land at another site after every flight,
+     * drawn from the vehicle's route stream, diverting to an alternate site if it has fewer
+     * vehicles waiting per free charger. A vehicle only charges at the site it landed at.
+     * One vertiport (the default) is the single shared charger pool.
+     *
+     * @throws std::runtime_error if there are fewer chargers than vertiports.
+     */
+    void setVertiports(int count);
+    int getVertiports() const { return numVertiports; }
+
+    /**
+     * @brief Order in which the vehicles waiting at a vertiport get its chargers (see vertiport.hpp).
+     */
+    void setDispatchPolicy(DispatchPolicy policy) { vertiports.setPolicy(policy); }
+    DispatchPolicy getDispatchPolicy() const { return vertiports.getPolicy(); }
+
+    /**
+     * @brief Create the fleet from a composition instead of random or round-robin types.
+     *
+     * The fleet is expanded here once (see expandFleetComposition), every run then creates
+     * its vehicles without any random draw. An empty composition restores randomizeVehicles.
+     * @param counts Vehicles per type id.
+     * @throws std::runtime_error for an unknown type, a negative count or a fleet that is not
+     *         the simulation's number of vehicles.
+     */
+    void setFleetComposition(const std::vector<int>& counts);
+    const std::vector<int>& getFleetComposition() const { return fleetComposition; }
+
+    /**
+     * @brief Seed for all random draws, runs with the same seed and inputs are identical.
+     *
+     * Defaults to a value from std::random_device chosen at construction.
+     */
+    void setSeed(uint64_t seed) { this->seed = seed; }
+    uint64_t getSeed() const { return seed; }
+
+    /**
+     * @brief Fault model of the fixed step and soa engines.
+     *
+     * The event and adaptive engines step to sampled fault times and always use
+     * Vehicle::FaultModel::Exponential.
+     */
+    void setFaultModel(Vehicle::FaultModel model) { faultModel = model; }
+    Vehicle::FaultModel getFaultModel() const { return faultModel; }
+    Vehicle::FaultModel getEffectiveFaultModel() const {
+        return (engine == SimulationEngine::EventDriven || engine == SimulationEngine::Adaptive)
+                   ? Vehicle::FaultModel::Exponential : faultModel;
+    }
+
+    /**
+     * @brief Where the per-vehicle step lines go.
+     *
+     * TraceFormat::Binary writes them to a trace file (see trace.hpp) for every step at any
+     * verbosity instead of to the text report. An empty filename uses
+     * output/eVTOL_sim_trace_<time>.evtrace.
+     */
+    void setTraceFormat(TraceFormat format, const std::string& filename = "") {
+        traceFormat = format;
+        traceFile = filename;
+    }
+    TraceFormat getTraceFormat() const { return traceFormat; }
+    const std::string& getTraceFile() const { return traceFile; }
+
+    /**
+     * @brief Write a checkpoint (see checkpoint.hpp) every interval simulation hours.
+     *
+     * Each checkpoint replaces the previous one in the file. An interval of 0 (the
+     * default) disables checkpoints.
+     */
+    void setCheckpointInterval(double hours, const std::string& filename = DEFAULT_CHECKPOINT_FILE) {
+        checkpointInterval = hours;
+        checkpointFile = filename;
+    }
+    double getCheckpointInterval() const { return checkpointInterval; }
+
+    /**
+     * @brief Continue the next runSimulation() from a checkpoint instead of from the start.
+     *
+     * The simulation must have the checkpoint's number of vehicles, chargers and engine.
+     * The simulation hours, seed and time step may differ to fork what-if runs from one
+     * warmed-up state: a different seed re-keys the random streams from the checkpoint on.
+     *
+     * @return False if the checkpoint does not fit this simulation.
+     */
+    bool resumeFrom(const SimulationCheckpoint& checkpoint);
+
+    /**
+     * @brief Snapshot of the current state, between steps or after runSimulation().
+     */
+    SimulationCheckpoint createCheckpoint() const;
+
+    /**
+     * @brief Also write the profile of the run (see profiler.hpp) as JSON to a file.
+     *
+     * Only builds with EVTOL_PROFILING profile, the profile is then printed after the
+     * results table of every run.
+     */
+    void setProfileFile(const std::string& filename) { profileFile = filename; }
+
+    /**
+     * @brief Publish live metrics of the run to a file (see metrics.hpp).
+     *
+     * The file is rewritten every interval milliseconds in the Prometheus text format. An
+     * empty filename (the default) disables metrics.
+     */
+    void setMetricsFile(const std::string& filename, int intervalMs = DEFAULT_METRICS_INTERVAL_MS) {
+        metricsFile = filename;
+        metricsIntervalMs = intervalMs;
+    }
+
+    /**
+     * @brief Skip faulted vehicles and queued vehicles without a charger in the stepping engines.
+     *
+     * Such vehicles only accumulate faulted or queued time. With fast-forward (the default)
+     * the fixed step, adaptive and soa engines park them out of the set of vehicles they
+     * update and add their time at once when they get a charger, when the run ends or when
+     * live metrics are published, so a step costs time in the vehicles that change. The
+     * results are those of stepping every vehicle up to floating point rounding. Runs that
+     * log or trace every vehicle every step (verbosity 2, binary trace) step every vehicle.
+     * The event engine never touches waiting vehicles.
+     */
+    void setFastForward(bool enabled) { fastForwardEnabled = enabled; }
+    bool getFastForward() const { return fastForwardEnabled; }
+
+    // Console progress bar of runs that write a report (default: on)
+    void setShowProgress(bool show) { showProgressBar = show; }
+    const Profiler& getProfiler() const { return profiler; }
+
+    Logger& getLogger() { return logger; }
+
+    // Aggregated statistics per vehicle type, complete once runSimulation() returns
+    const VehicleTypeStatsTable& getTypeStats() const { return typeStats; }
+
+    /**
+     * @brief Charger hours spent charging in every minute of the run.
+     *
+     * Divided by the chargers and the window length this is the charger utilization per
+     * minute. Windows after the last charging minute are not in the series.
+     */
+    const FixedIntervalSeries& getChargerUtilization() const { return chargerUtilization; }
+
+    /**
+     * @brief Also write the charger utilization per minute as CSV to a file at the end of the run.
+     */
+    void setTimeSeriesFile(const std::string& filename) { timeSeriesFile = filename; }
+
+    // Longest charging queue of the last run (since the resume for a resumed run)
+    size_t getMaxQueueLength() const { return maxQueueLength; }
+    size_t getQueueLength() const { return vertiports.getQueueLength(); }
+    double getCurrentTime() const { return currentTime; }
+    int getStepCount() const { return stepCount; }
 
     // Allow access to private members for testing
-    FRIEND_TEST(SimulationTest, Initialization);
-    FRIEND_TEST(SimulationTest, CreateVehicles);
-    FRIEND_TEST(SimulationTest, TimeStep);
-    FRIEND_TEST(SimulationTest, ChargingQueue);
+    EVTOL_FRIEND_TEST(SimulationTest, Initialization);
+    EVTOL_FRIEND_TEST(SimulationTest, CreateVehicles);
+    EVTOL_FRIEND_TEST(SimulationTest, TimeStep);
+    EVTOL_FRIEND_TEST(SimulationTest, ChargingQueue);
+    EVTOL_FRIEND_TEST(SimulationTest, ChargerBookkeeping);
+    EVTOL_FRIEND_TEST(SimulationTest, TimeAccounting);
+    EVTOL_FRIEND_TEST(SimulationTest, TransitionCounts);
+    EVTOL_FRIEND_TEST(SimulationTest, EventEngineTimeAccounting);
+    EVTOL_FRIEND_TEST(SimulationTest, AdaptiveEngineSkipsQuiescentSteps);
+    EVTOL_FRIEND_TEST(SimulationTest, SoaEngineMatchesFixedStep);
+    EVTOL_FRIEND_TEST(SimulationTest, ThreadCountDoesNotChangeResults);
+    EVTOL_FRIEND_TEST(SimulationTest, SeedReproducesRun);
+    EVTOL_FRIEND_TEST(SimulationTest, VertiportsChargeLandedVehicles);
+    EVTOL_FRIEND_TEST(SimulationTest, DispatchPolicies);
+    EVTOL_FRIEND_TEST(SimulationTest, FastForwardParksWaitingVehicles);
+
+    // Allow the benchmarks (bench/) to time single steps
+    friend class SimulationBenchmark;
 
 private:
     // Configuration
@@ -113,44 +456,189 @@ private:
     double simTimeStepSeconds;
     int simLogVerbosity;
     bool randomizeVehicles;
-    StdRandomGenerator rng;
+    std::vector<int> fleetComposition; // Vehicles per type id, empty = randomizeVehicles decides
+    std::vector<int> fleetTypes;       // fleetComposition expanded, the type of every vehicle
+    bool writeReport; // False: no output directory, log file, console report or progress
+    SimulationEngine engine = DEFAULT_ENGINE;
+    int numThreads = DEFAULT_THREADS;
+    int numVertiports = DEFAULT_VERTIPORTS;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+    TraceFormat traceFormat = TraceFormat::Text;
+    std::string traceFile;
+    double checkpointInterval = 0.0;
+    std::string checkpointFile = DEFAULT_CHECKPOINT_FILE;
+    double nextCheckpointTime = 0.0;
+    std::shared_ptr<const SimulationCheckpoint> resumeState; // Restored by the next run
+    uint64_t seed;
+    CounterRandomGenerator rng; // Simulation stream (fleet composition)
 
     double currentTime;
     double timeStep;
     int stepCount;
 
+    // Per-simulation arena behind the vehicles, the vertiport and event queues and the vehicle
+    // index. Blocks freed during a run are pooled for the next run, all memory is handed back
+    // at once when the simulation is destroyed. Only allocated from the simulation thread.
+    std::pmr::unsynchronized_pool_resource arena;
+
+    // Vehicles are constructed in arena blocks, deleting one returns its block to the arena
+    struct ArenaDelete {
+        std::pmr::memory_resource* resource = nullptr;
+        void operator()(Vehicle* vehicle) const;
+    };
+    using VehiclePtr = std::unique_ptr<Vehicle, ArenaDelete>;
+
     // Simulation state
-    std::vector<std::unique_ptr<Vehicle>> vehicles;
-    std::queue<Vehicle*> chargingQueue;
-    std::unordered_set<Vehicle*> queuedVehicles;
+    std::vector<VehiclePtr> vehicles;
+    VertiportNetwork vertiports{&arena};    // Charging queue and free chargers of every site
     std::vector<Vehicle*> chargingStations; // nullptr = available, Vehicle* = occupied
+    std::vector<int> vehicleCharger;        // Charger held by each vehicle (-1 = none)
+    std::vector<int> vehicleSite;           // Vertiport each vehicle is at, or last left
+    size_t maxQueueLength = 0;              // Longest charging queue so far, summed over the sites
+    std::pmr::unordered_map<const Vehicle*, size_t> vehicleIndex{&arena}; // Vehicle to index into vehicles
+
+    // Charging transitions reported while a chunk is updated, drained in chunk order so the
+    // queue only sees the vehicles that changed instead of a scan of the whole fleet
+    struct ChunkTransitions {
+        std::vector<size_t> queued;       // Vehicles that became Queued
+        std::vector<size_t> doneCharging; // Vehicles that left Charging, their charger is freed next step
+    };
+    std::vector<ChunkTransitions> chunkTransitions;
+
+    // Flight, queued and charging totals of each vehicle when its open sessions started, a
+    // session's duration is the growth of the total when it completes [hours]
+    struct SessionClock {
+        double flight = 0.0;
+        double queued = 0.0;
+        double charging = 0.0;
+    };
+    std::vector<SessionClock> sessionClocks;
+    FixedIntervalSeries chargerUtilization; // Charger hours per minute
+
+    // Vehicles the stepping engines update, ascending. Faulted vehicles and queued vehicles
+    // without a charger are parked out of it after a step, their time is settled from
+    // parkedSince when they leave (a charger is handed over) and at the end of the run.
+    bool fastForwardEnabled = true;
+    bool fastForward = false;            // Parking in this run
+    std::vector<size_t> activeVehicles;
+    std::vector<size_t> unparkedVehicles; // Handed a charger this step, rejoin activeVehicles
+    std::vector<double> parkedSince;      // Time each parked vehicle is settled to, < 0 while active [hours]
+
+    std::vector<CounterRandomGenerator> vehicleRngs; // Random number stream per vehicle
+
+    // Work chunks of VEHICLES_PER_CHUNK vehicles
+    std::vector<std::vector<VehicleTypeStats>> chunkTypeStats; // Partial statistics per chunk, indexed by type
+    std::unique_ptr<ThreadPool> threadPool; // Only created when more than one thread is used
+
+    // Structure-of-arrays engine state, vehicles are only synced from the fleet for logging
+    FleetSoA fleet;
+
+    // Event-driven engine state
+    struct VehicleEvent {
+        double time;            // Simulation time of the next transition [hours]
+        unsigned long sequence; // Tie breaker so equal times are processed in scheduling order
+        size_t vehicleIndex;    // Index into vehicles
+
+        bool operator>(const VehicleEvent& other) const {
+            return (time != other.time) ? (time > other.time) : (sequence > other.sequence);
+        }
+    };
+    using EventQueue = std::priority_queue<VehicleEvent, std::pmr::vector<VehicleEvent>, std::greater<VehicleEvent>>;
+    EventQueue eventQueue{std::greater<VehicleEvent>(), std::pmr::vector<VehicleEvent>(&arena)};
+    std::vector<double> lastUpdateTime; // Per vehicle time of last updateState call [hours]
+    unsigned long eventSequence = 0;
 
     // Logging
     Logger logger;
+    TraceWriter trace; // Only open while a binary trace is written
+    Profiler profiler; // Only used in builds with EVTOL_PROFILING
+    std::string profileFile;
+    std::string timeSeriesFile;
+    bool showProgressBar = true;
+    int lastProgressPermille = -1; // Last drawn progress, the bar is only redrawn when it changes
+
+    // Live metrics, only while a run with a metrics file is in progress
+    std::string metricsFile;
+    int metricsIntervalMs = DEFAULT_METRICS_INTERVAL_MS;
+    std::unique_ptr<MetricsExporter> metrics;
+    std::chrono::steady_clock::time_point metricsStart;
+    std::chrono::steady_clock::time_point lastMetricsTime;
+    int lastMetricsStep = 0;
+    int nextMetricsStep = 0;
 
     // Statistics tracking
-    std::map<Vehicle::Manufacturer, VehicleTypeStats> typeStats;
+    VehicleTypeStatsTable typeStats;
 
     // Helper methods
-    std::unique_ptr<Vehicle> createVehicle(int type);
+    VehiclePtr createVehicle(int type, RandomGenerator& rng = Vehicle::defaultRng());
     void initializeVehicles();
     void updateVehicleStats(Vehicle* vehicle);
+    void updateTypeStats(VehicleTypeStats& typeData, const VehicleStats& stepStats);
+    // Flights and charging sessions the vehicle completed in its last step go into typeData
+    void completeSessions(size_t index, const VehicleStats& stepStats, const VehicleStats& totalStats, VehicleTypeStats& typeData);
+    void endQueueWait(size_t index); // A charger was handed to the vehicle
+    // Chunks of VEHICLES_PER_CHUNK positions in activeVehicles
+    void forEachChunk(const std::function<void(size_t chunk, size_t begin, size_t end)>& task);
+    void mergeChunkStats();
+    void resetCharging();
+    void recordTransition(size_t chunk, size_t index, Vehicle::State previous, Vehicle::State current);
+    void occupyCharger(size_t index, int charger);
+    void releaseCharger(size_t index);
+    void landAtVertiport(size_t index);
+    int chooseLandingSite(size_t index) const;
     void manageCharging();
     void assignAvailableChargers();
     void processChargingVehicles();
     void updateAllVehicles(double timeStep);
+    bool isParked(size_t index) const { return parkedSince[index] >= 0; }
+    // The soa engine keeps the vehicle state in the fleet store
+    Vehicle::State getVehicleState(size_t index) const {
+        return (engine == SimulationEngine::StructOfArrays) ? fleet.getState(index) : vehicles[index]->getCurrentState();
+    }
+    void parkIdleVehicles();                       // After a step, at currentTime
+    void unparkVehicle(size_t index, double time); // Settles the vehicle, it is updated again from the next step
+    void unparkAll();                              // Settles every parked vehicle at currentTime
+    void settleParkedTime(size_t index, double time);
     double nextTimeStep() const;
+    double nextAdaptiveStep() const;
 
+    // Engines
+    void runFixedStepLoop();
+    void runEventLoop();
+    void runFleetLoop();
+    void loadFleet();
+    void updateFleet(double timeStep); // Same as updateAllVehicles for the soa engine
+    void updateFleetSpan(size_t chunk, const size_t* active, size_t count, double timeStep); // Sorted, within FLEET_BLOCK_SIZE indices
+    void advanceVehicleTo(size_t index, double time);
+    void scheduleNextTransition(size_t index, double time);
+    void dispatchChargers(double time);
 
+
+    void restoreCheckpoint(const SimulationCheckpoint& checkpoint);
+    // Write a checkpoint of the current state if the next step or event at time passes a checkpoint time
+    void writeCheckpointIfDue(double time);
+    bool openTrace();
+    void traceStep(uint32_t step, double time);
     void showProgress(double currentTime, double totalTime);
+    void publishMetrics(bool done = false);
+    // Cheap enough to call every step, publishes about every METRICS_PUBLISH_SECONDS
+    void publishMetricsIfDue() {
+        if (metrics && stepCount >= nextMetricsStep) {
+            publishMetrics();
+        }
+    }
 
     void printInitialStatus();
     void printChargingQueue();
     void printChargingStations();
     void printFinalStatus();
     void printStatsTable();
+    void printProfileTable();
+    void writeProfile();
     void printVehicleStats(const Vehicle* vehicle, const VehicleStats& stepStats, const VehicleStats& totalStat);
     void printFaultStatsTable();
+    void printSessionTable();
+    void writeTimeSeries();
 
 };
 
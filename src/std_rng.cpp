@@ -1,18 +1,33 @@
 #include "std_rng.hpp"
 #include <random>
+#include <limits>
 
-std::mt19937& StdRandomGenerator::getEngine() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    return gen;
+StdRandomGenerator::StdRandomGenerator() : engine(std::random_device{}()) {
+}
+
+StdRandomGenerator::StdRandomGenerator(uint32_t seed, uint32_t stream) {
+    this->seed(seed, stream);
+}
+
+void StdRandomGenerator::seed(uint32_t seed, uint32_t stream) {
+    std::seed_seq sequence{seed, stream};
+    engine.seed(sequence);
 }
 
 bool StdRandomGenerator::bernoulli(double p) {
     std::bernoulli_distribution d(p);
-    return d(getEngine());
+    return d(engine);
 }
 
 int StdRandomGenerator::uniformInt(int min, int max) {
     std::uniform_int_distribution<int> d(min, max);
-    return d(getEngine());
+    return d(engine);
+}
+
+double StdRandomGenerator::exponential(double rate) {
+    if (rate <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    std::exponential_distribution<double> d(rate);
+    return d(engine);
 }
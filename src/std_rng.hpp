@@ -2,15 +2,28 @@
 #define STD_RNG_HPP
 
 #include "interface_rng.hpp"
+#include <cstdint>
 #include <random>
 
+/**
+ * @brief RandomGenerator backed by std::mt19937.
+ *
+ * Each instance owns its engine, so separate instances can be used from separate
+ * threads. Seeding with a (seed, stream) pair gives independent reproducible streams.
+ */
 class StdRandomGenerator : public RandomGenerator {
 public:
+    StdRandomGenerator(); // Seeded from std::random_device
+    explicit StdRandomGenerator(uint32_t seed, uint32_t stream = 0);
+
+    void seed(uint32_t seed, uint32_t stream = 0);
+
     bool bernoulli(double p) override;
     int uniformInt(int min, int max) override;
+    double exponential(double rate) override;
 
 private:
-    static std::mt19937& getEngine();
+    std::mt19937 engine;
 };
 
 #endif
@@ -0,0 +1,263 @@
+/**
+ * @file streaming_stats.cpp
+ * @brief Implementation file for the streaming statistics accumulators
+ *
+ * See streaming_stats.hpp for class documentation.
+ */
+
+#include "streaming_stats.hpp"
+#include <algorithm>
+#include <cmath>
+
+/* RunningMoments */
+void RunningMoments::add(double value) {
+    count++;
+    double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+    if (count == 1) {
+        min = max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+}
+
+void RunningMoments::merge(const RunningMoments& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    // Chan et al. pairwise update
+    const double n = static_cast<double>(count);
+    const double m = static_cast<double>(other.count);
+    const double delta = other.mean - mean;
+    count += other.count;
+    mean += delta * m / (n + m);
+    m2 += other.m2 + delta * delta * n * m / (n + m);
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+double RunningMoments::getStdDev() const {
+    return std::sqrt(getVariance());
+}
+
+void RunningMoments::restore(uint64_t count, double mean, double m2, double min, double max) {
+    this->count = count;
+    this->mean = mean;
+    this->m2 = m2;
+    this->min = min;
+    this->max = max;
+}
+
+/* LogHistogram */
+uint32_t LogHistogram::bucketOf(double value) {
+    if (!(value >= MIN_VALUE)) {
+        return 0;
+    }
+    // value = MIN_VALUE * mantissa * 2^exponent with the mantissa in [0.5, 1)
+    int exponent = 0;
+    double mantissa = std::frexp(value / MIN_VALUE, &exponent);
+    uint32_t sub = std::min(static_cast<uint32_t>((mantissa - 0.5) * 2 * SUB_BUCKETS), SUB_BUCKETS - 1);
+    return 1 + static_cast<uint32_t>(exponent - 1) * SUB_BUCKETS + sub;
+}
+
+double LogHistogram::bucketLower(uint32_t bucket) {
+    if (bucket == 0) {
+        return 0.0;
+    }
+    uint32_t octave = (bucket - 1) / SUB_BUCKETS;
+    uint32_t sub = (bucket - 1) % SUB_BUCKETS;
+    return std::ldexp(MIN_VALUE * (1.0 + static_cast<double>(sub) / SUB_BUCKETS), static_cast<int>(octave));
+}
+
+double LogHistogram::bucketUpper(uint32_t bucket) {
+    if (bucket == 0) {
+        return MIN_VALUE;
+    }
+    uint32_t octave = (bucket - 1) / SUB_BUCKETS;
+    uint32_t sub = (bucket - 1) % SUB_BUCKETS;
+    return std::ldexp(MIN_VALUE * (1.0 + static_cast<double>(sub + 1) / SUB_BUCKETS), static_cast<int>(octave));
+}
+
+void LogHistogram::add(double value, uint64_t count) {
+    addToBucket(bucketOf(value), count);
+    total += count;
+}
+
+void LogHistogram::addToBucket(uint32_t bucket, uint64_t count) {
+    auto it = std::lower_bound(indices.begin(), indices.end(), bucket);
+    size_t position = static_cast<size_t>(it - indices.begin());
+    if (it == indices.end() || *it != bucket) {
+        indices.insert(it, bucket);
+        counts.insert(counts.begin() + position, 0);
+    }
+    counts[position] += count;
+}
+
+void LogHistogram::merge(const LogHistogram& other) {
+    if (other.total == 0) {
+        return;
+    }
+    total += other.total;
+    if (other.indices.size() * 8 < indices.size()) {
+        // A few buckets, e.g. the samples of one step, are inserted in place
+        for (size_t i = 0; i < other.indices.size(); ++i) {
+            addToBucket(other.indices[i], other.counts[i]);
+        }
+        return;
+    }
+
+    std::vector<uint32_t> mergedIndices;
+    std::vector<uint64_t> mergedCounts;
+    mergedIndices.reserve(indices.size() + other.indices.size());
+    mergedCounts.reserve(indices.size() + other.indices.size());
+    size_t a = 0;
+    size_t b = 0;
+    while (a < indices.size() || b < other.indices.size()) {
+        if (b == other.indices.size() || (a < indices.size() && indices[a] < other.indices[b])) {
+            mergedIndices.push_back(indices[a]);
+            mergedCounts.push_back(counts[a++]);
+        } else if (a == indices.size() || other.indices[b] < indices[a]) {
+            mergedIndices.push_back(other.indices[b]);
+            mergedCounts.push_back(other.counts[b++]);
+        } else {
+            mergedIndices.push_back(indices[a]);
+            mergedCounts.push_back(counts[a++] + other.counts[b++]);
+        }
+    }
+    indices = std::move(mergedIndices);
+    counts = std::move(mergedCounts);
+}
+
+double LogHistogram::quantile(double q) const {
+    if (total == 0) {
+        return 0.0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return 0.5 * (bucketLower(indices[i]) + bucketUpper(indices[i]));
+        }
+    }
+    return bucketUpper(indices.back());
+}
+
+bool LogHistogram::restore(const std::vector<uint32_t>& indices, const std::vector<uint64_t>& counts) {
+    clear();
+    if (indices.size() != counts.size()) {
+        return false;
+    }
+    uint64_t sum = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (counts[i] == 0 || (i > 0 && indices[i] <= indices[i - 1])) {
+            return false;
+        }
+        sum += counts[i];
+    }
+    this->indices = indices;
+    this->counts = counts;
+    total = sum;
+    return true;
+}
+
+/* StreamingDistribution */
+double StreamingDistribution::quantile(double q) const {
+    if (getCount() == 0) {
+        return 0.0;
+    }
+    return std::clamp(histogram.quantile(q), moments.getMin(), moments.getMax());
+}
+
+/* FixedIntervalSeries */
+FixedIntervalSeries::FixedIntervalSeries(double intervalHours, size_t capacity)
+    : interval(intervalHours), capacity(std::max<size_t>(capacity, 1)) {}
+
+double& FixedIntervalSeries::window(uint64_t index) {
+    if (values.size() == capacity && index >= first + 2 * capacity) {
+        // Every kept window would be dropped, start the ring over
+        std::fill(values.begin(), values.end(), 0.0);
+        head = 0;
+        first = index - capacity + 1;
+    }
+    while (index >= first + values.size()) {
+        if (values.size() < capacity) {
+            values.push_back(0.0);
+        } else {
+            values[head] = 0.0;
+            head = (head + 1) % capacity;
+            first++;
+        }
+    }
+    return values[(head + (index - first)) % capacity];
+}
+
+void FixedIntervalSeries::add(double start, double duration, double amount) {
+    if (start < 0 || !(interval > 0)) {
+        return;
+    }
+    auto index = static_cast<uint64_t>(start / interval);
+    if (!(duration > 0)) {
+        if (index >= first) {
+            window(index) += amount;
+        }
+        return;
+    }
+
+    const double end = start + duration;
+    const double rate = amount / duration;
+    double from = start;
+    while (from < end) {
+        double to = std::min(end, static_cast<double>(index + 1) * interval);
+        if (to <= from) {
+            // Rounding put from at the end of its window
+            index++;
+            continue;
+        }
+        if (index >= first) {
+            window(index) += rate * (to - from);
+        }
+        from = to;
+        index++;
+    }
+}
+
+void FixedIntervalSeries::merge(const FixedIntervalSeries& other) {
+    for (size_t i = 0; i < other.size(); ++i) {
+        uint64_t index = other.first + i;
+        if (index >= first) {
+            window(index) += other.getValue(i);
+        }
+    }
+}
+
+void FixedIntervalSeries::clear() {
+    values.clear();
+    head = 0;
+    first = 0;
+}
+
+bool FixedIntervalSeries::restore(uint64_t firstWindow, const std::vector<double>& windowValues) {
+    clear();
+    if (windowValues.size() > capacity) {
+        return false;
+    }
+    values = windowValues;
+    first = firstWindow;
+    return true;
+}
+
+std::vector<double> FixedIntervalSeries::getValues() const {
+    std::vector<double> ordered(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ordered[i] = getValue(i);
+    }
+    return ordered;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file streaming_stats.hpp
+ * @brief Header file for the StreamingDistribution and FixedIntervalSeries classes
+ *
+ * Accumulators for statistics that would otherwise need every sample of a run, each with
+ * memory bounded independently of the run length:
+ *
+ * - RunningMoments: count, mean and variance (Welford) with the minimum and maximum.
+ * - LogHistogram: counts of samples in logarithmic buckets, HDR histogram style. Every
+ *   power of two above MIN_VALUE is split into SUB_BUCKETS linear buckets, so a quantile
+ *   is within 1 / (2 * SUB_BUCKETS) of the true sample, relative. Only buckets holding
+ *   samples are stored, in index order.
+ * - StreamingDistribution: both of the above, e.g. the session durations of a vehicle type.
+ * - FixedIntervalSeries: a value summed per fixed window of simulation time (e.g. charger
+ *   hours per minute) in a ring of windows, the oldest windows are dropped once it is full.
+ *
+ * All of them merge: merging the accumulators of two sets of samples gives the accumulator
+ * of the union, so partial results of threads and of replications can be combined. Merges
+ * in a fixed order give identical floating point results.
+ */
+
+#ifndef STREAMING_STATS_HPP
+#define STREAMING_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class RunningMoments {
+public:
+    void add(double value);
+    void merge(const RunningMoments& other);
+    void clear() { *this = RunningMoments(); }
+
+    uint64_t getCount() const { return count; }
+    double getMean() const { return mean; }
+    double getSumOfSquares() const { return m2; } // Of the deviations from the mean
+    double getVariance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; } // Sample variance
+    double getStdDev() const;
+    double getMin() const { return min; }
+    double getMax() const { return max; }
+
+    /**
+     * @brief Replace the moments, e.g. with those of a checkpoint.
+     */
+    void restore(uint64_t count, double mean, double m2, double min, double max);
+
+private:
+    uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+class LogHistogram {
+public:
+    static constexpr double MIN_VALUE = 1e-6;  // Smaller samples (e.g. 0) share bucket 0
+    static constexpr uint32_t SUB_BUCKETS = 64; // Linear buckets per power of two
+
+    void add(double value, uint64_t count = 1);
+    void merge(const LogHistogram& other);
+    void clear() { indices.clear(); counts.clear(); total = 0; }
+
+    uint64_t getCount() const { return total; }
+    bool empty() const { return total == 0; }
+
+    /**
+     * @brief Midpoint of the bucket holding the sample of rank ceil(q * count), 0 if empty.
+     * @param q Quantile in [0, 1].
+     */
+    double quantile(double q) const;
+
+    static uint32_t bucketOf(double value);
+    static double bucketLower(uint32_t bucket);
+    static double bucketUpper(uint32_t bucket);
+
+    // Buckets holding samples, ascending, and their counts
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+    const std::vector<uint64_t>& getCounts() const { return counts; }
+
+    /**
+     * @brief Replace the buckets, e.g. with those of a checkpoint.
+     * @return False, leaving the histogram empty, unless the indices ascend strictly and
+     *         every count is positive.
+     */
+    bool restore(const std::vector<uint32_t>& indices, const std::vector<uint64_t>& counts);
+
+private:
+    std::vector<uint32_t> indices;
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+
+    void addToBucket(uint32_t bucket, uint64_t count);
+};
+
+class StreamingDistribution {
+public:
+    void add(double value) {
+        moments.add(value);
+        histogram.add(value);
+    }
+
+    void merge(const StreamingDistribution& other) {
+        if (other.getCount() > 0) {
+            moments.merge(other.moments);
+            histogram.merge(other.histogram);
+        }
+    }
+
+    void clear() {
+        if (getCount() > 0) {
+            moments.clear();
+            histogram.clear();
+        }
+    }
+
+    uint64_t getCount() const { return moments.getCount(); }
+
+    // Histogram quantile clamped to the smallest and largest sample
+    double quantile(double q) const;
+
+    const RunningMoments& getMoments() const { return moments; }
+    const LogHistogram& getHistogram() const { return histogram; }
+    RunningMoments& getMoments() { return moments; }
+    LogHistogram& getHistogram() { return histogram; }
+
+private:
+    RunningMoments moments;
+    LogHistogram histogram;
+};
+
+const double DEFAULT_SERIES_INTERVAL_HOURS = 1.0 / 60.0; // One minute windows
+const size_t DEFAULT_SERIES_CAPACITY = 7 * 24 * 60;      // A week of one minute windows
+
+class FixedIntervalSeries {
+public:
+    explicit FixedIntervalSeries(double intervalHours = DEFAULT_SERIES_INTERVAL_HOURS,
+                                 size_t capacity = DEFAULT_SERIES_CAPACITY);
+
+    /**
+     * @brief Add an amount spread evenly over [start, start + duration) to the windows it overlaps.
+     *
+     * An amount with no duration goes to the window holding start. Windows before the
+     * ring are ignored, windows after it drop the oldest windows.
+     */
+    void add(double start, double duration, double amount);
+
+    /**
+     * @brief Add the windows of a series with the same interval, window by window.
+     */
+    void merge(const FixedIntervalSeries& other);
+
+    void clear();
+
+    double getInterval() const { return interval; }
+    size_t getCapacity() const { return capacity; }
+
+    // Windows kept, the first window starts at getFirstWindow() * getInterval() hours
+    uint64_t getFirstWindow() const { return first; }
+    size_t size() const { return values.size(); }
+    double getValue(size_t window) const { return values[(head + window) % capacity]; }
+
+    /**
+     * @brief Replace the windows, e.g. with those of a checkpoint.
+     * @return False, leaving the series empty, if there are more values than the capacity.
+     */
+    bool restore(uint64_t firstWindow, const std::vector<double>& windowValues);
+
+    // Values of the kept windows, oldest first
+    std::vector<double> getValues() const;
+
+private:
+    double interval;
+    size_t capacity;
+    std::vector<double> values; // Ring, window first at values[head]
+    size_t head = 0;
+    uint64_t first = 0;         // Absolute index of the oldest kept window
+
+    double& window(uint64_t index);
+};
+
+#endif
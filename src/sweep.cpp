@@ -0,0 +1,233 @@
+/**
+ * @file sweep.cpp
+ * @brief Implementation file for the SweepRunner class
+ *
+ * See sweep.hpp for class documentation.
+ */
+
+#include "sweep.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+std::string formatDouble(double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+} // namespace
+
+/* SweepRange */
+std::vector<double> SweepRange::values() const {
+    // Count the steps up front so floating point error cannot drop the last value
+    std::vector<double> result;
+    long count = static_cast<long>(std::floor((end - start) / step + 1e-9)) + 1;
+    for (long i = 0; i < count; ++i) {
+        result.push_back(start + i * step);
+    }
+    return result;
+}
+
+bool SweepRange::parse(const std::string& text, SweepRange& range) {
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, ':')) {
+        parts.push_back(part);
+    }
+    if (parts.empty() || parts.size() > 3) {
+        return false;
+    }
+
+    SweepRange parsed;
+    if (!parseDouble(parts[0], parsed.start)) {
+        return false;
+    }
+    parsed.end = parsed.start;
+    if (parts.size() > 1 && !parseDouble(parts[1], parsed.end)) {
+        return false;
+    }
+    if (parts.size() > 2 && !parseDouble(parts[2], parsed.step)) {
+        return false;
+    }
+    if (!(parsed.step > 0) || parsed.end < parsed.start) {
+        return false;
+    }
+    range = parsed;
+    return true;
+}
+
+/* SweepResult */
+SweepResult SweepResult::fromTypeStats(const VehicleTypeStatsTable& typeStats) {
+    SweepResult result;
+    for (const auto& pair : typeStats) {
+        const auto& stats = pair.second;
+        result.flights += stats.totalFlights;
+        result.charges += stats.totalCharges;
+        result.faults += stats.totalFaults;
+        result.flightHours += stats.totalFlightTime;
+        result.queuedHours += stats.totalQueuedTime;
+        result.chargingHours += stats.totalChargingTime;
+        result.passengerMiles += stats.totalPassengerMiles;
+    }
+    return result;
+}
+
+std::string SweepResult::toCsv() const {
+    return std::to_string(flights) + "," + std::to_string(charges) + "," + std::to_string(faults) + "," +
+           formatDouble(flightHours) + "," + formatDouble(queuedHours) + "," +
+           formatDouble(chargingHours) + "," + formatDouble(passengerMiles);
+}
+
+bool SweepResult::fromCsv(const std::string& text, SweepResult& result) {
+    SweepResult parsed;
+    int consumed = 0;
+    int fields = std::sscanf(text.c_str(), "%d,%d,%d,%lf,%lf,%lf,%lf%n",
+                             &parsed.flights, &parsed.charges, &parsed.faults, &parsed.flightHours,
+                             &parsed.queuedHours, &parsed.chargingHours, &parsed.passengerMiles, &consumed);
+    if (fields != 7 || consumed != static_cast<int>(text.size())) {
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+/* SweepRunner */
+SweepRunner::SweepRunner(const SweepSettings& settings)
+    : settings(settings) {
+    for (double vehicles : settings.vehicles.values()) {
+        for (double chargers : settings.chargers.values()) {
+            for (double hours : settings.hours.values()) {
+                SweepCell cell;
+                cell.numVehicles = static_cast<int>(std::lround(vehicles));
+                cell.numChargers = static_cast<int>(std::lround(chargers));
+                cell.simHours = hours;
+                cells.push_back(cell);
+            }
+        }
+    }
+}
+
+std::string SweepRunner::cacheKey(const SweepCell& cell) const {
+    // Registered vehicle types, vertiports, dispatch policies and fleet compositions change the results, keys without
+    // them stay as they were
+    const std::string types = VehicleTypeRegistry::instance().fingerprint();
+    std::string fleet;
+    for (int count : settings.fleetComposition) {
+        fleet += (fleet.empty() ? "" : ",") + std::to_string(count);
+    }
+    return "v" + std::to_string(SIMULATION_RESULTS_VERSION) +
+           ";vehicles=" + std::to_string(cell.numVehicles) +
+           ";chargers=" + std::to_string(cell.numChargers) +
+           ";hours=" + formatDouble(cell.simHours) +
+           ";step=" + formatDouble(settings.simTimeStepSeconds) +
+           ";random=" + (settings.randomizeVehicles ? "1" : "0") +
+           ";engine=" + engineToString(settings.engine) +
+           ";faults=" + faultModelToString(settings.faultModel) +
+           ";seed=" + std::to_string(settings.seed) +
+           (settings.vertiports == 1 ? "" : ";vertiports=" + std::to_string(settings.vertiports)) +
+           (settings.dispatchPolicy == DEFAULT_DISPATCH_POLICY
+                ? ""
+                : ";dispatch=" + dispatchPolicyToString(settings.dispatchPolicy)) +
+           (fleet.empty() ? "" : ";fleet=" + fleet) +
+           (types.empty() ? "" : ";types=" + types);
+}
+
+std::unordered_map<std::string, SweepResult> SweepRunner::loadCache() const {
+    // One "key|values" line per cell, malformed lines are ignored
+    std::unordered_map<std::string, SweepResult> cache;
+    if (settings.cacheFile.empty()) {
+        return cache;
+    }
+
+    std::ifstream file(settings.cacheFile);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t separator = line.find('|');
+        SweepResult result;
+        if (separator != std::string::npos && SweepResult::fromCsv(line.substr(separator + 1), result)) {
+            cache[line.substr(0, separator)] = result;
+        }
+    }
+    return cache;
+}
+
+void SweepRunner::appendCache(const std::vector<size_t>& newCells) const {
+    if (settings.cacheFile.empty() || newCells.empty()) {
+        return;
+    }
+
+    std::filesystem::path path(settings.cacheFile);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    std::ofstream file(settings.cacheFile, std::ios::app);
+    for (size_t index : newCells) {
+        file << cacheKey(cells[index]) << '|' << cells[index].result.toCsv() << '\n';
+    }
+}
+
+void SweepRunner::run() {
+    const auto cache = loadCache();
+
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        auto entry = cache.find(cacheKey(cells[i]));
+        if (entry != cache.end()) {
+            cells[i].result = entry->second;
+            cells[i].cached = true;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    std::vector<RunConfig> configs(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const SweepCell& cell = cells[pending[i]];
+        RunConfig& config = configs[i];
+        config.numVehicles = cell.numVehicles;
+        config.simHours = cell.simHours;
+        config.numChargers = cell.numChargers;
+        config.vertiports = settings.vertiports;
+        config.dispatchPolicy = settings.dispatchPolicy;
+        config.simTimeStepSeconds = settings.simTimeStepSeconds;
+        config.randomizeVehicles = settings.randomizeVehicles;
+        config.fleetComposition = settings.fleetComposition;
+        config.engine = settings.engine;
+        config.faultModel = settings.faultModel;
+        config.seed = settings.seed;
+    }
+    std::vector<VehicleTypeStatsTable> results = batchRunner ? batchRunner(configs) : simulateBatch(configs, settings.threads);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        cells[pending[i]].result = SweepResult::fromTypeStats(results[i]);
+    }
+
+    computed = static_cast<int>(pending.size());
+    appendCache(pending);
+}
+
+std::string SweepRunner::csvHeader() {
+    return "vehicles,chargers,hours,seed,flights,charges,faults,flight_hours,queued_hours,charging_hours,"
+           "passenger_miles,queued_hours_per_vehicle";
+}
+
+void SweepRunner::writeCsv(std::ostream& out) const {
+    out << csvHeader() << '\n';
+    for (const auto& cell : cells) {
+        out << cell.numVehicles << ',' << cell.numChargers << ',' << formatDouble(cell.simHours) << ','
+            << settings.seed << ',' << cell.result.toCsv() << ','
+            << formatDouble(cell.numVehicles > 0 ? cell.result.queuedHours / cell.numVehicles : 0.0) << '\n';
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file sweep.hpp
+ * @brief Header file for the SweepRunner class
+ *
+ * SweepRunner runs a grid of simulations over ranges of vehicles, chargers and simulation
+ * hours, used for capacity planning (e.g. finding the number of chargers at which queueing
+ * time grows quickly). Cells run in parallel on a ThreadPool without any log output and the
+ * grid is written as one CSV row per configuration.
+ *
+ * Results are cached on disk keyed by the configuration, the seed, the registered vehicle
+ * types and SIMULATION_RESULTS_VERSION, so re-running a sweep only computes the cells that are new.
+ */
+
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "run.hpp"
+#include "simulation.hpp"
+
+const std::string DEFAULT_SWEEP_CACHE = "output/sweep_cache.txt"; // Default on-disk sweep cache
+
+/**
+ * @brief Inclusive range of values "start:end:step", or a single value.
+ */
+struct SweepRange {
+    double start = 0.0;
+    double end = 0.0;
+    double step = 1.0;
+
+    std::vector<double> values() const;
+
+    /**
+     * @brief Parse "start:end:step", "start:end" (step 1) or "value".
+     * @return False if the text is malformed, the step is not positive or end < start.
+     */
+    static bool parse(const std::string& text, SweepRange& range);
+};
+
+/**
+ * @brief Sweep configuration, every cell shares everything except the swept values.
+ */
+struct SweepSettings {
+    SweepRange vehicles{DEFAULT_NUM_VEHICLES, DEFAULT_NUM_VEHICLES, 1};
+    SweepRange chargers{DEFAULT_CHARGERS, DEFAULT_CHARGERS, 1};
+    SweepRange hours{DEFAULT_HRS_SIM, DEFAULT_HRS_SIM, 1};
+    double simTimeStepSeconds = DEFAULT_TIME_STEP_SECONDS;
+    int vertiports = DEFAULT_VERTIPORTS; // Same for every cell, must not exceed the fewest chargers
+    DispatchPolicy dispatchPolicy = DEFAULT_DISPATCH_POLICY;
+    bool randomizeVehicles = true;
+    std::vector<int> fleetComposition; // Vehicles per type id, the vehicles are then not swept
+    SimulationEngine engine = DEFAULT_ENGINE;
+    Vehicle::FaultModel faultModel = DEFAULT_FAULT_MODEL;
+    int threads = DEFAULT_THREADS; // Cells run concurrently
+    uint64_t seed = 0;             // Same seed for every cell so cells share their random draws
+    std::string cacheFile = DEFAULT_SWEEP_CACHE; // Empty disables the cache
+};
+
+/**
+ * @brief Fleet totals of one sweep cell.
+ */
+struct SweepResult {
+    int flights = 0;
+    int charges = 0;
+    int faults = 0;
+    double flightHours = 0.0;
+    double queuedHours = 0.0;
+    double chargingHours = 0.0;
+    double passengerMiles = 0.0;
+
+    static SweepResult fromTypeStats(const VehicleTypeStatsTable& typeStats);
+
+    // Comma separated values, doubles are written with round-trip precision
+    std::string toCsv() const;
+    static bool fromCsv(const std::string& text, SweepResult& result);
+};
+
+struct SweepCell {
+    int numVehicles;
+    int numChargers;
+    double simHours;
+    SweepResult result;
+    bool cached = false; // Loaded from the cache instead of computed
+};
+
+class SweepRunner {
+public:
+    explicit SweepRunner(const SweepSettings& settings);
+
+    /**
+     * @brief Run every cell that is not cached, then add the new cells to the cache.
+     */
+    void run();
+
+    /**
+     * @brief Run the cells that are not cached with another BatchRunner, e.g. on remote workers.
+     *
+     * The default runs them on settings.threads local threads.
+     */
+    void setBatchRunner(BatchRunner runner) { batchRunner = std::move(runner); }
+
+    const std::vector<SweepCell>& getCells() const { return cells; }
+    int getComputedCount() const { return computed; }
+
+    /**
+     * @brief Cache key of a cell: configuration, seed, vehicle types and SIMULATION_RESULTS_VERSION.
+     */
+    std::string cacheKey(const SweepCell& cell) const;
+
+    static std::string csvHeader();
+    void writeCsv(std::ostream& out) const;
+
+private:
+    SweepSettings settings;
+    BatchRunner batchRunner;
+    std::vector<SweepCell> cells;
+    int computed = 0;
+
+    std::unordered_map<std::string, SweepResult> loadCache() const;
+    void appendCache(const std::vector<size_t>& newCells) const;
+};
+
+#endif
@@ -0,0 +1,15 @@
+/**
+ * @file test_access.hpp
+ * @brief FRIEND_TEST without a dependency on Google Test
+ *
+ * EVTOL_FRIEND_TEST expands like FRIEND_TEST of gtest_prod.h, so the core headers can give
+ * unit tests access to private members without the evtol_core library or the programs
+ * linking against Google Test.
+ */
+
+#ifndef TEST_ACCESS_HPP
+#define TEST_ACCESS_HPP
+
+#define EVTOL_FRIEND_TEST(test_suite_name, test_name) friend class test_suite_name##_##test_name##_Test
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation file for the ThreadPool class
+ *
+ * See thread_pool.hpp for class documentation.
+ */
+
+#include "thread_pool.hpp"
+
+ThreadPool::ThreadPool(int numThreads) {
+    for (int i = 1; i < numThreads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &task;
+        jobCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        activeWorkers = static_cast<int>(workers.size());
+        error = nullptr;
+        generation++;
+    }
+    workReady.notify_all();
+
+    // The calling thread works too
+    runTasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this] { return activeWorkers == 0; });
+    job = nullptr;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    unsigned long seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeWorkers--;
+        }
+        workDone.notify_one();
+    }
+}
+
+void ThreadPool::runTasks() {
+    while (true) {
+        size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= jobCount) {
+            return;
+        }
+        try {
+            (*job)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Header file for the ThreadPool class
+ *
+ * Fixed-size pool of worker threads for data parallel loops. parallelFor hands out the
+ * task indices to the workers and the calling thread, and returns once every index has
+ * run. Which thread runs which index is not deterministic, so callers that need
+ * reproducible results must make each index write only its own output.
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    /**
+     * @param numThreads Total threads used by parallelFor, including the calling thread.
+     */
+    explicit ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    /**
+     * @brief Run task(i) for every i in [0, count) and wait for all of them.
+     *
+     * If a task throws, the remaining indices still run and the first exception is
+     * rethrown on the calling thread.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+
+    // Current job, guarded by mutex except for the atomic counters
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    unsigned long generation = 0;
+    std::atomic<size_t> nextIndex{0};
+    int activeWorkers = 0;
+    std::exception_ptr error;
+    bool stopping = false;
+
+    void workerLoop();
+    void runTasks();
+};
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation file for the binary trace writer and reader
+ *
+ * See trace.hpp for the file layout.
+ */
+
+#include "trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+uint8_t saturate(int value, int max = 255) {
+    return static_cast<uint8_t>(std::min(std::max(value, 0), max));
+}
+
+std::string formatFixedWidth(const std::string& text, int width) {
+    std::ostringstream oss;
+    oss << std::right << std::setw(width) << text;
+    return oss.str();
+}
+
+} // namespace
+
+/* Format Names */
+std::string traceFormatToString(TraceFormat format) {
+    switch (format) {
+        case TraceFormat::Text: return "text";
+        case TraceFormat::Binary: return "binary";
+        default: return "unknown";
+    }
+}
+
+bool traceFormatFromString(const std::string& name, TraceFormat& format) {
+    if (name == "text") {
+        format = TraceFormat::Text;
+    } else if (name == "binary") {
+        format = TraceFormat::Binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* Records */
+TraceStepRecord TraceRecord::asStep() const {
+    TraceStepRecord step;
+    std::memcpy(&step, this, sizeof(step));
+    return step;
+}
+
+VehicleStats TraceRecord::getStepStats() const {
+    VehicleStats stats;
+    stats.flightTime = flightTime;
+    stats.queuedTime = queuedTime;
+    stats.distanceTraveled = distanceTraveled;
+    stats.chargingTime = chargingTime;
+    stats.faultedTime = faultedTime;
+    stats.faults = getFaults();
+    stats.passengerMiles = passengerMiles;
+    stats.flights = flights;
+    stats.charges = getCharges();
+    return stats;
+}
+
+std::string formatVehicleStatsLine(int vehicleId, Vehicle::Manufacturer manufacturer, Vehicle::State state,
+                                   double batteryPercent, const VehicleStats& stepStats,
+                                   const VehicleStats& totalStats) {
+    std::string batteryDisplay = "Battery " + std::to_string(static_cast<int>(batteryPercent + 0.5)) + "%";
+    std::string stepSection = stepStats.toShortString();
+    std::string totalSection = totalStats.toLongString();
+
+    const int stepWidth = 40;
+    const int totalWidth = 140;
+
+    stepSection.resize(stepWidth, ' ');   // Pad with spaces
+    totalSection.resize(totalWidth, ' '); // Pad with spaces
+
+    return formatFixedWidth("Vehicle " + std::to_string(vehicleId) + " (" + getManufacturerName(manufacturer) + ")   ", 30) +
+           "[" + formatFixedWidth(getStateName(state), 8) + "]   " +
+           "[" + formatFixedWidth(batteryDisplay, 12) + "]   " +
+           "Step: " + stepSection + " | Total: " + totalSection;
+}
+
+/* Writer */
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+bool TraceWriter::open(const std::string& filename, uint32_t numVehicles, uint32_t numChargers,
+                       double simHours, uint64_t seed) {
+    close();
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    fileName = filename;
+    buffer.reserve(BLOCK_SIZE);
+
+    TraceFileHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.recordSize = TRACE_RECORD_SIZE;
+    header.numVehicles = numVehicles;
+    header.numChargers = numChargers;
+    header.simHours = simHours;
+    header.seed = seed;
+    append(&header);
+    return true;
+}
+
+void TraceWriter::close() {
+    if (file.is_open()) {
+        flushBuffer();
+        file.close();
+    }
+}
+
+void TraceWriter::beginStep(uint32_t step, double time) {
+    TraceStepRecord record{};
+    record.marker = TRACE_STEP_MARKER;
+    record.step = step;
+    record.time = time;
+    append(&record);
+}
+
+void TraceWriter::write(const Vehicle& vehicle) {
+    write(static_cast<uint32_t>(vehicle.getId()), vehicle.getManufacturer(), vehicle.getCurrentState(),
+          vehicle.getBatteryLevel(), vehicle.getStepStats());
+}
+
+void TraceWriter::write(uint32_t vehicleId, Vehicle::Manufacturer manufacturer, Vehicle::State state,
+                        double battery, const VehicleStats& stepStats) {
+    TraceRecord record{};
+    record.vehicleId = vehicleId;
+    record.type = static_cast<uint8_t>(manufacturer);
+    record.state = static_cast<uint8_t>(state);
+    record.flights = saturate(stepStats.flights);
+    record.chargesAndFaults = static_cast<uint8_t>(saturate(stepStats.charges, 15) | (saturate(stepStats.faults, 15) << 4));
+    record.battery = battery;
+    record.flightTime = stepStats.flightTime;
+    record.queuedTime = stepStats.queuedTime;
+    record.distanceTraveled = stepStats.distanceTraveled;
+    record.chargingTime = stepStats.chargingTime;
+    record.faultedTime = stepStats.faultedTime;
+    record.passengerMiles = stepStats.passengerMiles;
+    append(&record);
+}
+
+void TraceWriter::append(const void* record) {
+    const char* bytes = static_cast<const char*>(record);
+    buffer.insert(buffer.end(), bytes, bytes + TRACE_RECORD_SIZE);
+    if (buffer.size() >= BLOCK_SIZE) {
+        flushBuffer();
+    }
+}
+
+void TraceWriter::flushBuffer() {
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+/* Reader */
+bool TraceReader::open(const std::string& filename) {
+    file.close();
+    file.clear();
+    file.open(filename, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    return std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == TRACE_VERSION && header.recordSize == TRACE_RECORD_SIZE;
+}
+
+bool TraceReader::next(TraceRecord& record) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&record), sizeof(record)));
+}
+
+void TraceReader::renderText(std::ostream& out) {
+    const std::string divider(60, '=');
+    std::unordered_map<uint32_t, VehicleStats> totals; // Running totals per vehicle id
+
+    TraceRecord record;
+    while (next(record)) {
+        if (record.isStep()) {
+            TraceStepRecord step = record.asStep();
+            out << divider << '\n'
+                << "Simulation Step " << step.step << '\n'
+                << divider << '\n'
+                << "Current Time: " << std::to_string(step.time) << " hours\n";
+            continue;
+        }
+
+        Vehicle::Manufacturer manufacturer = record.getManufacturer();
+        VehicleStats stepStats = record.getStepStats();
+        VehicleStats& total = totals[record.vehicleId];
+        total.add(stepStats);
+
+        double batteryPercent = record.battery / getVehicleTypeSpec(manufacturer).batteryCapacity * 100.0;
+        out << formatVehicleStatsLine(static_cast<int>(record.vehicleId), manufacturer,
+                                      record.getState(), batteryPercent,
+                                      stepStats, total) << '\n';
+    }
+}
+
+/* Mapped Trace */
+MappedTrace::~MappedTrace() {
+    close();
+}
+
+bool MappedTrace::open(const std::string& filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= TRACE_RECORD_SIZE) {
+        mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const char*>(mapping);
+    length = static_cast<size_t>(info.st_size);
+    count = length / TRACE_RECORD_SIZE - 1; // A partially written last record is ignored
+
+    const TraceFileHeader& header = getHeader();
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TRACE_VERSION || header.recordSize != TRACE_RECORD_SIZE) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedTrace::close() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), length);
+        data = nullptr;
+        length = 0;
+        count = 0;
+    }
+}
+
+size_t MappedTrace::nextStep(size_t index) const {
+    while (index < count && !(*this)[index].isStep()) {
+        ++index;
+    }
+    return index;
+}
+
+size_t MappedTrace::findStep(double time) const {
+    // "The step at or after i starts at or after time" is monotone in i
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        size_t step = nextStep(middle);
+        if (step == count || (*this)[step].asStep().time >= time) {
+            high = middle;
+        } else {
+            low = step + 1;
+        }
+    }
+    return nextStep(low);
+}
@@ -0,0 +1,214 @@
+/**
+ * @file trace.hpp
+ * @brief Header file for the binary trace writer and reader
+ *
+ * A binary trace replaces the verbosity 2 per-vehicle lines of the text report with
+ * fixed-width records: a TraceFileHeader followed by a TraceStepRecord at the start of
+ * every step and one TraceRecord per vehicle, all TRACE_RECORD_SIZE bytes, so record n
+ * starts at byte (n + 1) * TRACE_RECORD_SIZE and a trace can be memory-mapped and indexed
+ * directly. Only the step statistics are stored, running totals are recovered by summing
+ * them in file order. Records are written in native (little-endian) byte order.
+ *
+ * TraceReader renders a trace back into the text view of the report, MappedTrace gives
+ * random access to the records of a memory-mapped trace for post-hoc analysis.
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "vehicle.hpp"
+
+const uint32_t TRACE_VERSION = 2;                  // Bump whenever the record layout changes
+const uint32_t TRACE_STEP_MARKER = 0xFFFFFFFFu;    // vehicleId of a TraceStepRecord
+const size_t TRACE_RECORD_SIZE = 64;               // Bytes per header, step and vehicle record
+const char TRACE_MAGIC[8] = {'E', 'V', 'T', 'R', 'A', 'C', 'E', '\0'};
+
+/**
+ * @brief Output format of the per-vehicle step lines.
+ */
+enum class TraceFormat {
+    Text,   // Lines in the text report at verbosity 2 (default)
+    Binary  // Fixed-width records in a separate trace file, at any verbosity
+};
+
+std::string traceFormatToString(TraceFormat format);
+bool traceFormatFromString(const std::string& name, TraceFormat& format);
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t numVehicles;
+    uint32_t numChargers;
+    double simHours;
+    uint64_t seed;
+    uint8_t padding[24];
+};
+
+/**
+ * @brief Start of a simulation step (or event), followed by the vehicles updated in it.
+ */
+struct TraceStepRecord {
+    uint32_t marker; // Always TRACE_STEP_MARKER
+    uint32_t step;   // 1-based step or event number
+    double time;     // Simulation time at the start of the step [hours]
+    uint8_t padding[48];
+};
+
+/**
+ * @brief State of one vehicle after a step and its statistics for that step.
+ *
+ * Values are kept in double precision so that summing the step statistics reproduces the
+ * totals of the simulation exactly and the rendered text matches the report.
+ */
+struct TraceRecord {
+    uint32_t vehicleId;    // TRACE_STEP_MARKER for step records
+    uint8_t type;             // Vehicle::Manufacturer
+    uint8_t state;            // Vehicle::State after the step
+    uint8_t flights;
+    uint8_t chargesAndFaults; // Charges in the low nibble, faults in the high nibble (at most one of each per step)
+    double battery;        // [kWh]
+    double flightTime;
+    double queuedTime;
+    double distanceTraveled;
+    double chargingTime;
+    double faultedTime;
+    double passengerMiles;
+
+    bool isStep() const { return vehicleId == TRACE_STEP_MARKER; }
+    Vehicle::Manufacturer getManufacturer() const { return static_cast<Vehicle::Manufacturer>(type); }
+    Vehicle::State getState() const { return static_cast<Vehicle::State>(state); }
+    int getCharges() const { return chargesAndFaults & 0x0F; }
+    int getFaults() const { return chargesAndFaults >> 4; }
+    TraceStepRecord asStep() const;
+    VehicleStats getStepStats() const;
+};
+
+static_assert(sizeof(TraceFileHeader) == TRACE_RECORD_SIZE, "Trace header must be one record");
+static_assert(sizeof(TraceStepRecord) == TRACE_RECORD_SIZE, "Trace step records must be fixed width");
+static_assert(sizeof(TraceRecord) == TRACE_RECORD_SIZE, "Trace records must be fixed width");
+
+/**
+ * @brief Format a per-vehicle line of the text report.
+ */
+std::string formatVehicleStatsLine(int vehicleId, Vehicle::Manufacturer manufacturer, Vehicle::State state,
+                                   double batteryPercent, const VehicleStats& stepStats,
+                                   const VehicleStats& totalStats);
+
+/**
+ * @brief Buffered writer of a binary trace, records are written to disk in large blocks.
+ */
+class TraceWriter {
+public:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024; // Bytes buffered before a write
+
+    ~TraceWriter();
+
+    /**
+     * @brief Create the file and write its header.
+     * @return False if the file could not be opened.
+     */
+    bool open(const std::string& filename, uint32_t numVehicles, uint32_t numChargers,
+              double simHours, uint64_t seed);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+    const std::string& getFileName() const { return fileName; }
+
+    void beginStep(uint32_t step, double time);
+    void write(const Vehicle& vehicle);
+    void write(uint32_t vehicleId, Vehicle::Manufacturer manufacturer, Vehicle::State state,
+               double battery, const VehicleStats& stepStats);
+
+private:
+    std::ofstream file;
+    std::string fileName;
+    std::vector<char> buffer;
+
+    void append(const void* record);
+    void flushBuffer();
+};
+
+/**
+ * @brief Sequential reader of a binary trace.
+ */
+class TraceReader {
+public:
+    /**
+     * @brief Open a trace and read its header.
+     * @return False if the file is missing, not a trace or of another version.
+     */
+    bool open(const std::string& filename);
+    const TraceFileHeader& getHeader() const { return header; }
+
+    /**
+     * @brief Read the next step or vehicle record.
+     * @return False at the end of the file.
+     */
+    bool next(TraceRecord& record);
+
+    /**
+     * @brief Write the remaining records as the step and per-vehicle lines of the text report.
+     */
+    void renderText(std::ostream& out);
+
+private:
+    std::ifstream file;
+    TraceFileHeader header{};
+};
+
+/**
+ * @brief Read-only memory mapping of a binary trace.
+ *
+ * Records are accessed in place, pages are only read from disk when they are touched so
+ * traces larger than memory can be queried.
+ */
+class MappedTrace {
+public:
+    MappedTrace() = default;
+    ~MappedTrace();
+    MappedTrace(const MappedTrace&) = delete;
+    MappedTrace& operator=(const MappedTrace&) = delete;
+
+    /**
+     * @brief Map a trace.
+     * @return False if the file is missing, not a trace or of another version.
+     */
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const TraceFileHeader& getHeader() const { return *reinterpret_cast<const TraceFileHeader*>(data); }
+
+    // Number of step and vehicle records after the header
+    size_t size() const { return count; }
+    const TraceRecord& operator[](size_t index) const { return records()[index + 1]; }
+
+    /**
+     * @brief Index of the first step record at or after index, size() if there is none.
+     */
+    size_t nextStep(size_t index) const;
+
+    /**
+     * @brief Index of the first step record whose time is at or after time, size() if none.
+     *
+     * Binary search over the records, only the records between the probes and the
+     * following step record are read.
+     */
+    size_t findStep(double time) const;
+
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+    size_t count = 0;
+
+    const TraceRecord* records() const { return reinterpret_cast<const TraceRecord*>(data); }
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "trace.hpp"
+#include "vehicle_registry.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " <trace file> [--vehicle-types <file>]\n";
+    std::cout << "\nRenders a binary trace written with --trace-format=binary as the per-vehicle\n";
+    std::cout << "step lines of the text report (verbosity 2) on stdout. A trace written with a\n";
+    std::cout << "vehicle type file needs the same file to render its registered types.\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && std::string(argv[1]) == "--help") {
+        printUsage(argv[0]);
+        return 0;
+    }
+    if (argc != 2 && !(argc == 4 && std::string(argv[2]) == "--vehicle-types")) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        if (argc == 4) {
+            VehicleTypeRegistry::instance().loadFile(argv[3]);
+        }
+
+        TraceReader reader;
+        if (!reader.open(argv[1])) {
+            std::cerr << "Error: " << argv[1] << " is not a version " << TRACE_VERSION << " eVTOL trace\n";
+            return 1;
+        }
+
+        const TraceFileHeader& header = reader.getHeader();
+        std::cout << "Trace: " << header.numVehicles << " vehicles, " << header.numChargers << " chargers, "
+                  << std::to_string(header.simHours) << " hours, seed " << header.seed << "\n";
+        reader.renderText(std::cout);
+    } catch (const std::out_of_range&) {
+        std::cerr << "\nError: " << argv[1] << " has vehicle types that are not defined, pass its --vehicle-types file\n";
+        return 1;
+    } catch (const std::runtime_error& error) {
+        std::cerr << "Error: " << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -6,18 +6,58 @@
  */
 
 #include "vehicle.hpp"
+#include "vehicle_registry.hpp"
 #include <stdexcept>
 #include <random>
 #include <cmath>
+#include <algorithm>
 
 RandomGenerator& Vehicle::defaultRng() {
     static StdRandomGenerator instance;
     return instance;
 }
 
-/* Constructor */
-int Vehicle::nextId = 1; // Initialize static ID counter
+/* Vehicle Types */
+const VehicleTypeSpec& getVehicleTypeSpec(Vehicle::Manufacturer manufacturer) {
+    return VehicleTypeRegistry::instance().get(manufacturer).spec;
+}
+
+std::string getManufacturerName(Vehicle::Manufacturer manufacturer) {
+    const VehicleTypeRegistry& registry = VehicleTypeRegistry::instance();
+    return registry.contains(manufacturer) ? registry.get(manufacturer).name : "Unknown";
+}
+
+std::string getStateName(Vehicle::State state) {
+    switch (state) {
+        case Vehicle::State::Ready: return "Ready";
+        case Vehicle::State::Flying: return "Flying";
+        case Vehicle::State::Queued: return "Queued";
+        case Vehicle::State::Charging: return "Charging";
+        case Vehicle::State::Faulted: return "Faulted";
+        default: return "Unknown";
+    }
+}
+
+std::string faultModelToString(Vehicle::FaultModel model) {
+    switch (model) {
+        case Vehicle::FaultModel::PerStep: return "step";
+        case Vehicle::FaultModel::Exponential: return "exponential";
+        default: return "unknown";
+    }
+}
 
+bool faultModelFromString(const std::string& name, Vehicle::FaultModel& model) {
+    if (name == "step") {
+        model = Vehicle::FaultModel::PerStep;
+    } else if (name == "exponential") {
+        model = Vehicle::FaultModel::Exponential;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* Constructor */
 Vehicle::Vehicle(Manufacturer manufacturer,
                  double cruiseSpeed,
                  double batteryCapacity,
@@ -33,12 +73,32 @@ Vehicle::Vehicle(Manufacturer manufacturer,
       energyUsePerMile(energyUsePerMile),
       passengerCount(passengerCount),
       faultProbability(faultProbability),
+      builtinType(false),
       currentState(State::Ready), // Always start Ready
       batteryLevel(batteryCapacity),
       rng(rng) {
         stepStats.reset();
         totalStats.reset();
-        id = nextId++;
+
+        // Only vehicles with the exact built-in constants may use the type kernels
+        size_t index = static_cast<size_t>(manufacturer);
+        if (index < static_cast<size_t>(Manufacturer::NumManufacturers)) {
+            const VehicleTypeSpec& spec = BUILTIN_VEHICLE_TYPES[index];
+            builtinType = cruiseSpeed == spec.cruiseSpeed && batteryCapacity == spec.batteryCapacity &&
+                          timeToCharge == spec.timeToCharge && energyUsePerMile == spec.energyUsePerMile &&
+                          passengerCount == spec.passengerCount && faultProbability == spec.faultProbability;
+        }
+}
+
+Vehicle::Vehicle(Manufacturer manufacturer, const VehicleTypeSpec& spec, RandomGenerator& rng)
+    : Vehicle(manufacturer,
+              spec.cruiseSpeed,
+              spec.batteryCapacity,
+              spec.timeToCharge,
+              spec.energyUsePerMile,
+              spec.passengerCount,
+              spec.faultProbability,
+              rng) {
 }
 
 /* Getters */
@@ -64,20 +124,87 @@ void Vehicle::setCurrentState(State state) {
 }
 
 /* State Machine */
+namespace {
+
+// Constants of any vehicle type, copied out of the vehicle once per update
+struct RuntimeVehicleType {
+    double cruiseSpeed;
+    double batteryCapacity;
+    double energyUsePerMile;
+    int passengerCount;
+    double faultProbability;
+    double chargeRate;
+
+    explicit RuntimeVehicleType(const Vehicle& vehicle)
+        : cruiseSpeed(vehicle.getCruiseSpeed()),
+          batteryCapacity(vehicle.getBatteryCapacity()),
+          energyUsePerMile(vehicle.getEnergyUsePerMile()),
+          passengerCount(vehicle.getPassengerCount()),
+          faultProbability(vehicle.getFaultProbability()),
+          chargeRate(vehicle.getChargeRate()) {}
+};
+
+} // namespace
+
+#ifdef EVTOL_TYPE_KERNELS
+bool Vehicle::typeKernelsEnabled = true;
+#else
+bool Vehicle::typeKernelsEnabled = false;
+#endif
+
+bool Vehicle::setTypeKernelsEnabled(bool enabled) {
+#ifndef EVTOL_TYPE_KERNELS
+    if (enabled) {
+        return false;
+    }
+#endif
+    typeKernelsEnabled = enabled;
+    return true;
+}
+
+bool Vehicle::getTypeKernelsEnabled() {
+    return typeKernelsEnabled;
+}
+
+bool Vehicle::usesTypeKernel() const {
+    return typeKernelsEnabled && builtinType;
+}
+
 void Vehicle::updateState(double hours) {
+#ifdef EVTOL_TYPE_KERNELS
+    if (usesTypeKernel()) {
+        switch (manufacturer) {
+            case Manufacturer::Alpha: return advance(hours, BuiltinVehicleType<Manufacturer::Alpha>{});
+            case Manufacturer::Bravo: return advance(hours, BuiltinVehicleType<Manufacturer::Bravo>{});
+            case Manufacturer::Charlie: return advance(hours, BuiltinVehicleType<Manufacturer::Charlie>{});
+            case Manufacturer::Delta: return advance(hours, BuiltinVehicleType<Manufacturer::Delta>{});
+            case Manufacturer::Echo: return advance(hours, BuiltinVehicleType<Manufacturer::Echo>{});
+            default: break;
+        }
+    }
+#endif
+    advance(hours, RuntimeVehicleType(*this));
+}
+
+template <typename Type>
+void Vehicle::advance(double hours, const Type& type) {
     // Single loop handles both automatic transitions and time-consuming actions
     bool continueProcessing = true;
     double remainingTime = hours;
+    stepStats.reset(); // Reset step statistics for this update
 
     while (continueProcessing && remainingTime >= 0) {
         continueProcessing = false;
-        stepStats.reset(); // Reset step statistics for this update
 
         switch (currentState) {
             case State::Ready:
                 // Automatic transition: Ready to Flying if battery > 0
                 if (batteryLevel > 0) {
                     setCurrentState(State::Flying);
+                    // New flight segment, sample when it faults unless a fault is already scheduled
+                    if (faultModel == FaultModel::Exponential && flightTimeToFault < 0) {
+                        flightTimeToFault = rng.exponential(type.faultProbability);
+                    }
                     continueProcessing = true; // Process Flying state immediately
                 }
                 break;
@@ -85,7 +212,7 @@ void Vehicle::updateState(double hours) {
             case State::Flying:
                 // Time-consuming action: fly for remaining time
                 if (remainingTime > 0) {
-                    double timeUsed = fly(remainingTime);
+                    double timeUsed = flyWith(remainingTime, type);
                     remainingTime -= timeUsed; // Only consume time actually used
 
                     // Check if we transitioned to Queued (battery depleted) and have remaining time
@@ -108,7 +235,7 @@ void Vehicle::updateState(double hours) {
             case State::Charging:
                 // Time-consuming action: charge for remaining time
                 if (remainingTime > 0) {
-                    double timeUsed = charge(remainingTime);
+                    double timeUsed = chargeWith(remainingTime, type);
                     remainingTime -= timeUsed; // Only consume time actually used
 
                     // Check if charge completed and we transitioned to Ready
@@ -118,9 +245,10 @@ void Vehicle::updateState(double hours) {
                 }
                 // Automatic transition check as we assume charging is done in one go
                 // If battery is full, transition to Ready
-                else if (batteryLevel >= batteryCapacity) {
-                    setBatteryLevel(batteryCapacity);
+                else if (batteryLevel >= type.batteryCapacity) {
+                    setBatteryLevel(type.batteryCapacity);
                     setCurrentState(State::Ready);
+                    stepStats.charges++;
                     continueProcessing = true;
                 }
                 break;
@@ -153,14 +281,18 @@ double Vehicle::fly(double hours) {
     if (currentState != State::Flying) {
         throw std::runtime_error("Vehicle must be in Flying state to fly");
     }
+    return flyWith(hours, RuntimeVehicleType(*this));
+}
 
+template <typename Type>
+double Vehicle::flyWith(double hours, const Type& type) {
     if (hours <= 0) {
         return 0.0;
     }
 
     // Calculate maximum flight time based on available battery
-    double maxDistance = batteryLevel / energyUsePerMile;
-    double maxFlightTime = maxDistance / cruiseSpeed;
+    double maxDistance = batteryLevel / type.energyUsePerMile;
+    double maxFlightTime = maxDistance / type.cruiseSpeed;
 
     // Determine actual flight time (either requested time or what battery allows)
     double actualFlightTime = std::min(hours, maxFlightTime);
@@ -169,22 +301,33 @@ double Vehicle::fly(double hours) {
         // No battery left, go to Queued immediately
         setBatteryLevel(0.0);
         setCurrentState(State::Queued);
+        stepStats.flights++;
         return 0.0;
     }
 
     // Check for faults based on actual flight time
-    bool faultOccurred = checkFault(actualFlightTime);
+    bool faultOccurred = false;
     double flightTimeBeforeFault = actualFlightTime;
 
-    if (faultOccurred) {
-        // Assume fault occurs halfway through the flight
+    if (flightTimeToFault >= 0) {
+        // Fault time was scheduled up front, fault exactly when it is reached
+        faultOccurred = (flightTimeToFault <= actualFlightTime + EPSILON);
+        if (faultOccurred) {
+            flightTimeBeforeFault = std::min(flightTimeToFault, actualFlightTime);
+            flightTimeToFault = -1.0;
+        } else {
+            flightTimeToFault -= actualFlightTime;
+        }
+    } else if (rng.bernoulli(std::min(1.0, type.faultProbability * actualFlightTime))) {
+        // Same draw as checkFault(), assume fault occurs halfway through the flight
+        faultOccurred = true;
         flightTimeBeforeFault = actualFlightTime * 0.5;
     }
 
     // Calculate flight statistics based on time flown before fault (if any)
-    double distanceFlown = cruiseSpeed * flightTimeBeforeFault;
-    double energyConsumed = distanceFlown * energyUsePerMile;
-    double passengerMiles = distanceFlown * passengerCount;
+    double distanceFlown = type.cruiseSpeed * flightTimeBeforeFault;
+    double energyConsumed = distanceFlown * type.energyUsePerMile;
+    double passengerMiles = distanceFlown * type.passengerCount;
 
     // Update battery and statistics
     setBatteryLevel(batteryLevel - energyConsumed);
@@ -195,6 +338,7 @@ double Vehicle::fly(double hours) {
     // Handle state transitions
     if (faultOccurred) {
         stepStats.faults++;
+        stepStats.flights++;
         setCurrentState(State::Faulted);
         return flightTimeBeforeFault;
     }
@@ -203,6 +347,7 @@ double Vehicle::fly(double hours) {
     if (batteryLevel <= EPSILON) {
         setBatteryLevel(0.0);
         setCurrentState(State::Queued);
+        stepStats.flights++;
     }
     // Otherwise, remain in Flying state
 
@@ -214,7 +359,8 @@ bool Vehicle::checkFault(double hours) {
     // This simulates the probability of a fault occurring that is proportional
     // to the fault probability and the duration of the flight.
     // If a fault occurs, the vehicle will transition to the Faulted state.
-    return rng.bernoulli(faultProbability * hours);
+    // The product exceeds 1 for long steps, it is only an approximation at that point.
+    return rng.bernoulli(std::min(1.0, faultProbability * hours));
 }
 
 void Vehicle::startCharging() {
@@ -229,26 +375,30 @@ double Vehicle::charge(double hours) {
     if (currentState != State::Charging) {
         throw std::runtime_error("Vehicle must be Charging to charge. Call startCharging() first.");
     }
+    return chargeWith(hours, RuntimeVehicleType(*this));
+}
 
+template <typename Type>
+double Vehicle::chargeWith(double hours, const Type& type) {
     if (hours <= 0) {
         return 0.0;
     }
 
     // Calculate how much energy we can add and how much we actually need
-    double chargeRate = batteryCapacity / timeToCharge; // kWh per hour
-    double energyNeeded = batteryCapacity - batteryLevel; // How much to reach full
-    double maxEnergyCanAdd = chargeRate * hours; // How much we could add with available time
+    double energyNeeded = type.batteryCapacity - batteryLevel; // How much to reach full
+    double maxEnergyCanAdd = type.chargeRate * hours; // How much we could add with available time
 
     double actualEnergyToAdd = std::min(energyNeeded, maxEnergyCanAdd);
-    double timeActuallyUsed = actualEnergyToAdd / chargeRate;
+    double timeActuallyUsed = actualEnergyToAdd / type.chargeRate;
 
     setBatteryLevel(batteryLevel + actualEnergyToAdd);
     stepStats.chargingTime += timeActuallyUsed;
 
     // Check if fully charged and transition to Ready
-    if (batteryLevel >= batteryCapacity) {
-        setBatteryLevel(batteryCapacity);
+    if (batteryLevel >= type.batteryCapacity - EPSILON) {
+        setBatteryLevel(type.batteryCapacity);
         setCurrentState(State::Ready);
+        stepStats.charges++;
     }
 
     return timeActuallyUsed;
@@ -256,23 +406,9 @@ double Vehicle::charge(double hours) {
 
 /* Other */
 std::string Vehicle::getStateString() const {
-    switch (currentState) {
-        case State::Ready: return "Ready";
-        case State::Flying: return "Flying";
-        case State::Queued: return "Queued";
-        case State::Charging: return "Charging";
-        case State::Faulted: return "Faulted";
-        default: return "Unknown";
-    }
+    return getStateName(currentState);
 }
 
 std::string Vehicle::getManufacturerString() const {
-    switch (manufacturer) {
-        case Manufacturer::Alpha: return "Alpha";
-        case Manufacturer::Bravo: return "Bravo";
-        case Manufacturer::Charlie: return "Charlie";
-        case Manufacturer::Delta: return "Delta";
-        case Manufacturer::Echo: return "Echo";
-        default: return "Unknown";
-    }
+    return getManufacturerName(manufacturer);
 }
\ No newline at end of file
@@ -11,7 +11,10 @@
 #ifndef VEHICLE_HPP
 #define VEHICLE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <functional>
 #include "std_rng.hpp"
 
@@ -29,6 +32,8 @@ struct VehicleStats {
     double faultedTime = 0.0;
     int faults = 0;
     double passengerMiles = 0.0;
+    int flights = 0; // Completed flights (Flying -> Queued or Faulted)
+    int charges = 0; // Completed charging sessions (Charging -> Ready)
 
     void reset() {
         flightTime = 0.0;
@@ -38,6 +43,8 @@ struct VehicleStats {
         faultedTime = 0.0;
         faults = 0;
         passengerMiles = 0.0;
+        flights = 0;
+        charges = 0;
     }
 
     void add(const VehicleStats& other) {
@@ -48,6 +55,8 @@ struct VehicleStats {
         faultedTime += other.faultedTime;
         faults += other.faults;
         passengerMiles += other.passengerMiles;
+        flights += other.flights;
+        charges += other.charges;
     }
 
     std::string toString() const {
@@ -57,7 +66,9 @@ struct VehicleStats {
                ", Charging Time: " + std::to_string(chargingTime) +
                ", Faulted Time: " + std::to_string(faultedTime) +
                ", Faults: " + std::to_string(faults) +
-               ", Passenger Miles: " + std::to_string(passengerMiles));
+               ", Passenger Miles: " + std::to_string(passengerMiles) +
+               ", Flights: " + std::to_string(flights) +
+               ", Charges: " + std::to_string(charges));
     }
 
     std::string toShortString() const {
@@ -139,6 +150,18 @@ struct VehicleStats {
     }
 };
 
+/**
+ * @brief Constant properties shared by every vehicle of a type.
+ */
+struct VehicleTypeSpec {
+    double cruiseSpeed;           // mph
+    double batteryCapacity;       // kWh
+    double timeToCharge;          // hours to full charge
+    double energyUsePerMile;      // kWh/mile
+    int passengerCount;           // number of passengers
+    double faultProbability;      // faults per hour
+};
+
 /**
  * @brief Base class for eVTOL vehicles.
  */
@@ -153,13 +176,19 @@ public:
         Faulted   // Vehicle has encountered a fault and cannot operate
     };
 
-    enum class Manufacturer {
+    // Vehicle type id, the built-in types are named, registered types follow them (see VehicleTypeRegistry)
+    enum class Manufacturer : uint8_t {
         Alpha,
         Bravo,
         Charlie,
         Delta,
         Echo,
-        NumManufacturers // Used to determine number of vehicle types
+        NumManufacturers // Number of built-in vehicle types, the id of the first registered type
+    };
+
+    enum class FaultModel {
+        PerStep,    // Bernoulli draw with probability faultProbability * hours on every flying step
+        Exponential // Time to fault sampled once from an exponential distribution when a flight starts
     };
 
     // Default random number generator instance for the Vehicle class
@@ -174,6 +203,10 @@ public:
             double faultProbability,
             RandomGenerator& rng = Vehicle::defaultRng());
 
+    Vehicle(Manufacturer manufacturer,
+            const VehicleTypeSpec& spec,
+            RandomGenerator& rng = Vehicle::defaultRng());
+
     virtual ~Vehicle() = default;
 
     // Property getters
@@ -277,6 +310,35 @@ public:
      */
     bool checkFault(double hours);
 
+    /**
+     * @brief Schedule a fault after the given amount of additional flight time.
+     *
+     * When a fault is scheduled the per-step checkFault() draw is bypassed and the vehicle
+     * faults once it has flown exactly this many hours. This is used by engines that sample
+     * a fault time up front instead of checking every step. A negative value clears the
+     * schedule and restores the per-step check (or, with FaultModel::Exponential, a new
+     * sample when the next flight starts).
+     *
+     * @param hours Flight time in hours until the fault occurs.
+     */
+    void setFlightTimeToFault(double hours) { flightTimeToFault = hours; }
+    double getFlightTimeToFault() const { return flightTimeToFault; }
+
+    /**
+     * @brief Select how faults are drawn (default: FaultModel::PerStep).
+     *
+     * With FaultModel::Exponential a fault time is sampled with rate faultProbability
+     * whenever a flight starts without a scheduled fault, and the flight faults exactly
+     * when it is reached. This is one draw per fault instead of one per step and does
+     * not depend on the step size. Unused flight time to fault carries over to the next
+     * flight, which is equivalent because the distribution is memoryless.
+     */
+    void setFaultModel(FaultModel model) { faultModel = model; }
+    FaultModel getFaultModel() const { return faultModel; }
+
+    // Random number generator used for this vehicle's fault checks
+    RandomGenerator& getRandomGenerator() const { return rng; }
+
     // Battery helpers
     double getPowerConsumptionRate() const {
         // [kWh/mile] * [mile/hour] = [kWh/hour]
@@ -288,6 +350,16 @@ public:
         return (batteryLevel / (energyUsePerMile * cruiseSpeed));
     }
 
+    double getChargeRate() const {
+        // [kWh] / [hours] = [kWh/hour]
+        return (batteryCapacity / timeToCharge);
+    }
+
+    double getTimeToFullCharge() const {
+        // ([kWh] - [kWh]) / [kWh/hour] = [hours]
+        return ((batteryCapacity - batteryLevel) / getChargeRate());
+    }
+
     double getBatteryPercent() const {
         return (batteryLevel / batteryCapacity) * 100.0;
     }
@@ -296,10 +368,32 @@ public:
     std::string getStateString() const;
     std::string getManufacturerString() const;
     int getId() const { return id; }
+    void setId(int vehicleId) { id = vehicleId; }
+
+    /**
+     * @brief Select the state machine of updateState() for vehicles of a built-in type.
+     *
+     * When enabled (the default in builds with EVTOL_TYPE_KERNELS) vehicles whose constants
+     * are those of their built-in type step through a kernel instantiated with the constants
+     * as constexpr values (see BuiltinVehicleType), every other vehicle through the generic
+     * kernel. Both produce identical results. Set before a run, not while vehicles update.
+     * @return false (and no change) when enabling in a build without the kernels.
+     */
+    static bool setTypeKernelsEnabled(bool enabled);
+    static bool getTypeKernelsEnabled();
+
+    // True if updateState() uses a built-in type kernel for this vehicle
+    bool usesTypeKernel() const;
 
 private:
-    int id; // Unique ID for the vehicle instance
-    static int nextId;            // Static counter for unique IDs
+    // Generic state machine, Type supplies the constants (see vehicle.cpp)
+    template <typename Type> void advance(double hours, const Type& type);
+    template <typename Type> double flyWith(double hours, const Type& type);
+    template <typename Type> double chargeWith(double hours, const Type& type);
+
+    static bool typeKernelsEnabled;
+
+    int id = 0; // Set by the simulation owning the vehicle, 0 for vehicles created on their own
     Manufacturer manufacturer;
     double cruiseSpeed;           // mph
     double batteryCapacity;       // kWh
@@ -307,7 +401,10 @@ private:
     double energyUsePerMile;      // kWh/mile
     int passengerCount;           // number of passengers
     double faultProbability;      // faults per hour
+    bool builtinType;             // Constants are exactly those of the built-in type
     RandomGenerator& rng;         // Random number generator for fault simulation
+    double flightTimeToFault = -1.0; // flight hours until a scheduled fault (< 0 = per-step check)
+    FaultModel faultModel = FaultModel::PerStep;
 
     State currentState;
     double batteryLevel;          // current battery level in kWh
@@ -316,9 +413,66 @@ private:
     VehicleStats totalStats;      // statistics for the total simulation
 };
 
-// Derived classes for each manufacturer
-// TODO: Should probably read these constructor constants from a configuration file or database
-//       in the future and move them to their own files for better organization in a larger project.
+/**
+ * @brief Constants of the built-in vehicle types, indexed by Vehicle::Manufacturer.
+ */
+constexpr VehicleTypeSpec BUILTIN_VEHICLE_TYPES[] = {
+    // cruiseSpeed, batteryCapacity, timeToCharge, energyUsePerMile, passengerCount, faultProbability
+    {120, 320, 0.6,  1.6, 4, 0.25}, // Alpha
+    {100, 100, 0.2,  1.5, 5, 0.10}, // Bravo
+    {160, 220, 0.8,  2.2, 3, 0.05}, // Charlie
+    { 90, 120, 0.62, 0.8, 2, 0.22}, // Delta
+    { 30, 150, 0.3,  5.8, 2, 0.61}, // Echo
+};
+static_assert(sizeof(BUILTIN_VEHICLE_TYPES) / sizeof(BUILTIN_VEHICLE_TYPES[0]) ==
+              static_cast<size_t>(Vehicle::Manufacturer::NumManufacturers),
+              "Every manufacturer needs a vehicle type spec");
+
+/**
+ * @brief Constants of a built-in vehicle type as compile-time values.
+ *
+ * Instantiates the vehicle state machine with constants the compiler can fold, including
+ * the derived charge rate, instead of loading them from the vehicle on every step.
+ */
+template <Vehicle::Manufacturer M>
+struct BuiltinVehicleType {
+    static constexpr VehicleTypeSpec spec = BUILTIN_VEHICLE_TYPES[static_cast<size_t>(M)];
+
+    static constexpr double cruiseSpeed = spec.cruiseSpeed;
+    static constexpr double batteryCapacity = spec.batteryCapacity;
+    static constexpr double energyUsePerMile = spec.energyUsePerMile;
+    static constexpr int passengerCount = spec.passengerCount;
+    static constexpr double faultProbability = spec.faultProbability;
+    static constexpr double chargeRate = spec.batteryCapacity / spec.timeToCharge; // [kWh/hour]
+};
+
+/**
+ * @brief Get the properties of a vehicle type, built-in or registered.
+ *
+ * The VehicleTypeRegistry is the single source of the per-type constants used by the
+ * derived vehicle classes, Simulation::createVehicle and the FleetSoA store.
+ * @throws std::out_of_range for an unknown type.
+ */
+const VehicleTypeSpec& getVehicleTypeSpec(Vehicle::Manufacturer manufacturer);
+
+/**
+ * @brief Get the display name of a vehicle type, "Unknown" for an unknown type.
+ */
+std::string getManufacturerName(Vehicle::Manufacturer manufacturer);
+
+/**
+ * @brief Get the display name of a vehicle state.
+ */
+std::string getStateName(Vehicle::State state);
+
+/**
+ * @brief Command line names of the fault models ("step", "exponential").
+ */
+std::string faultModelToString(Vehicle::FaultModel model);
+bool faultModelFromString(const std::string& name, Vehicle::FaultModel& model);
+
+// Derived classes for each built-in manufacturer, other types are plain Vehicles created from
+// their registry entry
 
 /**
  * @brief Alpha Company Vehicle class.
@@ -326,7 +480,7 @@ private:
 class AlphaCompanyVehicle : public Vehicle {
 public:
     AlphaCompanyVehicle(RandomGenerator& rng = Vehicle::defaultRng())
-        : Vehicle(Manufacturer::Alpha, 120, 320, 0.6, 1.6, 4, 0.25, rng) {}
+        : Vehicle(Manufacturer::Alpha, getVehicleTypeSpec(Manufacturer::Alpha), rng) {}
 };
 
 /**
@@ -335,7 +489,7 @@ public:
 class BravoCompanyVehicle : public Vehicle {
 public:
     BravoCompanyVehicle(RandomGenerator& rng = Vehicle::defaultRng())
-        : Vehicle(Manufacturer::Bravo, 100, 100, 0.2, 1.5, 5, 0.10, rng) {}
+        : Vehicle(Manufacturer::Bravo, getVehicleTypeSpec(Manufacturer::Bravo), rng) {}
 };
 
 /**
@@ -344,7 +498,7 @@ public:
 class CharlieCompanyVehicle : public Vehicle {
 public:
     CharlieCompanyVehicle(RandomGenerator& rng = Vehicle::defaultRng())
-        : Vehicle(Manufacturer::Charlie, 160, 220, 0.8, 2.2, 3, 0.05, rng) {}
+        : Vehicle(Manufacturer::Charlie, getVehicleTypeSpec(Manufacturer::Charlie), rng) {}
 };
 
 /**
@@ -353,7 +507,7 @@ public:
 class DeltaCompanyVehicle : public Vehicle {
 public:
     DeltaCompanyVehicle(RandomGenerator& rng = Vehicle::defaultRng())
-        : Vehicle(Manufacturer::Delta, 90, 120, 0.62, 0.8, 2, 0.22, rng) {}
+        : Vehicle(Manufacturer::Delta, getVehicleTypeSpec(Manufacturer::Delta), rng) {}
 };
 
 /**
@@ -362,7 +516,7 @@ public:
 class EchoCompanyVehicle : public Vehicle {
 public:
     EchoCompanyVehicle(RandomGenerator& rng = Vehicle::defaultRng())
-        : Vehicle(Manufacturer::Echo, 30, 150, 0.3, 5.8, 2, 0.61, rng) {}
+        : Vehicle(Manufacturer::Echo, getVehicleTypeSpec(Manufacturer::Echo), rng) {}
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+ * @file vehicle_registry.cpp
+ * @brief Implementation file for the VehicleTypeRegistry class
+ *
+ * See vehicle_registry.hpp for class documentation.
+ */
+
+#include "vehicle_registry.hpp"
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+VehicleTypeRegistry& VehicleTypeRegistry::instance() {
+    static VehicleTypeRegistry registry;
+    return registry;
+}
+
+VehicleTypeRegistry::VehicleTypeRegistry() {
+    reset();
+}
+
+void VehicleTypeRegistry::reset() {
+    static const char* const names[] = {"Alpha", "Bravo", "Charlie", "Delta", "Echo"};
+    static_assert(sizeof(names) / sizeof(names[0]) == BUILTIN_COUNT, "Every built-in type needs a name");
+
+    types.clear();
+    for (size_t i = 0; i < BUILTIN_COUNT; ++i) {
+        types.push_back({names[i], BUILTIN_VEHICLE_TYPES[i]});
+    }
+}
+
+void VehicleTypeRegistry::validate(const std::string& name, const VehicleTypeSpec& spec) {
+    auto positive = [](double value) { return std::isfinite(value) && value > 0; };
+    if (name.empty()) {
+        throw std::runtime_error("Vehicle type name must not be empty");
+    }
+    if (!positive(spec.cruiseSpeed) || !positive(spec.batteryCapacity) ||
+        !positive(spec.timeToCharge) || !positive(spec.energyUsePerMile)) {
+        throw std::runtime_error("Vehicle type " + name + ": speed, battery, charge time and energy use must be positive");
+    }
+    if (spec.passengerCount < 0) {
+        throw std::runtime_error("Vehicle type " + name + ": passenger count must not be negative");
+    }
+    if (!std::isfinite(spec.faultProbability) || spec.faultProbability < 0) {
+        throw std::runtime_error("Vehicle type " + name + ": fault probability must not be negative");
+    }
+}
+
+Vehicle::Manufacturer VehicleTypeRegistry::add(const std::string& name, const VehicleTypeSpec& spec) {
+    validate(name, spec);
+    Vehicle::Manufacturer existing;
+    if (find(name, existing)) {
+        throw std::runtime_error("Vehicle type " + name + " is already defined");
+    }
+    if (types.size() >= MAX_VEHICLE_TYPES) {
+        throw std::runtime_error("More than " + std::to_string(MAX_VEHICLE_TYPES) + " vehicle types");
+    }
+    types.push_back({name, spec});
+    return static_cast<Vehicle::Manufacturer>(types.size() - 1);
+}
+
+void VehicleTypeRegistry::load(std::istream& in, const std::string& source) {
+    // Parse into a copy so a bad line leaves the registry unchanged
+    VehicleTypeRegistry parsed = *this;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name)) {
+            continue; // Blank line
+        }
+
+        VehicleTypeSpec spec{};
+        std::string extra;
+        if (!(fields >> spec.cruiseSpeed >> spec.batteryCapacity >> spec.timeToCharge >>
+              spec.energyUsePerMile >> spec.passengerCount >> spec.faultProbability) || (fields >> extra)) {
+            throw std::runtime_error(source + ":" + std::to_string(lineNumber) +
+                                     ": expected <name> <cruise speed> <battery> <charge time> <energy per mile> <passengers> <fault probability>");
+        }
+        try {
+            parsed.add(name, spec);
+        } catch (const std::runtime_error& error) {
+            throw std::runtime_error(source + ":" + std::to_string(lineNumber) + ": " + error.what());
+        }
+    }
+    types = std::move(parsed.types);
+}
+
+void VehicleTypeRegistry::loadFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open vehicle type file " + filename);
+    }
+    load(file, filename);
+}
+
+const VehicleType& VehicleTypeRegistry::get(Vehicle::Manufacturer id) const {
+    if (!contains(id)) {
+        throw std::out_of_range("Unknown vehicle type");
+    }
+    return types[static_cast<size_t>(id)];
+}
+
+bool VehicleTypeRegistry::find(const std::string& name, Vehicle::Manufacturer& id) const {
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (types[i].name == name) {
+            id = static_cast<Vehicle::Manufacturer>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string VehicleTypeRegistry::fingerprint() const {
+    if (getRegisteredCount() == 0) {
+        return "";
+    }
+
+    // FNV-1a over the registered types with round-trip precision
+    std::ostringstream text;
+    text << std::setprecision(17);
+    for (size_t i = BUILTIN_COUNT; i < types.size(); ++i) {
+        const VehicleTypeSpec& spec = types[i].spec;
+        text << types[i].name << ' ' << spec.cruiseSpeed << ' ' << spec.batteryCapacity << ' ' << spec.timeToCharge << ' '
+             << spec.energyUsePerMile << ' ' << spec.passengerCount << ' ' << spec.faultProbability << '\n';
+    }
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text.str()) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+}
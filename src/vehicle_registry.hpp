@@ -0,0 +1,106 @@
+/**
+ * @file vehicle_registry.hpp
+ * @brief Header file for the VehicleTypeRegistry class
+ *
+ * The registry holds every vehicle type a simulation can create: the built-in types
+ * (Alpha to Echo, always the first ids) followed by the types registered at startup from
+ * a vehicle type file. A type id is a Vehicle::Manufacturer value, ids past
+ * Manufacturer::NumManufacturers belong to registered types.
+ *
+ * A vehicle type file has one type per line, fields separated by whitespace:
+ *
+ *     # name   cruise speed [mph]  battery [kWh]  charge time [h]  energy [kWh/mile]  passengers  faults [per hour]
+ *     Foxtrot  140                 280            0.7              1.9                4           0.12
+ *
+ * Blank lines and text after '#' are ignored. Names must be unique and must not repeat a
+ * built-in name.
+ *
+ * The process-wide registry is filled once at startup, before any simulation runs, and is
+ * read-only afterwards, so it is shared by every thread without locking.
+ */
+
+#ifndef VEHICLE_REGISTRY_HPP
+#define VEHICLE_REGISTRY_HPP
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "vehicle.hpp"
+
+const size_t MAX_VEHICLE_TYPES = 64; // Built-in and registered types, sizes the per-type tables
+
+struct VehicleType {
+    std::string name;
+    VehicleTypeSpec spec;
+};
+
+class VehicleTypeRegistry {
+public:
+    /**
+     * @brief The registry used by the simulation, the trace tools and getVehicleTypeSpec().
+     */
+    static VehicleTypeRegistry& instance();
+
+    // Only the built-in types
+    VehicleTypeRegistry();
+
+    /**
+     * @brief Drop every registered type, keeping the built-in ones.
+     */
+    void reset();
+
+    /**
+     * @brief Register a type after the existing ones.
+     * @return Id of the new type.
+     * @throws std::runtime_error if the name is taken, a constant is out of range or the
+     *         registry is full.
+     */
+    Vehicle::Manufacturer add(const std::string& name, const VehicleTypeSpec& spec);
+
+    /**
+     * @brief Register every type of a vehicle type file, see the file comment for the format.
+     * @param source Name used in error messages.
+     * @throws std::runtime_error with the source and line of the first invalid line, no type
+     *         of the file is registered in that case.
+     */
+    void load(std::istream& in, const std::string& source);
+    void loadFile(const std::string& filename);
+
+    size_t size() const { return types.size(); }
+    size_t getRegisteredCount() const { return types.size() - BUILTIN_COUNT; }
+    bool contains(Vehicle::Manufacturer id) const { return static_cast<size_t>(id) < types.size(); }
+
+    /**
+     * @throws std::out_of_range for an unknown id.
+     */
+    const VehicleType& get(Vehicle::Manufacturer id) const;
+
+    /**
+     * @return False if no type has this name.
+     */
+    bool find(const std::string& name, Vehicle::Manufacturer& id) const;
+
+    /**
+     * @brief Short hash of the registered types, empty with only the built-in types.
+     *
+     * Identifies the type set in cache keys, so results of runs with different type
+     * files are never mixed up.
+     */
+    std::string fingerprint() const;
+
+private:
+    static constexpr size_t BUILTIN_COUNT = static_cast<size_t>(Vehicle::Manufacturer::NumManufacturers);
+
+    static void validate(const std::string& name, const VehicleTypeSpec& spec);
+
+    std::vector<VehicleType> types;
+};
+
+/**
+ * @brief Number of types in the process-wide registry.
+ */
+inline size_t getNumVehicleTypes() { return VehicleTypeRegistry::instance().size(); }
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file vertiport.cpp
+ * @brief Implementation file for the VertiportNetwork class
+ *
+ * See vertiport.hpp for class documentation.
+ */
+
+#include "vertiport.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+/* Policy Names */
+std::string dispatchPolicyToString(DispatchPolicy policy) {
+    switch (policy) {
+        case DispatchPolicy::Fifo: return "fifo";
+        case DispatchPolicy::ShortestCharge: return "sjf";
+        case DispatchPolicy::MostPassengers: return "passengers";
+        case DispatchPolicy::FairShare: return "fair";
+        default: return "unknown";
+    }
+}
+
+bool dispatchPolicyFromString(const std::string& name, DispatchPolicy& policy) {
+    if (name == "fifo") {
+        policy = DispatchPolicy::Fifo;
+    } else if (name == "sjf") {
+        policy = DispatchPolicy::ShortestCharge;
+    } else if (name == "passengers") {
+        policy = DispatchPolicy::MostPassengers;
+    } else if (name == "fair") {
+        policy = DispatchPolicy::FairShare;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* VertiportNetwork */
+void VertiportNetwork::reset(int numSites, int numChargers, size_t numVehicles, size_t numTypes) {
+    if (numSites < 1 || numSites > numChargers) {
+        throw std::runtime_error("Number of vertiports must be between 1 and the number of chargers (" +
+                                 std::to_string(numChargers) + ")");
+    }
+
+    positions.assign(numVehicles, NOT_IN_HEAP);
+    sites.clear();
+    sites.reserve(numSites);
+    for (int i = 0; i < numSites; ++i) {
+        sites.push_back({Queue(&positions, resource), {}, false});
+    }
+    for (int charger = numChargers - 1; charger >= 0; --charger) {
+        sites[getChargerSite(charger)].freeChargers.push_back(charger);
+    }
+    activeSites = {};
+    queued = 0;
+    freeChargers = numChargers;
+    nextSequence = 0;
+
+    this->numTypes = numTypes;
+    virtualTimes.clear();
+    finishTags.clear();
+    if (policy == DispatchPolicy::FairShare) {
+        virtualTimes.assign(numSites, 0.0);
+        finishTags.assign(static_cast<size_t>(numSites) * numTypes, 0.0);
+    }
+}
+
+double VertiportNetwork::priorityOf(int site, const ChargeRequest& request) {
+    switch (policy) {
+        case DispatchPolicy::ShortestCharge:
+            return request.chargeHours;
+        case DispatchPolicy::MostPassengers:
+            return -static_cast<double>(request.passengers);
+        case DispatchPolicy::FairShare: {
+            // A type's next vehicle starts once the type's earlier vehicles have had their
+            // charger time, so every type waiting at a site gets the same charger time
+            double& finish = finishTags[static_cast<size_t>(site) * numTypes + request.type];
+            double start = std::max(virtualTimes[site], finish);
+            finish = start + request.chargeHours;
+            return start;
+        }
+        default:
+            return 0.0; // Arrival order only
+    }
+}
+
+void VertiportNetwork::enqueue(int site, size_t vehicle, const ChargeRequest& request) {
+    restoreQueued(site, vehicle, priorityOf(site, request));
+}
+
+void VertiportNetwork::restoreQueued(int site, size_t vehicle, double priority) {
+    sites[site].queue.push(vehicle, {priority, nextSequence++});
+    queued++;
+    activate(site);
+}
+
+std::vector<VertiportNetwork::Queue::Entry> VertiportNetwork::getQueue(int site) const {
+    const auto& entries = sites[site].queue.getEntries();
+    std::vector<Queue::Entry> order(entries.begin(), entries.end());
+    std::sort(order.begin(), order.end(),
+              [](const Queue::Entry& a, const Queue::Entry& b) { return a.key < b.key; });
+    return order;
+}
+
+void VertiportNetwork::releaseCharger(int charger) {
+    int site = getChargerSite(charger);
+    sites[site].freeChargers.push_back(charger);
+    freeChargers++;
+    activate(site);
+}
+
+void VertiportNetwork::setFreeChargers(const std::vector<int32_t>& chargers) {
+    for (auto& site : sites) {
+        site.freeChargers.clear();
+    }
+    for (int32_t charger : chargers) {
+        sites[getChargerSite(charger)].freeChargers.push_back(charger);
+    }
+    freeChargers = static_cast<int>(chargers.size());
+    activateAll();
+}
+
+bool VertiportNetwork::setFairShareState(const std::vector<double>& virtualTimes, const std::vector<double>& finishTags) {
+    if (virtualTimes.size() != this->virtualTimes.size() || finishTags.size() != this->finishTags.size()) {
+        return false;
+    }
+    this->virtualTimes = virtualTimes;
+    this->finishTags = finishTags;
+    return true;
+}
+
+void VertiportNetwork::activateAll() {
+    for (int site = 0; site < getSiteCount(); ++site) {
+        activate(site);
+    }
+}
+
+void VertiportNetwork::activate(int site) {
+    if (!sites[site].active) {
+        sites[site].active = true;
+        activeSites.push(site);
+    }
+}
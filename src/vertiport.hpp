@@ -0,0 +1,205 @@
+/**
+ * @file vertiport.hpp
+ * @brief Header file for the VertiportNetwork class
+ *
+ * The chargers of a simulation are spread over a network of vertiports (sites). Charger c
+ * belongs to site c % sites, so every site gets an equal share of the chargers. Each site
+ * has its own queue of vehicles waiting for one of its chargers and its own stack of free
+ * chargers, the lowest charger of a site is handed out first.
+ *
+ * The queue of a site is an IndexedHeap (indexed_heap.hpp) of vehicle indices ordered by
+ * the DispatchPolicy, ties in arrival order, so every policy costs O(log n) per arrival and
+ * per assigned charger. DispatchPolicy::Fifo is first come, first served.
+ *
+ * Chargers are only assigned at sites that changed since the last dispatch, a vehicle
+ * landed or a charger was freed there. Those sites are kept in a min-heap of site ids (a
+ * std::priority_queue), and an active flag per site keeps a site from being pushed twice
+ * before it is dispatched, so a dispatch touches the active sites in site order and costs
+ * nothing for the others: with hundreds of sites, the work per step follows the sites with
+ * arrivals and releases instead of sites x vehicles.
+ *
+ * A network of one site is the single global charger pool and queue of the simulation.
+ */
+
+#ifndef VERTIPORT_HPP
+#define VERTIPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "indexed_heap.hpp"
+
+const int DEFAULT_VERTIPORTS = 1; // Default number of vertiports, one shared charger pool
+
+/**
+ * @brief Order in which the waiting vehicles of a site get its free chargers.
+ */
+enum class DispatchPolicy {
+    Fifo,           // First come, first served (default)
+    ShortestCharge, // Least charger time first: charge time of the type times the battery deficit
+    MostPassengers, // Highest passenger capacity first
+    FairShare       // Equal charger time per manufacturer (start-time fair queueing)
+};
+
+const DispatchPolicy DEFAULT_DISPATCH_POLICY = DispatchPolicy::Fifo;
+
+std::string dispatchPolicyToString(DispatchPolicy policy);
+bool dispatchPolicyFromString(const std::string& name, DispatchPolicy& policy);
+
+/**
+ * @brief What a landing vehicle asks of the chargers, the input of the policies.
+ */
+struct ChargeRequest {
+    double chargeHours = 0.0; // Charger time to a full battery
+    int passengers = 0;
+    size_t type = 0;          // Vehicle type id
+};
+
+/**
+ * @brief Queue order of a waiting vehicle, smaller is served first.
+ */
+struct ChargePriority {
+    double value = 0.0;    // Policy key
+    uint64_t sequence = 0; // Arrival order, breaks ties
+
+    bool operator<(const ChargePriority& other) const {
+        return (value != other.value) ? (value < other.value) : (sequence < other.sequence);
+    }
+};
+
+class VertiportNetwork {
+public:
+    using Queue = IndexedHeap<ChargePriority>;
+
+    // Queues allocate from the resource, the simulation arena
+    explicit VertiportNetwork(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource(resource) {}
+
+    // Takes effect at the next reset()
+    void setPolicy(DispatchPolicy policy) { this->policy = policy; }
+    DispatchPolicy getPolicy() const { return policy; }
+
+    /**
+     * @brief Empty every queue and free every charger.
+     * @param numVehicles Vehicle indices are below this.
+     * @param numTypes Vehicle type ids are below this.
+     * @throws std::runtime_error unless 1 <= numSites <= numChargers, every site needs a charger.
+     */
+    void reset(int numSites, int numChargers, size_t numVehicles, size_t numTypes);
+
+    int getSiteCount() const { return static_cast<int>(sites.size()); }
+    int getChargerSite(int charger) const { return charger % getSiteCount(); }
+
+    // Vehicles waiting at every site and at one site
+    size_t getQueueLength() const { return queued; }
+    size_t getQueueLength(int site) const { return sites[site].queue.size(); }
+
+    // Waiting vehicles of a site with their priorities, in the order they will be served
+    std::vector<Queue::Entry> getQueue(int site) const;
+
+    // Free chargers of every site and of one site, top of the stack last
+    int getFreeChargerCount() const { return freeChargers; }
+    const std::vector<int>& getFreeChargers(int site) const { return sites[site].freeChargers; }
+
+    // Vehicles waiting per free charger at a site, negative if chargers are idle
+    long getBacklog(int site) const {
+        return static_cast<long>(sites[site].queue.size()) - static_cast<long>(sites[site].freeChargers.size());
+    }
+
+    /**
+     * @brief A vehicle lands at a site and waits for one of its chargers.
+     */
+    void enqueue(int site, size_t vehicle, const ChargeRequest& request);
+
+    /**
+     * @brief Put a vehicle back into a queue with the priority it had, e.g. from a checkpoint.
+     *
+     * Restore the vehicles of a site in their serving order, ties keep that order.
+     */
+    void restoreQueued(int site, size_t vehicle, double priority);
+
+    /**
+     * @brief A charger is free again, it goes to the top of its site's stack.
+     */
+    void releaseCharger(int charger);
+
+    /**
+     * @brief Replace the free chargers, e.g. with those of a checkpoint.
+     *
+     * Each site stacks its chargers in the order of the list, top last.
+     */
+    void setFreeChargers(const std::vector<int32_t>& chargers);
+
+    /**
+     * @brief State of the fair share policy: the virtual time of every site and the finish
+     *        tag of every site and type (site * types + type), empty for the other policies.
+     */
+    const std::vector<double>& getVirtualTimes() const { return virtualTimes; }
+    const std::vector<double>& getFinishTags() const { return finishTags; }
+    // False if the sizes do not fit the network
+    bool setFairShareState(const std::vector<double>& virtualTimes, const std::vector<double>& finishTags);
+
+    /**
+     * @brief Mark every site for the next dispatch, e.g. after restoring queues and chargers.
+     */
+    void activateAll();
+
+    /**
+     * @brief Hand the free chargers of every active site to its waiting vehicles, sites in order.
+     *
+     * take(vehicle, charger) is called for every vehicle at the front of a queue while the
+     * site has a free charger. The vehicle leaves the queue in any case, the charger is
+     * only taken from the site if take() returns true (false for a vehicle that no longer
+     * waits).
+     */
+    template <typename Take>
+    void dispatch(Take&& take) {
+        while (!activeSites.empty()) {
+            int index = activeSites.top();
+            activeSites.pop();
+            Site& site = sites[index];
+            site.active = false;
+            while (!site.freeChargers.empty() && !site.queue.empty()) {
+                const Queue::Entry front = site.queue.top();
+                site.queue.pop();
+                queued--;
+                if (take(front.handle, site.freeChargers.back())) {
+                    site.freeChargers.pop_back();
+                    freeChargers--;
+                    if (policy == DispatchPolicy::FairShare) {
+                        virtualTimes[index] = front.key.value; // Start tag of the vehicle in service
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Site {
+        Queue queue;
+        std::vector<int> freeChargers; // Stack, the lowest charger is on top initially
+        bool active = false;           // In activeSites
+    };
+
+    std::pmr::memory_resource* resource;
+    DispatchPolicy policy = DEFAULT_DISPATCH_POLICY;
+    std::vector<Site> sites;
+    std::vector<uint32_t> positions; // Heap position of every vehicle, shared by the site queues
+    std::priority_queue<int, std::vector<int>, std::greater<int>> activeSites; // Sites to dispatch, lowest first
+    size_t queued = 0;
+    int freeChargers = 0;
+    uint64_t nextSequence = 0;
+    size_t numTypes = 0;
+    std::vector<double> virtualTimes; // Fair share only
+    std::vector<double> finishTags;   // Fair share only
+
+    double priorityOf(int site, const ChargeRequest& request);
+    void activate(int site);
+};
+
+#endif
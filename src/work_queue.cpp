@@ -0,0 +1,690 @@
+/**
+ * @file work_queue.cpp
+ * @brief Implementation file for the WorkCoordinator and WorkWorker classes
+ *
+ * See work_queue.hpp for class and protocol documentation.
+ */
+
+#include "work_queue.hpp"
+#include "vehicle_registry.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t WORK_MAGIC = 0x51575645;              // "EVWQ" in little endian, reads differently on other byte orders
+const uint32_t MAX_PAYLOAD = 1u << 20;               // Sanity limit on frame sizes
+const size_t FRAME_HEADER_SIZE = 2 * sizeof(uint32_t);
+const int KEEPALIVE_IDLE_SECONDS = 30;               // Silence before the first keepalive probe
+const int KEEPALIVE_INTERVAL_SECONDS = 10;
+const int KEEPALIVE_PROBES = 3;                      // Unanswered probes until a worker is lost
+
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL; // A lost peer is an error, not SIGPIPE
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+class PayloadWriter {
+public:
+    template <typename T>
+    void value(const T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalars are written raw");
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void text(const std::string& text) {
+        value(static_cast<uint32_t>(text.size()));
+        data += text;
+    }
+
+    std::string data;
+};
+
+class PayloadReader {
+public:
+    explicit PayloadReader(const std::string& data) : data(data) {}
+
+    template <typename T>
+    void value(T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalars are read raw");
+        if (!take(sizeof(value))) {
+            return;
+        }
+        std::memcpy(&value, data.data() + position - sizeof(value), sizeof(value));
+    }
+
+    void text(std::string& text) {
+        uint32_t length = 0;
+        value(length);
+        if (take(length)) {
+            text = data.substr(position - length, length);
+        }
+    }
+
+    // True if every read succeeded and the whole payload was read
+    bool done() const { return ok && position == data.size(); }
+
+private:
+    bool take(size_t bytes) {
+        ok = ok && data.size() - position >= bytes;
+        if (ok) {
+            position += bytes;
+        }
+        return ok;
+    }
+
+    const std::string& data;
+    size_t position = 0;
+    bool ok = true;
+};
+
+void enableKeepalive(int socket) {
+    int on = 1;
+    setsockopt(socket, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+#ifdef TCP_KEEPIDLE
+    setsockopt(socket, IPPROTO_TCP, TCP_KEEPIDLE, &KEEPALIVE_IDLE_SECONDS, sizeof(KEEPALIVE_IDLE_SECONDS));
+#endif
+#ifdef TCP_KEEPINTVL
+    setsockopt(socket, IPPROTO_TCP, TCP_KEEPINTVL, &KEEPALIVE_INTERVAL_SECONDS, sizeof(KEEPALIVE_INTERVAL_SECONDS));
+#endif
+#ifdef TCP_KEEPCNT
+    setsockopt(socket, IPPROTO_TCP, TCP_KEEPCNT, &KEEPALIVE_PROBES, sizeof(KEEPALIVE_PROBES));
+#endif
+#ifdef SO_NOSIGPIPE
+    setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+const uint32_t MAX_HISTOGRAM_BUCKETS = 1u << 16; // Sanity limit on the buckets of a received histogram
+
+void writeDistribution(PayloadWriter& out, const StreamingDistribution& distribution) {
+    const RunningMoments& moments = distribution.getMoments();
+    const LogHistogram& histogram = distribution.getHistogram();
+    out.value(moments.getCount());
+    out.value(moments.getMean());
+    out.value(moments.getSumOfSquares());
+    out.value(moments.getMin());
+    out.value(moments.getMax());
+    out.value(static_cast<uint32_t>(histogram.getIndices().size()));
+    for (size_t i = 0; i < histogram.getIndices().size(); ++i) {
+        out.value(histogram.getIndices()[i]);
+        out.value(histogram.getCounts()[i]);
+    }
+}
+
+bool readDistribution(PayloadReader& in, StreamingDistribution& distribution) {
+    uint64_t count = 0;
+    double mean = 0.0, m2 = 0.0, min = 0.0, max = 0.0;
+    uint32_t buckets = 0;
+    in.value(count);
+    in.value(mean);
+    in.value(m2);
+    in.value(min);
+    in.value(max);
+    in.value(buckets);
+    if (buckets > MAX_HISTOGRAM_BUCKETS) {
+        return false;
+    }
+    std::vector<uint32_t> indices(buckets);
+    std::vector<uint64_t> counts(buckets);
+    for (uint32_t i = 0; i < buckets; ++i) {
+        in.value(indices[i]);
+        in.value(counts[i]);
+    }
+    distribution.getMoments().restore(count, mean, m2, min, max);
+    return distribution.getHistogram().restore(indices, counts) && distribution.getHistogram().getCount() == count;
+}
+
+// Why a worker's hello is not accepted, empty if it is
+std::string checkHello(const std::string& payload) {
+    PayloadReader in(payload);
+    uint32_t magic = 0;
+    uint32_t protocol = 0;
+    int32_t results = 0;
+    std::string types;
+    in.value(magic);
+    in.value(protocol);
+    in.value(results);
+    in.text(types);
+    if (!in.done() || magic != WORK_MAGIC) {
+        return "not an eVTOL worker, or a different byte order";
+    }
+    if (protocol != WORK_PROTOCOL_VERSION || results != SIMULATION_RESULTS_VERSION) {
+        return "worker protocol " + std::to_string(protocol) + ", results version " + std::to_string(results) +
+               ", coordinator protocol " + std::to_string(WORK_PROTOCOL_VERSION) + ", results version " +
+               std::to_string(SIMULATION_RESULTS_VERSION);
+    }
+    if (types != VehicleTypeRegistry::instance().fingerprint()) {
+        return "the worker's vehicle types differ, pass the coordinator's --vehicle-types file";
+    }
+    return "";
+}
+
+} // namespace
+
+/* Messages */
+std::string encodeWorkHello() {
+    PayloadWriter out;
+    out.value(WORK_MAGIC);
+    out.value(WORK_PROTOCOL_VERSION);
+    out.value(static_cast<int32_t>(SIMULATION_RESULTS_VERSION));
+    out.text(VehicleTypeRegistry::instance().fingerprint());
+    return out.data;
+}
+
+std::string encodeWorkItem(uint64_t item, const RunConfig& config) {
+    PayloadWriter out;
+    out.value(item);
+    out.value(static_cast<int32_t>(config.numVehicles));
+    out.value(config.simHours);
+    out.value(static_cast<int32_t>(config.numChargers));
+    out.value(static_cast<int32_t>(config.vertiports));
+    out.value(static_cast<uint8_t>(config.dispatchPolicy));
+    out.value(config.simTimeStepSeconds);
+    out.value(static_cast<uint8_t>(config.randomizeVehicles));
+    out.value(static_cast<uint8_t>(config.engine));
+    out.value(static_cast<uint8_t>(config.faultModel));
+    out.value(static_cast<int32_t>(config.threads));
+    out.value(config.seed);
+    out.value(static_cast<uint32_t>(config.fleetComposition.size()));
+    for (int count : config.fleetComposition) {
+        out.value(static_cast<int32_t>(count));
+    }
+    return out.data;
+}
+
+bool decodeWorkItem(const std::string& payload, uint64_t& item, RunConfig& config) {
+    PayloadReader in(payload);
+    RunConfig decoded;
+    int32_t numVehicles = 0;
+    int32_t numChargers = 0;
+    int32_t vertiports = 0;
+    uint8_t dispatchPolicy = 0;
+    int32_t threads = 0;
+    uint8_t randomize = 0;
+    uint8_t engine = 0;
+    uint8_t faultModel = 0;
+    in.value(item);
+    in.value(numVehicles);
+    in.value(decoded.simHours);
+    in.value(numChargers);
+    in.value(vertiports);
+    in.value(dispatchPolicy);
+    in.value(decoded.simTimeStepSeconds);
+    in.value(randomize);
+    in.value(engine);
+    in.value(faultModel);
+    in.value(threads);
+    in.value(decoded.seed);
+    uint32_t fleetTypes = 0;
+    in.value(fleetTypes);
+    int64_t fleetVehicles = 0;
+    bool fleetValid = fleetTypes <= MAX_VEHICLE_TYPES;
+    for (uint32_t i = 0; i < fleetTypes && fleetValid; ++i) {
+        int32_t count = 0;
+        in.value(count);
+        fleetValid = count >= 0;
+        fleetVehicles += count;
+        decoded.fleetComposition.push_back(count);
+    }
+    if (!fleetValid || (fleetTypes > 0 && fleetVehicles != numVehicles)) {
+        return false;
+    }
+    if (!in.done() || numVehicles <= 0 || vertiports <= 0 || vertiports > numChargers || threads <= 0 || !(decoded.simHours > 0) ||
+        !(decoded.simTimeStepSeconds > 0) || engine > static_cast<uint8_t>(SimulationEngine::Adaptive) ||
+        faultModel > static_cast<uint8_t>(Vehicle::FaultModel::Exponential) ||
+        dispatchPolicy > static_cast<uint8_t>(DispatchPolicy::FairShare)) {
+        return false;
+    }
+    decoded.numVehicles = numVehicles;
+    decoded.numChargers = numChargers;
+    decoded.vertiports = vertiports;
+    decoded.dispatchPolicy = static_cast<DispatchPolicy>(dispatchPolicy);
+    decoded.threads = threads;
+    decoded.randomizeVehicles = randomize != 0;
+    decoded.engine = static_cast<SimulationEngine>(engine);
+    decoded.faultModel = static_cast<Vehicle::FaultModel>(faultModel);
+    config = decoded;
+    return true;
+}
+
+std::string encodeWorkResult(uint64_t item, const VehicleTypeStatsTable& typeStats) {
+    // Names and expected fault rates come from the registry, which matches on both sides
+    PayloadWriter out;
+    out.value(item);
+    out.value(static_cast<uint32_t>(typeStats.size()));
+    for (const auto& pair : typeStats) {
+        const VehicleTypeStats& stats = pair.second;
+        out.value(pair.first);
+        out.value(static_cast<int32_t>(stats.vehicleCount));
+        out.value(static_cast<int32_t>(stats.totalFlights));
+        out.value(static_cast<int32_t>(stats.totalCharges));
+        out.value(stats.totalFlightTime);
+        out.value(stats.totalDistance);
+        out.value(stats.totalChargingTime);
+        out.value(stats.totalQueuedTime);
+        out.value(static_cast<int32_t>(stats.totalFaults));
+        out.value(stats.totalPassengerMiles);
+        writeDistribution(out, stats.queueWaitTimes);
+        writeDistribution(out, stats.chargeTimes);
+        writeDistribution(out, stats.flightTimes);
+    }
+    return out.data;
+}
+
+bool decodeWorkResult(const std::string& payload, uint64_t& item, VehicleTypeStatsTable& typeStats) {
+    PayloadReader in(payload);
+    VehicleTypeStatsTable decoded;
+    uint32_t count = 0;
+    in.value(item);
+    in.value(count);
+    for (uint32_t i = 0; i < count && count <= MAX_VEHICLE_TYPES; ++i) {
+        Vehicle::Manufacturer manufacturer{};
+        int32_t vehicles = 0;
+        int32_t flights = 0;
+        int32_t charges = 0;
+        int32_t faults = 0;
+        in.value(manufacturer);
+        if (!VehicleTypeRegistry::instance().contains(manufacturer) || decoded.contains(manufacturer)) {
+            return false;
+        }
+        VehicleTypeStats& stats = decoded[manufacturer];
+        in.value(vehicles);
+        in.value(flights);
+        in.value(charges);
+        in.value(stats.totalFlightTime);
+        in.value(stats.totalDistance);
+        in.value(stats.totalChargingTime);
+        in.value(stats.totalQueuedTime);
+        in.value(faults);
+        in.value(stats.totalPassengerMiles);
+        if (!readDistribution(in, stats.queueWaitTimes) || !readDistribution(in, stats.chargeTimes) ||
+            !readDistribution(in, stats.flightTimes)) {
+            return false;
+        }
+        stats.manufacturer = manufacturer;
+        stats.manufacturerName = getManufacturerName(manufacturer);
+        stats.expectedFaultRate = getVehicleTypeSpec(manufacturer).faultProbability;
+        stats.vehicleCount = vehicles;
+        stats.totalFlights = flights;
+        stats.totalCharges = charges;
+        stats.totalFaults = faults;
+    }
+    if (!in.done() || count > MAX_VEHICLE_TYPES) {
+        return false;
+    }
+    typeStats = std::move(decoded);
+    return true;
+}
+
+/* WorkConnection */
+WorkConnection::WorkConnection(WorkConnection&& other) noexcept
+    : socket(other.socket), buffer(std::move(other.buffer)) {
+    other.socket = -1;
+}
+
+WorkConnection& WorkConnection::operator=(WorkConnection&& other) noexcept {
+    if (this != &other) {
+        close();
+        socket = other.socket;
+        buffer = std::move(other.buffer);
+        other.socket = -1;
+    }
+    return *this;
+}
+
+WorkConnection WorkConnection::connect(const std::string& host, uint16_t port, double timeoutSeconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+    std::string error;
+    do {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        int status = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+        if (status != 0) {
+            error = gai_strerror(status);
+        } else {
+            for (addrinfo* address = addresses; address; address = address->ai_next) {
+                int fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+                if (fd < 0) {
+                    continue;
+                }
+                if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+                    freeaddrinfo(addresses);
+                    enableKeepalive(fd);
+                    return WorkConnection(fd);
+                }
+                error = std::strerror(errno);
+                ::close(fd);
+            }
+            freeaddrinfo(addresses);
+        }
+        // The coordinator may not be listening yet
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    } while (std::chrono::steady_clock::now() < deadline);
+    throw std::runtime_error("Cannot connect to coordinator " + host + ":" + std::to_string(port) + ": " + error);
+}
+
+void WorkConnection::close() {
+    if (socket >= 0) {
+        ::close(socket);
+        socket = -1;
+    }
+    buffer.clear();
+}
+
+bool WorkConnection::send(WorkMessage type, const std::string& payload) {
+    if (socket < 0) {
+        return false;
+    }
+    std::string frame;
+    frame.reserve(FRAME_HEADER_SIZE + payload.size());
+    uint32_t header[2] = {static_cast<uint32_t>(type), static_cast<uint32_t>(payload.size())};
+    frame.append(reinterpret_cast<const char*>(header), sizeof(header));
+    frame += payload;
+
+    size_t sent = 0;
+    while (sent < frame.size()) {
+        ssize_t written = ::send(socket, frame.data() + sent, frame.size() - sent, SEND_FLAGS);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool WorkConnection::readAvailable() {
+    if (socket < 0) {
+        return false;
+    }
+    char chunk[4096];
+    ssize_t received;
+    do {
+        received = ::recv(socket, chunk, sizeof(chunk), 0);
+    } while (received < 0 && errno == EINTR);
+    if (received <= 0) {
+        return false;
+    }
+    buffer.append(chunk, static_cast<size_t>(received));
+    return true;
+}
+
+bool WorkConnection::nextFrame(WorkMessage& type, std::string& payload) {
+    if (buffer.size() < FRAME_HEADER_SIZE) {
+        return false;
+    }
+    uint32_t header[2];
+    std::memcpy(header, buffer.data(), sizeof(header));
+    if (header[1] > MAX_PAYLOAD) {
+        close(); // Not a work queue peer, nothing more can be parsed
+        return false;
+    }
+    if (buffer.size() < FRAME_HEADER_SIZE + header[1]) {
+        return false;
+    }
+    type = static_cast<WorkMessage>(header[0]);
+    payload = buffer.substr(FRAME_HEADER_SIZE, header[1]);
+    buffer.erase(0, FRAME_HEADER_SIZE + header[1]);
+    return true;
+}
+
+bool WorkConnection::receive(WorkMessage& type, std::string& payload) {
+    while (!nextFrame(type, payload)) {
+        if (!readAvailable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* WorkCoordinator */
+WorkCoordinator::WorkCoordinator(const WorkCoordinatorSettings& settings)
+    : settings(settings) {
+    listenSocket = ::socket(AF_INET6, SOCK_STREAM, 0);
+    bool ipv6 = listenSocket >= 0;
+    if (!ipv6) {
+        listenSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+    }
+    if (listenSocket < 0) {
+        throw std::runtime_error(std::string("Cannot create coordinator socket: ") + std::strerror(errno));
+    }
+    int on = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    // Dual-stack where available, so workers reach the coordinator over IPv4 and IPv6
+    int status;
+    if (ipv6) {
+        int off = 0;
+        setsockopt(listenSocket, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+        sockaddr_in6 address{};
+        address.sin6_family = AF_INET6;
+        address.sin6_addr = in6addr_any;
+        address.sin6_port = htons(settings.port);
+        status = bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    } else {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(settings.port);
+        status = bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+    if (status != 0 || listen(listenSocket, SOMAXCONN) != 0) {
+        std::string error = std::strerror(errno);
+        ::close(listenSocket);
+        throw std::runtime_error("Cannot listen on port " + std::to_string(settings.port) + ": " + error);
+    }
+
+    sockaddr_storage bound{};
+    socklen_t length = sizeof(bound);
+    getsockname(listenSocket, reinterpret_cast<sockaddr*>(&bound), &length);
+    port = ntohs(bound.ss_family == AF_INET6 ? reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port
+                                             : reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+}
+
+WorkCoordinator::~WorkCoordinator() {
+    for (auto& worker : workers) {
+        worker.connection.send(WorkMessage::Done);
+    }
+    ::close(listenSocket);
+}
+
+void WorkCoordinator::acceptWorker() {
+    int fd = accept(listenSocket, nullptr, nullptr);
+    if (fd >= 0) {
+        enableKeepalive(fd);
+        workers.push_back({WorkConnection(fd)});
+    }
+}
+
+std::vector<VehicleTypeStatsTable> WorkCoordinator::run(const std::vector<RunConfig>& configs) {
+    using Clock = std::chrono::steady_clock;
+    struct Item {
+        bool done = false;
+        int running = 0;              // Workers running the item
+        int attempts = 0;             // Workers lost while running it
+        Clock::time_point handedOut;  // Last time the item was handed to a worker
+    };
+    std::vector<Item> items(configs.size());
+    std::vector<VehicleTypeStatsTable> results(configs.size());
+    std::deque<size_t> pending;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        pending.push_back(i);
+    }
+    size_t remaining = configs.size();
+
+    // Items of lost workers are retried first
+    auto lose = [&](Worker& worker) {
+        if (worker.item >= 0) {
+            Item& item = items[worker.item];
+            item.running--;
+            if (!item.done && item.running == 0) {
+                if (++item.attempts >= settings.maxAttempts) {
+                    throw std::runtime_error("Work item " + std::to_string(worker.item) + " lost " +
+                                             std::to_string(item.attempts) + " workers");
+                }
+                pending.push_front(static_cast<size_t>(worker.item));
+                retries++;
+            }
+            worker.item = -1;
+        }
+        worker.connection.close();
+    };
+
+    while (remaining > 0) {
+        // Items running past the timeout are also handed to the next idle worker
+        if (settings.itemTimeoutSeconds > 0) {
+            auto now = Clock::now();
+            for (size_t i = 0; i < items.size(); ++i) {
+                Item& item = items[i];
+                if (!item.done && item.running > 0 &&
+                    std::chrono::duration<double>(now - item.handedOut).count() > settings.itemTimeoutSeconds &&
+                    std::find(pending.begin(), pending.end(), i) == pending.end()) {
+                    pending.push_back(i);
+                    item.handedOut = now;
+                    retries++;
+                }
+            }
+        }
+
+        for (auto& worker : workers) {
+            while (worker.connection.isOpen() && worker.ready && worker.item < 0 && !pending.empty()) {
+                size_t next = pending.front();
+                pending.pop_front();
+                if (items[next].done) {
+                    continue;
+                }
+                worker.item = static_cast<long>(next);
+                items[next].running++;
+                items[next].handedOut = Clock::now();
+                if (!worker.connection.send(WorkMessage::Work, encodeWorkItem(next, configs[next]))) {
+                    lose(worker);
+                }
+            }
+        }
+        workers.erase(std::remove_if(workers.begin(), workers.end(),
+                                     [](const Worker& worker) { return !worker.connection.isOpen(); }),
+                      workers.end());
+
+        std::vector<pollfd> sockets(workers.size() + 1);
+        sockets[0] = {listenSocket, POLLIN, 0};
+        for (size_t i = 0; i < workers.size(); ++i) {
+            sockets[i + 1] = {workers[i].connection.getSocket(), POLLIN, 0};
+        }
+        if (poll(sockets.data(), sockets.size(), 1000) < 0 && errno != EINTR) {
+            throw std::runtime_error(std::string("Coordinator poll failed: ") + std::strerror(errno));
+        }
+
+        for (size_t i = 0; i < workers.size(); ++i) {
+            Worker& worker = workers[i];
+            if (!(sockets[i + 1].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            if (!worker.connection.readAvailable()) {
+                lose(worker);
+                continue;
+            }
+
+            WorkMessage type;
+            std::string payload;
+            while (worker.connection.nextFrame(type, payload)) {
+                if (type == WorkMessage::Hello && !worker.ready) {
+                    std::string reason = checkHello(payload);
+                    if (!reason.empty()) {
+                        worker.connection.send(WorkMessage::Reject, reason);
+                        lose(worker);
+                        break;
+                    }
+                    worker.ready = true;
+                    workersSeen++;
+                    continue;
+                }
+
+                uint64_t id = 0;
+                VehicleTypeStatsTable typeStats;
+                if (type != WorkMessage::Result || !decodeWorkResult(payload, id, typeStats) ||
+                    static_cast<long>(id) != worker.item) {
+                    lose(worker); // Protocol error, treated like a lost worker
+                    break;
+                }
+                Item& item = items[id];
+                item.running--;
+                worker.item = -1;
+                if (!item.done) {
+                    item.done = true;
+                    results[id] = std::move(typeStats);
+                    remaining--;
+                }
+            }
+            if (!worker.connection.isOpen()) {
+                lose(worker);
+            }
+        }
+        if (sockets[0].revents & POLLIN) {
+            acceptWorker();
+        }
+    }
+
+    // Workers still on a duplicated item are done too, their result is not needed
+    for (auto& worker : workers) {
+        worker.connection.send(WorkMessage::Done);
+        worker.connection.close();
+    }
+    workers.clear();
+    return results;
+}
+
+/* WorkWorker */
+int WorkWorker::run() {
+    WorkConnection connection = WorkConnection::connect(host, port, connectTimeoutSeconds);
+    if (!connection.send(WorkMessage::Hello, encodeWorkHello())) {
+        throw std::runtime_error("Lost the coordinator");
+    }
+
+    int completed = 0;
+    WorkMessage type;
+    std::string payload;
+    while (connection.receive(type, payload)) {
+        switch (type) {
+            case WorkMessage::Done:
+                return completed;
+            case WorkMessage::Reject:
+                throw std::runtime_error("Rejected by the coordinator: " + payload);
+            case WorkMessage::Work: {
+                uint64_t item = 0;
+                RunConfig config;
+                if (!decodeWorkItem(payload, item, config)) {
+                    throw std::runtime_error("Malformed work item from the coordinator");
+                }
+                // Every item is a run of its own, with vehicle ids from 1 however many items came before
+                RunResults results = simulate(config);
+                if (!connection.send(WorkMessage::Result, encodeWorkResult(item, results.typeStats))) {
+                    throw std::runtime_error("Lost the coordinator");
+                }
+                completed++;
+                break;
+            }
+            default:
+                throw std::runtime_error("Unexpected message from the coordinator");
+        }
+    }
+    throw std::runtime_error("Lost the coordinator");
+}
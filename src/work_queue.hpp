@@ -0,0 +1,166 @@
+/**
+ * @file work_queue.hpp
+ * @brief Header file for the WorkCoordinator and WorkWorker classes
+ *
+ * Runs the replications or sweep cells of a batch on worker processes on other nodes. The
+ * coordinator listens on a TCP port and hands one work item (the RunConfig of a replication
+ * or sweep cell) at a time to every worker connection. A worker runs the item with
+ * simulate() and sends back its statistics per vehicle type. Results are stored by item,
+ * so the reduction over them is the one of the threaded runners and the output does not
+ * depend on the number of workers or on the order results arrive in.
+ *
+ * The item of a worker that disconnects, or that TCP keepalive finds dead, goes to the next
+ * idle worker; an item is given up after maxAttempts lost workers. With a timeout, items
+ * running longer are also handed to an idle worker and the first result counts.
+ *
+ * Every message is a frame of a uint32 message type, a uint32 payload length and the
+ * payload, in native byte order (the hello carries a byte order mark):
+ *
+ *     worker -> coordinator  Hello   magic, protocol version, results version, vehicle type fingerprint
+ *     coordinator -> worker  Work    item id, RunConfig
+ *     worker -> coordinator  Result  item id, statistics per vehicle type
+ *     coordinator -> worker  Done    no more work, the worker exits
+ *     coordinator -> worker  Reject  reason, the worker's build or vehicle types do not match
+ */
+
+#ifndef WORK_QUEUE_HPP
+#define WORK_QUEUE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "run.hpp"
+
+const uint32_t WORK_PROTOCOL_VERSION = 5;  // Bump whenever a message layout changes
+const uint16_t DEFAULT_WORK_PORT = 7411;   // Default coordinator port
+const int DEFAULT_WORK_ATTEMPTS = 3;       // Lost workers per item before a batch fails
+const double DEFAULT_CONNECT_TIMEOUT = 60.0; // Seconds a worker retries to reach the coordinator
+
+enum class WorkMessage : uint32_t {
+    Hello = 1,
+    Work = 2,
+    Result = 3,
+    Done = 4,
+    Reject = 5
+};
+
+// Payloads of the messages, decode functions return false for a malformed payload
+std::string encodeWorkHello();
+std::string encodeWorkItem(uint64_t item, const RunConfig& config);
+bool decodeWorkItem(const std::string& payload, uint64_t& item, RunConfig& config);
+std::string encodeWorkResult(uint64_t item, const VehicleTypeStatsTable& typeStats);
+bool decodeWorkResult(const std::string& payload, uint64_t& item, VehicleTypeStatsTable& typeStats);
+
+/**
+ * @brief One TCP connection carrying work queue frames.
+ */
+class WorkConnection {
+public:
+    explicit WorkConnection(int socket = -1) : socket(socket) {}
+    ~WorkConnection() { close(); }
+    WorkConnection(WorkConnection&& other) noexcept;
+    WorkConnection& operator=(WorkConnection&& other) noexcept;
+    WorkConnection(const WorkConnection&) = delete;
+    WorkConnection& operator=(const WorkConnection&) = delete;
+
+    /**
+     * @brief Connect to host:port, retrying until the timeout so workers may start first.
+     * @throws std::runtime_error if the coordinator cannot be reached.
+     */
+    static WorkConnection connect(const std::string& host, uint16_t port, double timeoutSeconds = DEFAULT_CONNECT_TIMEOUT);
+
+    bool isOpen() const { return socket >= 0; }
+    int getSocket() const { return socket; }
+    void close();
+
+    // False if the connection is lost
+    bool send(WorkMessage type, const std::string& payload = "");
+
+    /**
+     * @brief Read what the socket has, returns false on end of file or error.
+     *
+     * Blocks until at least some bytes arrived, call it after poll() reports input to never block.
+     */
+    bool readAvailable();
+
+    /**
+     * @brief Take the next complete frame of the bytes read so far.
+     * @return False if no complete frame has arrived yet.
+     */
+    bool nextFrame(WorkMessage& type, std::string& payload);
+
+    // Blocking readAvailable() until a frame is complete, false if the connection is lost first
+    bool receive(WorkMessage& type, std::string& payload);
+
+private:
+    int socket;
+    std::string buffer; // Bytes read that do not form a complete frame yet
+};
+
+struct WorkCoordinatorSettings {
+    uint16_t port = DEFAULT_WORK_PORT;          // 0 picks a free port, see getPort()
+    int maxAttempts = DEFAULT_WORK_ATTEMPTS;    // Lost workers per item before run() fails
+    double itemTimeoutSeconds = 0.0;            // Also hand out items running longer, 0 = never
+};
+
+class WorkCoordinator {
+public:
+    /**
+     * @brief Listen for workers, they may connect before run() is called.
+     * @throws std::runtime_error if the port cannot be bound.
+     */
+    explicit WorkCoordinator(const WorkCoordinatorSettings& settings);
+    ~WorkCoordinator();
+
+    uint16_t getPort() const { return port; }
+
+    /**
+     * @brief Run a batch on the connected workers, blocking until every item has a result.
+     *
+     * Usable as a BatchRunner. Workers are told they are done when the batch is complete.
+     * @throws std::runtime_error if an item lost more than maxAttempts workers.
+     */
+    std::vector<VehicleTypeStatsTable> run(const std::vector<RunConfig>& configs);
+
+    // Items handed out again after their worker was lost or timed out, over all batches
+    int getRetries() const { return retries; }
+    int getWorkersSeen() const { return workersSeen; }
+
+private:
+    struct Worker {
+        WorkConnection connection;
+        bool ready = false;   // Hello accepted
+        long item = -1;       // Item being run, -1 = idle
+    };
+
+    WorkCoordinatorSettings settings;
+    int listenSocket = -1;
+    uint16_t port = 0;
+    std::vector<Worker> workers;
+    int retries = 0;
+    int workersSeen = 0;
+
+    void acceptWorker();
+};
+
+class WorkWorker {
+public:
+    WorkWorker(const std::string& host, uint16_t port, double connectTimeoutSeconds = DEFAULT_CONNECT_TIMEOUT)
+        : host(host), port(port), connectTimeoutSeconds(connectTimeoutSeconds) {}
+
+    /**
+     * @brief Connect and run items until the coordinator is done.
+     * @return Number of items run.
+     * @throws std::runtime_error if the coordinator cannot be reached, rejects the worker or
+     *         is lost before it is done.
+     */
+    int run();
+
+private:
+    std::string host;
+    uint16_t port;
+    double connectTimeoutSeconds;
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef MOCK_RNG_HPP
+#define MOCK_RNG_HPP
+
+#include <gmock/gmock.h>
+#include "interface_rng.hpp"
+
+class MockRandomGenerator : public RandomGenerator {
+    public:
+        MOCK_METHOD(bool, bernoulli, (double p), (override));
+        MOCK_METHOD(int, uniformInt, (int min, int max), (override));
+        MOCK_METHOD(double, exponential, (double rate), (override));
+};
+
+#endif
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "checkpoint.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+std::string checkpointPath(SimulationEngine engine) {
+    return (std::filesystem::temp_directory_path() /
+            ("evtol_test_checkpoint_" + engineToString(engine) + ".bin")).string();
+}
+
+} // namespace
+
+TEST(CheckpointTest, ReadWriteRoundTrip) {
+    SCOPED_TRACE("REQ-SIM-014: Verifies a checkpoint reads back as written.");
+
+    Simulation sim(12, 0.5, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+    sim.setSeed(5);
+    sim.runSimulation();
+    SimulationCheckpoint written = sim.createCheckpoint();
+
+    std::string filename = checkpointPath(SimulationEngine::FixedStep);
+    ASSERT_TRUE(written.write(filename));
+    SimulationCheckpoint read;
+    ASSERT_TRUE(SimulationCheckpoint::read(filename, read));
+
+    EXPECT_EQ(read.numVehicles, 12);
+    EXPECT_EQ(read.numChargers, 2);
+    EXPECT_EQ(read.seed, 5u);
+    EXPECT_EQ(read.currentTime, written.currentTime);
+    EXPECT_EQ(read.stepCount, written.stepCount);
+    EXPECT_EQ(read.rngCounter, written.rngCounter);
+    ASSERT_EQ(read.vehicles.size(), written.vehicles.size());
+    for (size_t i = 0; i < read.vehicles.size(); ++i) {
+        EXPECT_EQ(read.vehicles[i].state, written.vehicles[i].state);
+        EXPECT_EQ(read.vehicles[i].batteryLevel, written.vehicles[i].batteryLevel);
+        EXPECT_EQ(read.vehicles[i].totalStats.flightTime, written.vehicles[i].totalStats.flightTime);
+        EXPECT_EQ(read.vehicles[i].rngCounter, written.vehicles[i].rngCounter);
+    }
+    EXPECT_EQ(read.chargingQueue, written.chargingQueue);
+    EXPECT_EQ(read.chargingStations, written.chargingStations);
+    EXPECT_EQ(read.freeChargers, written.freeChargers);
+
+    // A truncated file is rejected
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) / 2);
+    EXPECT_FALSE(SimulationCheckpoint::read(filename, read));
+    std::filesystem::remove(filename);
+}
+
+TEST(CheckpointTest, CorruptedCountsAreRejected) {
+    SCOPED_TRACE("REQ-SIM-014: Verifies a corrupted count is rejected without allocating its size.");
+
+    Simulation sim(12, 0.5, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+    sim.setSeed(5);
+    sim.runSimulation();
+    std::string filename = checkpointPath(SimulationEngine::FixedStep);
+    ASSERT_TRUE(sim.createCheckpoint().write(filename));
+    std::string bytes;
+    {
+        std::ifstream in(filename, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // A count of about 4e9 at every offset hits each vector and record count, which must
+    // fail the read instead of allocating (std::bad_alloc) gigabytes
+    const uint64_t huge = 0xF0000000ULL;
+    bool rejected = false;
+    for (size_t offset = 12; offset + sizeof(huge) <= bytes.size(); ++offset) {
+        std::string corrupted = bytes;
+        std::memcpy(&corrupted[offset], &huge, sizeof(huge));
+        {
+            std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+            out << corrupted;
+        }
+        SimulationCheckpoint read;
+        bool ok = true;
+        ASSERT_NO_THROW(ok = SimulationCheckpoint::read(filename, read)) << "Offset " << offset;
+        rejected = rejected || !ok;
+    }
+    EXPECT_TRUE(rejected);
+    std::filesystem::remove(filename);
+}
+
+TEST(CheckpointTest, ResumeMatchesUninterruptedRun) {
+    SCOPED_TRACE("REQ-SIM-014: Verifies a run resumed from a checkpoint ends with the results of an uninterrupted run.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::StructOfArrays,
+                                    SimulationEngine::EventDriven}) {
+        SCOPED_TRACE(engineToString(engine));
+        std::string filename = checkpointPath(engine);
+
+        // The checkpoint at 1.5 hours is the last one written before the end at 2 hours
+        Simulation full(40, 2.0, 3, 30.0, DEFAULT_VERBOSITY, true, false);
+        full.setEngine(engine);
+        full.setSeed(17);
+        full.setCheckpointInterval(0.75, filename);
+        full.runSimulation();
+
+        SimulationCheckpoint checkpoint;
+        ASSERT_TRUE(SimulationCheckpoint::read(filename, checkpoint));
+        EXPECT_LE(checkpoint.currentTime, 1.5 + 1e-9);
+        EXPECT_GT(checkpoint.currentTime, 1.0);
+
+        Simulation resumed(40, 2.0, 3, 30.0, DEFAULT_VERBOSITY, true, false);
+        resumed.setEngine(engine);
+        resumed.setSeed(17);
+        ASSERT_TRUE(resumed.resumeFrom(checkpoint));
+        resumed.runSimulation();
+
+        const auto& expected = full.getTypeStats();
+        const auto& actual = resumed.getTypeStats();
+        ASSERT_EQ(actual.size(), expected.size());
+        for (const auto& pair : expected) {
+            const auto& stats = actual.at(pair.first);
+            EXPECT_EQ(stats.vehicleCount, pair.second.vehicleCount);
+            EXPECT_EQ(stats.totalFlights, pair.second.totalFlights);
+            EXPECT_EQ(stats.totalCharges, pair.second.totalCharges);
+            EXPECT_EQ(stats.totalFaults, pair.second.totalFaults);
+            EXPECT_EQ(stats.totalFlightTime, pair.second.totalFlightTime);
+            EXPECT_EQ(stats.totalQueuedTime, pair.second.totalQueuedTime);
+            EXPECT_EQ(stats.totalChargingTime, pair.second.totalChargingTime);
+            EXPECT_EQ(stats.totalPassengerMiles, pair.second.totalPassengerMiles);
+            EXPECT_EQ(stats.queueWaitTimes.getCount(), pair.second.queueWaitTimes.getCount());
+            EXPECT_EQ(stats.queueWaitTimes.getHistogram().getCounts(), pair.second.queueWaitTimes.getHistogram().getCounts());
+            EXPECT_EQ(stats.flightTimes.getMoments().getMean(), pair.second.flightTimes.getMoments().getMean());
+        }
+        EXPECT_EQ(resumed.getChargerUtilization().getValues(), full.getChargerUtilization().getValues());
+        std::filesystem::remove(filename);
+    }
+}
+
+TEST(CheckpointTest, ResumeKeepsDispatchPolicy) {
+    SCOPED_TRACE("REQ-SIM-021: Verifies a resumed run keeps the queue order and fair share state of its policy.");
+
+    std::string filename = checkpointPath(SimulationEngine::FixedStep);
+    Simulation full(40, 2.0, 4, 30.0, DEFAULT_VERBOSITY, true, false);
+    full.setSeed(23);
+    full.setVertiports(2);
+    full.setDispatchPolicy(DispatchPolicy::FairShare);
+    full.setCheckpointInterval(0.75, filename);
+    full.runSimulation();
+
+    SimulationCheckpoint checkpoint;
+    ASSERT_TRUE(SimulationCheckpoint::read(filename, checkpoint));
+    EXPECT_EQ(checkpoint.dispatchPolicy, DispatchPolicy::FairShare);
+    EXPECT_EQ(checkpoint.queuePriorities.size(), checkpoint.chargingQueue.size());
+    EXPECT_EQ(checkpoint.siteVirtualTimes.size(), 2u);
+
+    Simulation otherPolicy(40, 2.0, 4, 30.0, DEFAULT_VERBOSITY, true, false);
+    otherPolicy.setVertiports(2);
+    EXPECT_FALSE(otherPolicy.resumeFrom(checkpoint));
+
+    Simulation resumed(40, 2.0, 4, 30.0, DEFAULT_VERBOSITY, true, false);
+    resumed.setSeed(23);
+    resumed.setVertiports(2);
+    resumed.setDispatchPolicy(DispatchPolicy::FairShare);
+    ASSERT_TRUE(resumed.resumeFrom(checkpoint));
+    resumed.runSimulation();
+    for (const auto& pair : full.getTypeStats()) {
+        const auto& stats = resumed.getTypeStats().at(pair.first);
+        EXPECT_EQ(stats.totalFlights, pair.second.totalFlights);
+        EXPECT_EQ(stats.totalQueuedTime, pair.second.totalQueuedTime);
+        EXPECT_EQ(stats.totalChargingTime, pair.second.totalChargingTime);
+    }
+    std::filesystem::remove(filename);
+}
+
+TEST(CheckpointTest, ResumeRejectsOtherConfiguration) {
+    SCOPED_TRACE("REQ-SIM-014: Verifies a checkpoint is only resumed by a simulation of the same fleet.");
+
+    Simulation sim(12, 0.5, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+    sim.runSimulation();
+    SimulationCheckpoint checkpoint = sim.createCheckpoint();
+
+    Simulation otherFleet(13, 1.0, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+    EXPECT_FALSE(otherFleet.resumeFrom(checkpoint));
+    Simulation otherEngine(12, 1.0, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+    otherEngine.setEngine(SimulationEngine::EventDriven);
+    EXPECT_FALSE(otherEngine.resumeFrom(checkpoint));
+
+    checkpoint.chargingQueue.push_back(12);
+    Simulation badIndex(12, 1.0, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+    EXPECT_FALSE(badIndex.resumeFrom(checkpoint));
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "counter_rng.hpp"
+#include <cmath>
+#include <vector>
+
+TEST(CounterRandomGeneratorTest, StreamsAreReproducible) {
+    SCOPED_TRACE("REQ-SIM-011: Verifies a stream is a pure function of seed, stream and draw index.");
+
+    CounterRandomGenerator first(7, 3);
+    CounterRandomGenerator second(7, 3);
+    CounterRandomGenerator otherStream(7, 4);
+    CounterRandomGenerator otherSeed(8, 3);
+
+    int differentStream = 0;
+    int differentSeed = 0;
+    for (uint64_t i = 0; i < 100; ++i) {
+        int value = first.uniformInt(0, 1000000);
+        EXPECT_EQ(value, second.uniformInt(0, 1000000));
+        differentStream += value != otherStream.uniformInt(0, 1000000);
+        differentSeed += value != otherSeed.uniformInt(0, 1000000);
+    }
+    EXPECT_GT(differentStream, 95);
+    EXPECT_GT(differentSeed, 95);
+    EXPECT_EQ(first.getCounter(), 100u);
+
+    // Repositioning the counter replays the stream
+    first.setCounter(10);
+    second.setCounter(10);
+    EXPECT_DOUBLE_EQ(first.exponential(2.0), second.exponential(2.0));
+    EXPECT_EQ(CounterRandomGenerator(7, 3).getCounter(), 0u);
+}
+
+TEST(CounterRandomGeneratorTest, BatchedDrawsMatchSingleDraws) {
+    SCOPED_TRACE("REQ-SIM-011: Verifies fillBernoulli and fillUniformInt give the same draws as the single calls.");
+
+    CounterRandomGenerator batched(42, 1);
+    CounterRandomGenerator single(42, 1);
+
+    std::vector<uint8_t> flags(257);
+    batched.fillBernoulli(0.3, flags.data(), flags.size());
+    for (uint8_t flag : flags) {
+        EXPECT_EQ(flag != 0, single.bernoulli(0.3));
+    }
+
+    std::vector<int> values(131);
+    batched.fillUniformInt(-5, 5, values.data(), values.size());
+    for (int value : values) {
+        EXPECT_EQ(value, single.uniformInt(-5, 5));
+    }
+    EXPECT_EQ(batched.getCounter(), single.getCounter());
+}
+
+TEST(CounterRandomGeneratorTest, Distributions) {
+    SCOPED_TRACE("REQ-SIM-011: Verifies draws stay in range and have the expected means.");
+
+    CounterRandomGenerator rng(1234, 0);
+    const int draws = 100000;
+
+    int hits = 0;
+    double uniformSum = 0.0;
+    double exponentialSum = 0.0;
+    for (int i = 0; i < draws; ++i) {
+        hits += rng.bernoulli(0.25);
+        int value = rng.uniformInt(1, 6);
+        ASSERT_GE(value, 1);
+        ASSERT_LE(value, 6);
+        uniformSum += value;
+        exponentialSum += rng.exponential(4.0);
+    }
+    EXPECT_NEAR(hits / static_cast<double>(draws), 0.25, 0.01);
+    EXPECT_NEAR(uniformSum / draws, 3.5, 0.03);
+    EXPECT_NEAR(exponentialSum / draws, 0.25, 0.005);
+
+    EXPECT_FALSE(rng.bernoulli(0.0));
+    EXPECT_TRUE(rng.bernoulli(1.0));
+    EXPECT_TRUE(std::isinf(rng.exponential(0.0)));
+}
@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "fleet_soa.hpp"
+#include "fleet_kernels.hpp"
+#include "vehicle.hpp"
+#include "mock_rng.hpp"
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+std::unique_ptr<Vehicle> makeVehicle(Vehicle::Manufacturer manufacturer, RandomGenerator& rng) {
+    return std::make_unique<Vehicle>(manufacturer, getVehicleTypeSpec(manufacturer), rng);
+}
+
+void expectStatsNear(const VehicleStats& actual, const VehicleStats& expected) {
+    EXPECT_NEAR(actual.flightTime, expected.flightTime, EPSILON);
+    EXPECT_NEAR(actual.queuedTime, expected.queuedTime, EPSILON);
+    EXPECT_NEAR(actual.distanceTraveled, expected.distanceTraveled, EPSILON);
+    EXPECT_NEAR(actual.chargingTime, expected.chargingTime, EPSILON);
+    EXPECT_NEAR(actual.faultedTime, expected.faultedTime, EPSILON);
+    EXPECT_EQ(actual.faults, expected.faults);
+    EXPECT_NEAR(actual.passengerMiles, expected.passengerMiles, EPSILON);
+    EXPECT_EQ(actual.flights, expected.flights);
+    EXPECT_EQ(actual.charges, expected.charges);
+}
+
+void expectMatches(const FleetSoA& fleet, size_t index, const Vehicle& vehicle) {
+    EXPECT_EQ(fleet.getState(index), vehicle.getCurrentState());
+    EXPECT_NEAR(fleet.getBatteryLevel(index), vehicle.getBatteryLevel(), EPSILON);
+    expectStatsNear(fleet.getStepStats(index), vehicle.getStepStats());
+    expectStatsNear(fleet.getTotalStats(index), vehicle.getTotalStats());
+}
+
+// Step a vehicle and its fleet entry side by side, charging whenever the vehicle queues
+void runSideBySide(FleetSoA& fleet, size_t index, Vehicle& vehicle, double hours, int steps) {
+    for (int step = 0; step < steps; ++step) {
+        SCOPED_TRACE("Step " + std::to_string(step));
+        vehicle.updateState(hours);
+        fleet.updateState(index, hours);
+        expectMatches(fleet, index, vehicle);
+
+        if (vehicle.getCurrentState() == Vehicle::State::Queued) {
+            vehicle.startCharging();
+            fleet.startCharging(index);
+            expectMatches(fleet, index, vehicle);
+        }
+    }
+}
+
+} // namespace
+
+class FleetSoATest : public ::testing::TestWithParam<Vehicle::Manufacturer> {
+protected:
+    MockRandomGenerator mockRng;
+    FleetSoA fleet;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    AllVehicleTypes,
+    FleetSoATest,
+    ::testing::Values(Vehicle::Manufacturer::Alpha, Vehicle::Manufacturer::Bravo, Vehicle::Manufacturer::Charlie,
+                      Vehicle::Manufacturer::Delta, Vehicle::Manufacturer::Echo)
+);
+
+TEST_P(FleetSoATest, TypeConstantsMatchVehicle) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies per-manufacturer constants are held once in the type table.");
+
+    auto vehicle = makeVehicle(GetParam(), mockRng);
+    const auto& type = fleet.typeConstants(GetParam());
+
+    EXPECT_DOUBLE_EQ(type.spec.cruiseSpeed, vehicle->getCruiseSpeed());
+    EXPECT_DOUBLE_EQ(type.spec.batteryCapacity, vehicle->getBatteryCapacity());
+    EXPECT_DOUBLE_EQ(type.spec.timeToCharge, vehicle->getTimeToCharge());
+    EXPECT_DOUBLE_EQ(type.spec.energyUsePerMile, vehicle->getEnergyUsePerMile());
+    EXPECT_EQ(type.spec.passengerCount, vehicle->getPassengerCount());
+    EXPECT_DOUBLE_EQ(type.spec.faultProbability, vehicle->getFaultProbability());
+    EXPECT_DOUBLE_EQ(type.chargeRate, vehicle->getChargeRate());
+
+    size_t index = fleet.add(GetParam());
+    EXPECT_EQ(fleet.getState(index), Vehicle::State::Ready);
+    EXPECT_DOUBLE_EQ(fleet.getBatteryLevel(index), vehicle->getBatteryCapacity());
+    EXPECT_DOUBLE_EQ(fleet.getMaxFlightTime(index), vehicle->getMaxFlightTime());
+}
+
+TEST_P(FleetSoATest, MatchesVehicleWithoutFaults) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies the fleet store produces the same states and statistics as Vehicle.");
+
+    EXPECT_CALL(mockRng, bernoulli(::testing::_))
+        .WillRepeatedly(::testing::Return(false));
+
+    auto vehicle = makeVehicle(GetParam(), mockRng);
+    size_t index = fleet.load(*vehicle);
+
+    // Steps do not divide flight or charge times evenly, so transitions happen mid-step
+    runSideBySide(fleet, index, *vehicle, 0.07, 200);
+}
+
+TEST_P(FleetSoATest, MatchesVehicleWithFaults) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies the fleet store faults exactly like Vehicle.");
+
+    EXPECT_CALL(mockRng, bernoulli(::testing::_))
+        .WillRepeatedly(::testing::Return(true));
+
+    auto vehicle = makeVehicle(GetParam(), mockRng);
+    size_t index = fleet.load(*vehicle);
+
+    runSideBySide(fleet, index, *vehicle, 0.07, 5);
+    EXPECT_EQ(fleet.getState(index), Vehicle::State::Faulted);
+}
+
+TEST_P(FleetSoATest, MatchesVehicleWithScheduledFault) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies scheduled fault times are honoured by the fleet store.");
+
+    auto vehicle = makeVehicle(GetParam(), mockRng);
+    vehicle->setFlightTimeToFault(vehicle->getMaxFlightTime() * 1.5); // Faults during the second flight
+    size_t index = fleet.load(*vehicle);
+
+    runSideBySide(fleet, index, *vehicle, 0.07, 200);
+    EXPECT_EQ(fleet.getState(index), Vehicle::State::Faulted);
+    EXPECT_EQ(fleet.getTotalStats(index).faults, 1);
+}
+
+TEST_P(FleetSoATest, MatchesVehicleWithExponentialFaults) {
+    SCOPED_TRACE("REQ-SIM-009, REQ-VEH-008: Verifies the fleet store samples exponential fault times like Vehicle.");
+
+    auto vehicle = makeVehicle(GetParam(), mockRng);
+    vehicle->setFaultModel(Vehicle::FaultModel::Exponential);
+    EXPECT_CALL(mockRng, bernoulli(::testing::_)).Times(0);
+    EXPECT_CALL(mockRng, exponential(vehicle->getFaultProbability()))
+        .WillRepeatedly(::testing::Return(vehicle->getMaxFlightTime() * 2.6));
+    size_t index = fleet.load(*vehicle);
+
+    runSideBySide(fleet, index, *vehicle, 0.07, 200);
+    EXPECT_EQ(fleet.getState(index), Vehicle::State::Faulted);
+}
+
+TEST_P(FleetSoATest, StoreRoundTrip) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies fleet entries can be copied back into a Vehicle facade.");
+
+    EXPECT_CALL(mockRng, bernoulli(::testing::_))
+        .WillRepeatedly(::testing::Return(false));
+
+    size_t index = fleet.add(GetParam(), mockRng);
+    fleet.updateState(index, 0.25);
+
+    auto vehicle = makeVehicle(GetParam(), mockRng);
+    fleet.store(index, *vehicle);
+    expectMatches(fleet, index, *vehicle);
+
+    FleetSoA copy;
+    size_t copyIndex = copy.load(*vehicle);
+    expectMatches(copy, copyIndex, *vehicle);
+}
+
+TEST(FleetSoAErrorTest, InvalidOperations) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies the fleet store rejects the same operations as Vehicle.");
+
+    MockRandomGenerator mockRng;
+    FleetSoA fleet;
+    size_t index = fleet.add(Vehicle::Manufacturer::Alpha);
+
+    EXPECT_THROW(fleet.startCharging(index), std::runtime_error);
+
+    auto bravo = makeVehicle(Vehicle::Manufacturer::Bravo, mockRng);
+    EXPECT_THROW(fleet.store(index, *bravo), std::invalid_argument);
+}
+
+namespace {
+
+// Deterministic generator so a Vehicle fleet and a FleetSoA can draw the same sequence
+class SequenceRandomGenerator : public RandomGenerator {
+public:
+    explicit SequenceRandomGenerator(uint64_t seed) : state(seed) {}
+
+    bool bernoulli(double p) override { return next() < p; }
+    int uniformInt(int min, int max) override { return min + static_cast<int>(next() * (max - min + 1)); }
+    double exponential(double rate) override { return -std::log(1.0 - next()) / rate; }
+
+private:
+    uint64_t state;
+
+    double next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+} // namespace
+
+class FleetKernelTest : public ::testing::TestWithParam<KernelIsa> {
+protected:
+    void SetUp() override {
+        if (!setKernelIsa(GetParam())) {
+            GTEST_SKIP() << kernelIsaToString(GetParam()) << " is not supported on this machine";
+        }
+    }
+
+    void TearDown() override {
+        setKernelIsa(detectKernelIsa());
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    AllKernels,
+    FleetKernelTest,
+    ::testing::Values(KernelIsa::Scalar, KernelIsa::Avx2, KernelIsa::Neon),
+    [](const ::testing::TestParamInfo<KernelIsa>& info) { return kernelIsaToString(info.param); }
+);
+
+TEST_P(FleetKernelTest, UpdateAllMatchesVehicle) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies the batch kernels give the same results as Vehicle::updateState within EPSILON.");
+
+    SequenceRandomGenerator vehicleRng(42);
+    SequenceRandomGenerator fleetRng(42);
+
+    // Odd size so the SIMD kernels also run their scalar tails
+    const int numVehicles = 103;
+    std::vector<std::unique_ptr<Vehicle>> vehicles;
+    FleetSoA fleet;
+    for (int i = 0; i < numVehicles; ++i) {
+        auto type = static_cast<Vehicle::Manufacturer>(i % getNumVehicleTypes());
+        vehicles.push_back(makeVehicle(type, vehicleRng));
+        fleet.add(type, fleetRng);
+        if (i % 7 == 0) {
+            // Mix scheduled and sampled faults
+            vehicles.back()->setFlightTimeToFault(0.1 * i);
+            fleet.flightTimeToFault[i] = 0.1 * i;
+        }
+    }
+
+    for (int step = 0; step < 300; ++step) {
+        const double hours = (step % 3 == 0) ? 0.05 : 0.013;
+        for (auto& vehicle : vehicles) {
+            vehicle->updateState(hours);
+        }
+        fleet.updateAll(hours);
+
+        for (int i = 0; i < numVehicles; ++i) {
+            SCOPED_TRACE("Step " + std::to_string(step) + ", vehicle " + std::to_string(i));
+            expectMatches(fleet, i, *vehicles[i]);
+
+            // Leave every third vehicle waiting so the Queued path is covered
+            if (vehicles[i]->getCurrentState() == Vehicle::State::Queued && (step + i) % 3 != 0) {
+                vehicles[i]->startCharging();
+                fleet.startCharging(i);
+            }
+        }
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
+
+TEST_P(FleetKernelTest, SkippedVehiclesAreLeftAsTheyAre) {
+    SCOPED_TRACE("REQ-SIM-023: Verifies updateRange leaves skipped waiting vehicles as they are and steps the rest like Vehicle::updateState.");
+
+    SequenceRandomGenerator vehicleRng(7);
+    SequenceRandomGenerator fleetRng(7);
+
+    // More than one block, so the skip flags are followed across blocks
+    const size_t numVehicles = 2 * FLEET_BLOCK_SIZE + 9;
+    std::vector<std::unique_ptr<Vehicle>> vehicles;
+    FleetSoA fleet;
+    for (size_t i = 0; i < numVehicles; ++i) {
+        auto type = static_cast<Vehicle::Manufacturer>(i % getNumVehicleTypes());
+        vehicles.push_back(makeVehicle(type, vehicleRng));
+        fleet.add(type, fleetRng);
+    }
+
+    std::vector<uint8_t> skip(numVehicles, 0);
+    int skipped = 0;
+    for (int step = 0; step < 200; ++step) {
+        for (size_t i = 0; i < numVehicles; ++i) {
+            if (!skip[i]) {
+                vehicles[i]->updateState(0.02);
+            }
+        }
+        fleet.updateRange(0, numVehicles, 0.02, skip.data());
+
+        for (size_t i = 0; i < numVehicles; ++i) {
+            SCOPED_TRACE("Step " + std::to_string(step) + ", vehicle " + std::to_string(i));
+            if (skip[i]) {
+                EXPECT_EQ(fleet.getState(i), vehicles[i]->getCurrentState());
+                EXPECT_EQ(fleet.getBatteryLevel(i), vehicles[i]->getBatteryLevel());
+                expectStatsNear(fleet.getStepStats(i), VehicleStats());
+                expectStatsNear(fleet.getTotalStats(i), vehicles[i]->getTotalStats());
+            } else {
+                expectMatches(fleet, i, *vehicles[i]);
+            }
+
+            // Waiting vehicles are skipped most steps, some of the queued ones get a charger
+            const Vehicle::State state = vehicles[i]->getCurrentState();
+            skip[i] = (state == Vehicle::State::Queued || state == Vehicle::State::Faulted) && (step + i) % 4 != 0;
+            skipped += skip[i];
+            if (state == Vehicle::State::Queued && !skip[i] && i % 3 != 0) {
+                vehicles[i]->startCharging();
+                fleet.startCharging(i);
+            }
+        }
+        if (HasFailure()) {
+            break;
+        }
+    }
+    EXPECT_GT(skipped, 0);
+}
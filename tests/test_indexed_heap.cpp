@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "indexed_heap.hpp"
+#include <vector>
+
+TEST(IndexedHeapTest, PopsInKeyOrder) {
+    SCOPED_TRACE("REQ-SIM-021: Verifies the heap serves the smallest key first and tracks every handle.");
+
+    std::vector<uint32_t> positions(8, NOT_IN_HEAP);
+    IndexedHeap<double> heap(&positions);
+    const double keys[] = {5.0, 1.0, 7.0, 3.0, 0.5, 6.0, 2.0, 4.0};
+    for (size_t handle = 0; handle < 8; ++handle) {
+        heap.push(handle, keys[handle]);
+    }
+    EXPECT_EQ(heap.size(), 8u);
+    EXPECT_TRUE(heap.contains(2));
+
+    std::vector<size_t> order;
+    for (; !heap.empty(); heap.pop()) {
+        order.push_back(heap.top().handle);
+    }
+    EXPECT_EQ(order, (std::vector<size_t>{4, 1, 6, 3, 7, 0, 5, 2}));
+    for (uint32_t position : positions) {
+        EXPECT_EQ(position, NOT_IN_HEAP);
+    }
+}
+
+TEST(IndexedHeapTest, UpdateAndErase) {
+    SCOPED_TRACE("REQ-SIM-021: Verifies a key can be changed and a handle removed in place.");
+
+    std::vector<uint32_t> positions(10, NOT_IN_HEAP);
+    IndexedHeap<int> first(&positions);
+    IndexedHeap<int> second(&positions); // Shares the position table
+    for (size_t handle = 0; handle < 10; ++handle) {
+        (handle % 2 == 0 ? first : second).push(handle, static_cast<int>(10 * handle));
+    }
+
+    first.update(8, -1); // Decrease-key moves it to the top
+    EXPECT_EQ(first.top().handle, 8u);
+    first.update(8, 100); // Increase-key moves it to the bottom
+    EXPECT_EQ(first.top().handle, 0u);
+    first.erase(0);
+    second.erase(5);
+    EXPECT_FALSE(first.contains(0));
+    EXPECT_FALSE(second.contains(5));
+    EXPECT_TRUE(second.contains(7));
+
+    std::vector<size_t> order;
+    for (; !first.empty(); first.pop()) {
+        order.push_back(first.top().handle);
+    }
+    EXPECT_EQ(order, (std::vector<size_t>{2, 4, 6, 8}));
+    for (; !second.empty(); second.pop()) {
+        order.push_back(second.top().handle);
+    }
+    EXPECT_EQ(order, (std::vector<size_t>{2, 4, 6, 8, 1, 3, 7, 9}));
+
+    second.push(5, 0);
+    second.clear();
+    EXPECT_FALSE(second.contains(5));
+}
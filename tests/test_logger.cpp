@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "logger.hpp"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+TEST(LoggerTest, IsEnabled) {
+    SCOPED_TRACE("Verifies verbosity guard matches the levels that are logged.");
+
+    Logger logger("", Logger::LogMode::STDOUT_ONLY, 1);
+    EXPECT_TRUE(logger.isEnabled(1));
+    EXPECT_FALSE(logger.isEnabled(2));
+
+    logger.setVerbosityLevel(2);
+    EXPECT_TRUE(logger.isEnabled(1));
+    EXPECT_TRUE(logger.isEnabled(2));
+}
+
+TEST(LoggerTest, LazyFormatterOnlyCalledWhenEnabled) {
+    SCOPED_TRACE("Verifies lazy log messages are only formatted when the verbosity level is enabled.");
+
+    Logger logger("", Logger::LogMode::STDOUT_ONLY, 1);
+    int calls = 0;
+    auto formatter = [&calls]() {
+        calls++;
+        return std::string("lazy message");
+    };
+
+    // Filtered out, formatter must not run
+    testing::internal::CaptureStdout();
+    logger.logLineLazy(2, formatter);
+    logger.logLazy(2, formatter);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+    EXPECT_EQ(calls, 0);
+
+    // Enabled, formatter runs once per message
+    testing::internal::CaptureStdout();
+    logger.logLineLazy(1, formatter, false);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "lazy message\n");
+    EXPECT_EQ(calls, 1);
+}
+
+class LoggerFileTest : public ::testing::Test {
+protected:
+    std::string fileName = "logger_test_output.txt";
+
+    void SetUp() override { std::remove(fileName.c_str()); }
+    void TearDown() override { std::remove(fileName.c_str()); }
+
+    std::vector<std::string> readLines() {
+        std::ifstream file(fileName);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(LoggerFileTest, AsyncWritesAllMessagesInOrder) {
+    SCOPED_TRACE("Verifies async file output keeps every message, in order, including messages longer than a record.");
+
+    const int numLines = 20000;
+    const std::string longMessage(1000, 'x');
+    {
+        Logger logger(fileName, Logger::LogMode::FILE_ONLY, 1);
+        logger.setAsync(true, 64); // Small ring buffer so the producer has to wait for the writer
+        for (int i = 0; i < numLines; i++) {
+            logger.logLine("Line " + std::to_string(i), false);
+        }
+        logger.logLine(longMessage, true);
+    }
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), static_cast<size_t>(numLines + 1));
+    for (int i = 0; i < numLines; i++) {
+        EXPECT_EQ(lines[i], "Line " + std::to_string(i));
+    }
+
+    // Timestamp prefix followed by the full message
+    EXPECT_EQ(lines.back().front(), '[');
+    EXPECT_EQ(lines.back().substr(lines.back().size() - longMessage.size()), longMessage);
+}
+
+TEST_F(LoggerFileTest, FlushWritesPendingOutput) {
+    SCOPED_TRACE("Verifies flush() makes pending output visible in the file for sync and async modes.");
+
+    for (bool async : {false, true}) {
+        std::remove(fileName.c_str());
+        Logger logger(fileName, Logger::LogMode::FILE_ONLY, 1);
+        logger.setFlushPolicy(Logger::FlushPolicy::OnExit);
+        logger.setAsync(async);
+
+        logger.logLine("first", false);
+        logger.logLine("second", false);
+        logger.flush();
+
+        auto lines = readLines();
+        ASSERT_EQ(lines.size(), 2u);
+        EXPECT_EQ(lines[0], "first");
+        EXPECT_EQ(lines[1], "second");
+    }
+}
+
+TEST_F(LoggerFileTest, FlushPolicyChangesWhileAsync) {
+    SCOPED_TRACE("Verifies the flush policy can be changed while the async writer runs, without losing output.");
+
+    const int numLines = 5000;
+    {
+        Logger logger(fileName, Logger::LogMode::FILE_ONLY, 1);
+        logger.setAsync(true, 64);
+        for (int i = 0; i < numLines; i++) {
+            if (i % 500 == 0) {
+                // The writer reads the policy on every pass, run with EVTOL_TSAN to check for races
+                bool interval = (i / 500) % 2 == 0;
+                logger.setFlushPolicy(interval ? Logger::FlushPolicy::Interval : Logger::FlushPolicy::OnExit, 1);
+                EXPECT_EQ(logger.getFlushPolicy(), interval ? Logger::FlushPolicy::Interval : Logger::FlushPolicy::OnExit);
+                EXPECT_EQ(logger.getFlushIntervalMs(), 1);
+            }
+            logger.logLine("Line " + std::to_string(i), false);
+        }
+    }
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), static_cast<size_t>(numLines));
+    EXPECT_EQ(lines.front(), "Line 0");
+    EXPECT_EQ(lines.back(), "Line " + std::to_string(numLines - 1));
+}
+
+TEST(TimestampCacheTest, MatchesReferenceFormat) {
+    SCOPED_TRACE("Verifies cached timestamps match full formatting across millisecond and second changes.");
+
+    auto reference = [](std::chrono::system_clock::time_point time) {
+        auto time_t = std::chrono::system_clock::to_time_t(time);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()) % 1000;
+        std::tm localTime;
+        localtime_r(&time_t, &localTime);
+        std::stringstream ss;
+        ss << std::put_time(&localTime, "%Y-%m-%d_%H:%M:%S");
+        ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+        return ss.str();
+    };
+
+    TimestampCache cache;
+    auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1753044832));
+    for (int ms = 0; ms < 3000; ms += 7) {
+        auto time = start + std::chrono::milliseconds(ms);
+        const char* formatted = cache.format(time);
+        EXPECT_EQ(std::strlen(formatted), TimestampCache::LENGTH);
+        EXPECT_EQ(std::string(formatted), reference(time));
+    }
+
+    EXPECT_EQ(Logger::getCurrentTimestamp().size(), TimestampCache::LENGTH);
+}
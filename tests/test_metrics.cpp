@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "simulation.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+struct Pair {
+    uint64_t first;
+    uint64_t second;
+};
+
+} // namespace
+
+TEST(MetricsTest, SeqLockReadsAreConsistent) {
+    SCOPED_TRACE("REQ-OUT-004: Verifies readers never see a partially published snapshot.");
+
+    SeqLock<Pair> lock;
+    EXPECT_EQ(lock.version(), 0u);
+    EXPECT_EQ(lock.load().first, 0u);
+    lock.store({0, ~0ULL});
+
+    const uint64_t stores = 200000;
+    std::thread writer([&lock, stores]() {
+        for (uint64_t i = 1; i <= stores; ++i) {
+            lock.store({i, ~i});
+        }
+    });
+    uint64_t last = 0;
+    bool consistent = true;
+    while (last < stores && consistent) {
+        Pair value = lock.load();
+        consistent = value.second == ~value.first && value.first >= last;
+        last = value.first;
+    }
+    writer.join();
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(lock.version(), stores + 1);
+}
+
+TEST(MetricsTest, SimulationWritesMetricsFile) {
+    SCOPED_TRACE("REQ-OUT-004: Verifies a run publishes its final state to the metrics file.");
+
+    std::string filename = (std::filesystem::temp_directory_path() / "evtol_test_metrics.prom").string();
+    std::filesystem::remove(filename);
+
+    Simulation sim(25, 1.0, 3, 30.0, DEFAULT_VERBOSITY, true, false);
+    sim.setSeed(2);
+    sim.setMetricsFile(filename, 10);
+    sim.runSimulation();
+
+    std::ifstream file(filename);
+    ASSERT_TRUE(file.good());
+    std::stringstream text;
+    text << file.rdbuf();
+    const std::string metrics = text.str();
+
+    EXPECT_NE(metrics.find("# TYPE evtol_steps_total counter"), std::string::npos);
+    EXPECT_NE(metrics.find("\nevtol_run_done 1\n"), std::string::npos);
+    EXPECT_NE(metrics.find("\nevtol_chargers 3\n"), std::string::npos);
+    EXPECT_NE(metrics.find("\nevtol_sim_length_hours 1\n"), std::string::npos);
+
+    int flights = 0;
+    for (const auto& pair : sim.getTypeStats()) {
+        std::string line = "evtol_flights_total{type=\"" + pair.second.manufacturerName + "\"} " +
+                           std::to_string(pair.second.totalFlights) + "\n";
+        EXPECT_NE(metrics.find(line), std::string::npos) << line;
+        flights += pair.second.totalFlights;
+    }
+    EXPECT_GT(flights, 0);
+    EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+    std::filesystem::remove(filename);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "simulation.hpp"
+#include <sstream>
+#include <thread>
+
+TEST(ProfilerTest, NestedPhasesAreTimedExclusively) {
+    SCOPED_TRACE("REQ-SIM-015: Verifies nested phases are not counted twice and add up to the run time.");
+
+    Profiler profiler;
+    profiler.begin();
+    {
+        ProfileScope outer(profiler, Profiler::Phase::AssignChargers);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+            ProfileScope inner(profiler, Profiler::Phase::UpdateVehicles);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    profiler.end();
+
+    EXPECT_GE(profiler.getSeconds(Profiler::Phase::AssignChargers), 0.019);
+    EXPECT_LT(profiler.getSeconds(Profiler::Phase::AssignChargers), 0.035);
+    EXPECT_GE(profiler.getSeconds(Profiler::Phase::UpdateVehicles), 0.019);
+    EXPECT_EQ(profiler.getCalls(Profiler::Phase::AssignChargers), 1u);
+    EXPECT_EQ(profiler.getCalls(Profiler::Phase::Logging), 0u);
+    EXPECT_DOUBLE_EQ(profiler.getCategorySeconds(Profiler::Category::Physics),
+                     profiler.getSeconds(Profiler::Phase::UpdateVehicles));
+
+    double sum = 0.0;
+    for (size_t i = 0; i < Profiler::NUM_PHASES; ++i) {
+        sum += profiler.getSeconds(static_cast<Profiler::Phase>(i));
+    }
+    EXPECT_DOUBLE_EQ(sum, profiler.getTotalSeconds());
+
+    profiler.count(Profiler::Counter::QueuePushes, 3);
+    std::ostringstream json;
+    profiler.writeJson(json);
+    EXPECT_NE(json.str().find("\"queue_pushes\": 3"), std::string::npos);
+    EXPECT_NE(json.str().find("\"name\": \"Assign chargers\", \"category\": \"scheduling\""), std::string::npos);
+}
+
+TEST(ProfilerTest, SimulationCounters) {
+    SCOPED_TRACE("REQ-SIM-015: Verifies a profiled run counts its transitions, queue pushes and random draws.");
+    if (!Profiler::ENABLED) {
+        GTEST_SKIP() << "Built without EVTOL_PROFILING";
+    }
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven}) {
+        SCOPED_TRACE(engineToString(engine));
+        Simulation sim(20, 2.0, 2, 30.0, DEFAULT_VERBOSITY, true, false);
+        sim.setEngine(engine);
+        sim.setSeed(3);
+        sim.runSimulation();
+
+        const Profiler& profiler = sim.getProfiler();
+        int flights = 0;
+        for (const auto& pair : sim.getTypeStats()) {
+            flights += pair.second.totalFlights;
+        }
+        EXPECT_GE(profiler.getCount(Profiler::Counter::StateTransitions), static_cast<uint64_t>(flights));
+        EXPECT_GT(profiler.getCount(Profiler::Counter::QueuePushes), 0u);
+        EXPECT_GT(profiler.getCount(Profiler::Counter::RngDraws), 0u);
+        EXPECT_GT(profiler.getCalls(Profiler::Phase::UpdateVehicles), 0u);
+        EXPECT_GT(profiler.getTotalSeconds(), 0.0);
+    }
+}
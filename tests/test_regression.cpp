@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "regression.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+VehicleTypeStatsTable makeStats(int flights, double flightHours, int faults) {
+    VehicleTypeStatsTable table;
+    VehicleTypeStats& stats = table[Vehicle::Manufacturer::Alpha];
+    stats.manufacturerName = "Alpha";
+    stats.vehicleCount = 100;
+    stats.totalFlights = flights;
+    stats.totalCharges = flights;
+    stats.totalFlightTime = flightHours;
+    stats.totalDistance = flightHours * 120.0;
+    stats.totalChargingTime = 50.0;
+    stats.totalQueuedTime = 0.5;
+    stats.totalFaults = faults;
+    stats.totalPassengerMiles = flightHours * 480.0;
+    stats.expectedFaultRate = 0.25;
+    return table;
+}
+
+} // namespace
+
+TEST(RegressionTest, ComparesWithTolerances) {
+    SCOPED_TRACE("REQ-SIM-025: Verifies exact cases must match the reference and statistical cases agree within the tolerance.");
+
+    VehicleTypeStatsTable reference = makeStats(400, 200.0, 50);
+    EXPECT_TRUE(compareTypeStats(reference, reference, true, 0.02, 4.0).empty());
+
+    // Rounding of a different summation order passes, one flight does not
+    VehicleTypeStatsTable rounded = makeStats(400, 200.0 * (1.0 + 1e-14), 50);
+    EXPECT_TRUE(compareTypeStats(reference, rounded, true, 0.02, 4.0).empty());
+    EXPECT_EQ(compareTypeStats(reference, makeStats(401, 200.0, 50), true, 0.02, 4.0),
+              (std::vector<std::string>{"Alpha flights: 401, reference 400", "Alpha charges: 401, reference 400"}));
+
+    // Statistical cases: 1% more flight hours pass at 2%, 5% do not
+    EXPECT_TRUE(compareTypeStats(reference, makeStats(410, 202.0, 52), false, 0.02, 4.0).empty());
+    std::vector<std::string> mismatches = compareTypeStats(reference, makeStats(400, 210.0, 50), false, 0.02, 4.0);
+    ASSERT_EQ(mismatches.size(), 3u); // Flight hours, miles and passenger miles
+    EXPECT_EQ(mismatches[0], "Alpha flight hours: 210, reference 200");
+
+    // Queued hours are short next to the fleet hours, small absolute differences pass
+    VehicleTypeStatsTable queued = makeStats(400, 200.0, 50);
+    queued.at(Vehicle::Manufacturer::Alpha).totalQueuedTime = 0.6;
+    EXPECT_TRUE(compareTypeStats(reference, queued, false, 0.02, 4.0).empty());
+    EXPECT_FALSE(compareTypeStats(reference, queued, true, 0.02, 4.0).empty());
+
+    VehicleTypeStatsTable other = reference;
+    other[Vehicle::Manufacturer::Bravo].manufacturerName = "Bravo";
+    EXPECT_EQ(compareTypeStats(reference, other, false, 0.02, 4.0),
+              (std::vector<std::string>{"Bravo: not in the reference run"}));
+    EXPECT_EQ(compareTypeStats(other, reference, false, 0.02, 4.0), (std::vector<std::string>{"Bravo: missing"}));
+}
+
+TEST(RegressionTest, FaultBounds) {
+    SCOPED_TRACE("REQ-SIM-025: Verifies fault counts are checked against a Poisson count at the expected rate.");
+
+    // 200 flight hours at 0.25 faults per hour: 50 expected, bound 5 * sqrt(50) + 1
+    EXPECT_TRUE(checkFaultBounds(makeStats(400, 200.0, 50)).empty());
+    EXPECT_TRUE(checkFaultBounds(makeStats(400, 200.0, 85)).empty());
+    EXPECT_EQ(checkFaultBounds(makeStats(400, 200.0, 87)).size(), 1u);
+    EXPECT_EQ(checkFaultBounds(makeStats(400, 200.0, 10)).size(), 1u);
+}
+
+TEST(RegressionTest, CasesAndBaseline) {
+    SCOPED_TRACE("REQ-SIM-025: Verifies every fault model has its reference first and baselines are validated.");
+
+    std::vector<RegressionCase> cases = RegressionRunner::cases(4);
+    EXPECT_EQ(cases.size(), 9u);
+    EXPECT_TRUE(cases[0].isReference());
+    for (Vehicle::FaultModel model : {Vehicle::FaultModel::PerStep, Vehicle::FaultModel::Exponential}) {
+        auto first = std::find_if(cases.begin(), cases.end(), [&](const RegressionCase& c) { return c.faultModel == model; });
+        ASSERT_NE(first, cases.end());
+        EXPECT_TRUE(first->isReference()) << first->label();
+    }
+    EXPECT_EQ(cases[3].label(), "soa/4/step");
+    EXPECT_EQ(RegressionRunner::cases(1).size(), 6u); // Without the threaded duplicates
+
+    RegressionResult result;
+    result.vehicleStepsPerSecond = 70.0;
+    EXPECT_FALSE(result.isSlower(0.25)); // No baseline
+    result.baselineStepsPerSecond = 100.0;
+    EXPECT_TRUE(result.isSlower(0.25));
+    EXPECT_FALSE(result.isSlower(0.35));
+
+    RegressionRunner runner{RegressionSettings()};
+    std::istringstream valid("# scenario case vehicle-steps/s\nfleet fixed/1/step 2.5e7\n\n");
+    EXPECT_NO_THROW(runner.readBaseline(valid));
+    std::istringstream malformed("fleet fixed/1/step fast\n");
+    EXPECT_THROW(runner.readBaseline(malformed), std::runtime_error);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "replay.hpp"
+#include <filesystem>
+
+namespace {
+
+std::string writeTrace(SimulationEngine engine, double simHours, VehicleTypeStatsTable& results) {
+    std::string filename = (std::filesystem::temp_directory_path() /
+                            ("evtol_test_replay_" + engineToString(engine) + ".evtrace")).string();
+    Simulation sim(30, simHours, 2, 30.0, DEFAULT_VERBOSITY, true, false);
+    sim.setEngine(engine);
+    sim.setSeed(11);
+    sim.setTraceFormat(TraceFormat::Binary, filename);
+    sim.runSimulation();
+    results = sim.getTypeStats();
+    return filename;
+}
+
+} // namespace
+
+TEST(ReplayTest, FindStep) {
+    SCOPED_TRACE("REQ-OUT-003: Verifies steps are found by time in a memory-mapped trace.");
+
+    VehicleTypeStatsTable results;
+    std::string filename = writeTrace(SimulationEngine::FixedStep, 1.0, results);
+
+    MappedTrace trace;
+    ASSERT_TRUE(trace.open(filename));
+    EXPECT_EQ(trace.getHeader().numVehicles, 30u);
+    EXPECT_EQ(trace.size() % 31u, 0u); // One step record and 30 vehicles per step
+    EXPECT_GE(trace.size(), 120u * 31u); // 30 s steps
+
+    for (double time : {0.0, 0.25, 0.251, 0.99}) {
+        size_t index = trace.findStep(time);
+        ASSERT_LT(index, trace.size());
+        ASSERT_TRUE(trace[index].isStep());
+        EXPECT_GE(trace[index].asStep().time, time - 1e-12);
+        EXPECT_LT(trace[index].asStep().time, time + 30.0 / 3600.0);
+    }
+    EXPECT_EQ(trace.findStep(2.0), trace.size());
+
+    std::filesystem::remove(filename);
+    EXPECT_FALSE(trace.open(filename));
+}
+
+TEST(ReplayTest, WindowsMatchSimulation) {
+    SCOPED_TRACE("REQ-OUT-003: Verifies windowed results add up to the results of the run for every engine.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven}) {
+        SCOPED_TRACE(engineToString(engine));
+        VehicleTypeStatsTable results;
+        std::string filename = writeTrace(engine, 2.0, results);
+
+        MappedTrace trace;
+        ASSERT_TRUE(trace.open(filename));
+        TraceReplay replay(trace);
+
+        auto whole = replay.typeStats({});
+        auto first = replay.typeStats({0.0, 0.75});
+        auto second = replay.typeStats({0.75, 2.0});
+        ASSERT_EQ(whole.size(), results.size());
+
+        int faults = 0;
+        for (const auto& pair : results) {
+            const auto& replayed = whole.at(pair.first);
+            EXPECT_EQ(replayed.vehicleCount, pair.second.vehicleCount);
+            EXPECT_EQ(replayed.totalFlights, pair.second.totalFlights);
+            EXPECT_EQ(replayed.totalCharges, pair.second.totalCharges);
+            EXPECT_EQ(replayed.totalFaults, pair.second.totalFaults);
+            EXPECT_NEAR(replayed.totalFlightTime, pair.second.totalFlightTime, 1e-9);
+            EXPECT_NEAR(replayed.totalPassengerMiles, pair.second.totalPassengerMiles, 1e-6);
+
+            EXPECT_EQ(first.at(pair.first).totalFlights + second.at(pair.first).totalFlights, replayed.totalFlights);
+            EXPECT_NEAR(first.at(pair.first).totalFlightTime + second.at(pair.first).totalFlightTime,
+                        replayed.totalFlightTime, 1e-9);
+            faults += pair.second.totalFaults;
+        }
+        EXPECT_EQ(static_cast<int>(replay.faultTimeline({}).size()), faults);
+
+        // The queue histogram covers the window exactly
+        double hours = 0.0;
+        for (const auto& pair : replay.queueLengthHistogram({0.5, 1.5})) {
+            EXPECT_GE(pair.first, 0);
+            hours += pair.second;
+        }
+        EXPECT_NEAR(hours, 1.0, 1e-9);
+
+        // Utilization buckets cover the window and their flight time adds up to the total
+        auto buckets = replay.utilization({}, 0.5);
+        ASSERT_EQ(buckets.size(), 4u);
+        EXPECT_DOUBLE_EQ(buckets.back().end, 2.0);
+        for (const auto& pair : results) {
+            double flightHours = 0.0;
+            for (const auto& bucket : buckets) {
+                double share = bucket.utilization[static_cast<size_t>(pair.first)];
+                EXPECT_GE(share, 0.0);
+                flightHours += share * pair.second.vehicleCount * (bucket.end - bucket.start);
+            }
+            EXPECT_NEAR(flightHours, pair.second.totalFlightTime, 1e-9);
+        }
+        std::filesystem::remove(filename);
+    }
+}
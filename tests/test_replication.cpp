@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "replication.hpp"
+#include <cmath>
+#include <vector>
+
+TEST(ReplicationTest, MetricSummary) {
+    SCOPED_TRACE("REQ-SIM-012: Verifies mean, sample standard deviation and the 95% confidence interval.");
+
+    MetricSummary summary = MetricSummary::fromSamples({2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0});
+    EXPECT_EQ(summary.samples, 8);
+    EXPECT_DOUBLE_EQ(summary.mean, 5.0);
+    EXPECT_NEAR(summary.stddev, std::sqrt(32.0 / 7.0), 1e-12);
+    EXPECT_NEAR(summary.ciHalfWidth, 2.365 * summary.stddev / std::sqrt(8.0), 1e-12);
+
+    MetricSummary single = MetricSummary::fromSamples({3.0});
+    EXPECT_DOUBLE_EQ(single.mean, 3.0);
+    EXPECT_DOUBLE_EQ(single.ciHalfWidth, 0.0);
+
+    // Large samples approach the normal quantile
+    EXPECT_NEAR(studentT95(1000), 1.962, 1e-3);
+    EXPECT_GT(studentT95(30), studentT95(31));
+
+    // Past the table the expansion matches the tabulated quantiles
+    EXPECT_NEAR(studentT95(31), 2.0395, 1e-4);
+    EXPECT_NEAR(studentT95(60), 2.0003, 1e-4);
+}
+
+TEST(ReplicationTest, ReplicationsAreIndependentAndReproducible) {
+    SCOPED_TRACE("REQ-SIM-012: Verifies replications use distinct seeds and do not depend on the thread count.");
+
+    ReplicationSettings settings;
+    settings.numVehicles = 30;
+    settings.simHours = 1.0;
+    settings.simTimeStepSeconds = 30.0;
+    settings.replications = 6;
+    settings.seed = 77;
+
+    std::vector<std::vector<VehicleTypeStatsTable>> runs;
+    for (int threads : {1, 3}) {
+        settings.threads = threads;
+        ReplicationRunner runner(settings);
+        runner.run();
+        ASSERT_EQ(runner.getResults().size(), 6u);
+        runs.push_back(runner.getResults());
+
+        EXPECT_NE(runner.getReplicationSeed(0), runner.getReplicationSeed(1));
+    }
+
+    for (size_t i = 0; i < runs[0].size(); ++i) {
+        ASSERT_EQ(runs[0][i].size(), runs[1][i].size());
+        for (const auto& pair : runs[0][i]) {
+            EXPECT_EQ(pair.second.vehicleCount, runs[1][i].at(pair.first).vehicleCount);
+            EXPECT_EQ(pair.second.totalFlightTime, runs[1][i].at(pair.first).totalFlightTime);
+        }
+    }
+
+    // Every metric is summarized for every vehicle type that appeared
+    ReplicationRunner runner(settings);
+    runner.run();
+    auto summaries = runner.summarize();
+    EXPECT_FALSE(summaries.empty());
+    for (const auto& pair : summaries) {
+        EXPECT_EQ(pair.second.size(), ReplicationRunner::metrics().size());
+    }
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "run.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Ids of the vehicles named in the per-vehicle lines of a run's log, e.g. "Vehicle 3 (Alpha)"
+std::set<int> loggedVehicleIds(const std::vector<std::string>& lines) {
+    std::set<int> ids;
+    for (const std::string& line : lines) {
+        size_t position = line.find("Vehicle ");
+        if (position != std::string::npos && line.find(" (", position) != std::string::npos &&
+            std::isdigit(static_cast<unsigned char>(line[position + 8]))) {
+            ids.insert(std::stoi(line.substr(position + 8)));
+        }
+    }
+    return ids;
+}
+
+// A log without its "Simulation Profile" section, which holds wall clock times in builds with EVTOL_PROFILING
+std::vector<std::string> withoutProfile(std::vector<std::string> lines) {
+    const std::string divider = std::string(110, '=') + "\n";
+    auto title = std::find(lines.begin(), lines.end(), "Simulation Profile\n");
+    if (title == lines.begin() || title == lines.end()) {
+        return lines;
+    }
+    // From the divider above the title up to the divider of the next section
+    auto next = std::find(title + 2, lines.end(), divider);
+    lines.erase(title - 1, next);
+    return lines;
+}
+
+} // namespace
+
+TEST(RunTest, SimulateHasNoSideEffects) {
+    SCOPED_TRACE("REQ-SIM-018: Verifies an in-process run creates no files and only logs to its sink.");
+
+    // Run in an empty directory, which must stay empty
+    const std::filesystem::path previous = std::filesystem::current_path();
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "evtol_run_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::filesystem::current_path(directory);
+
+    RunConfig config;
+    config.numVehicles = 30;
+    config.simHours = 2.0;
+    config.numChargers = 2;
+    config.simTimeStepSeconds = 30.0;
+    config.seed = 5;
+    testing::internal::CaptureStdout();
+    RunResults quiet = simulate(config);
+
+    std::vector<std::string> lines;
+    config.logSink = [&lines](const std::string& message) { lines.push_back(message); };
+    RunResults logged = simulate(config);
+    std::string console = testing::internal::GetCapturedStdout();
+
+    std::filesystem::current_path(previous);
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+    EXPECT_EQ(console, "");
+
+    // The sink gets the report, logging does not change the results
+    ASSERT_FALSE(lines.empty());
+    bool hasTable = false;
+    for (const auto& line : lines) {
+        hasTable = hasTable || line.find("Simulation Results by Vehicle Type") != std::string::npos;
+    }
+    EXPECT_TRUE(hasTable);
+    ASSERT_EQ(quiet.typeStats.size(), logged.typeStats.size());
+    for (const auto& pair : quiet.typeStats) {
+        EXPECT_EQ(pair.second.totalFlights, logged.typeStats.at(pair.first).totalFlights);
+        EXPECT_EQ(pair.second.totalQueuedTime, logged.typeStats.at(pair.first).totalQueuedTime);
+    }
+}
+
+TEST(RunTest, QueueMetrics) {
+    SCOPED_TRACE("REQ-SIM-018: Verifies the queue metrics of a run agree with its statistics.");
+
+    // Few chargers for many vehicles, so vehicles wait
+    RunConfig config;
+    config.numVehicles = 40;
+    config.simHours = 3.0;
+    config.numChargers = 1;
+    config.simTimeStepSeconds = 10.0;
+    config.seed = 11;
+    RunResults results = simulate(config);
+
+    double queuedTime = 0.0;
+    int vehicles = 0;
+    for (const auto& pair : results.typeStats) {
+        queuedTime += pair.second.totalQueuedTime;
+        vehicles += pair.second.vehicleCount;
+    }
+    EXPECT_EQ(vehicles, 40);
+    EXPECT_NEAR(results.simulatedHours, 3.0, 1e-9);
+    EXPECT_GT(results.steps, 0);
+    EXPECT_NEAR(results.queue.averageQueueLength, queuedTime / results.simulatedHours, 1e-12);
+    EXPECT_GT(results.queue.maxQueueLength, 1u);
+    EXPECT_LE(results.queue.maxQueueLength, 40u);
+    EXPECT_LE(results.queue.queuedAtEnd, results.queue.maxQueueLength);
+    EXPECT_GE(results.queue.averageQueueLength, 0.0);
+    EXPECT_GT(results.queue.chargerUtilization, 0.5);
+    EXPECT_LE(results.queue.chargerUtilization, 1.0 + 1e-9);
+}
+
+TEST(RunTest, ConcurrentRunsAreIndependent) {
+    SCOPED_TRACE("REQ-SIM-018: Verifies runs on many threads at once log the same vehicle ids and report as a run on its own.");
+
+    RunConfig config;
+    config.numVehicles = 20;
+    config.simHours = 1.0;
+    config.numChargers = 3;
+    config.simTimeStepSeconds = 60.0;
+    config.logVerbosity = 2; // Per-vehicle lines with the vehicle ids
+    config.seed = 7;
+    auto logRun = [](RunConfig run) {
+        std::vector<std::string> lines;
+        run.logSink = [&lines](const std::string& message) { lines.push_back(message); };
+        simulate(run);
+        return withoutProfile(lines);
+    };
+    const std::vector<std::string> expected = logRun(config);
+
+    // Ids are 1 to the number of vehicles
+    std::set<int> ids = loggedVehicleIds(expected);
+    ASSERT_EQ(ids.size(), 20u);
+    EXPECT_EQ(*ids.begin(), 1);
+    EXPECT_EQ(*ids.rbegin(), 20);
+
+    // Every thread runs twice, as a long-lived worker does
+    const int numThreads = 8;
+    std::vector<std::vector<std::string>> logs(numThreads * 2);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            logs[2 * t] = logRun(config);
+            logs[2 * t + 1] = logRun(config);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < logs.size(); ++i) {
+        EXPECT_EQ(logs[i], expected) << "Run " << i;
+    }
+}
+
+TEST(RunTest, BatchRunsNumberTheirOwnVehicles) {
+    SCOPED_TRACE("REQ-SIM-018: Verifies every run of a batch numbers its vehicles from 1, however many runs a thread had before.");
+
+    // More runs than threads, so every thread runs several in a row as a worker process does
+    std::vector<RunConfig> configs(12);
+    std::vector<std::vector<std::string>> logs(configs.size());
+    for (size_t i = 0; i < configs.size(); ++i) {
+        configs[i].numVehicles = 5 + static_cast<int>(i);
+        configs[i].simHours = 0.5;
+        configs[i].simTimeStepSeconds = 60.0;
+        configs[i].logVerbosity = 2;
+        configs[i].seed = i;
+        configs[i].logSink = [&logs, i](const std::string& message) { logs[i].push_back(message); };
+    }
+    std::vector<VehicleTypeStatsTable> results = simulateBatch(configs, 3);
+    ASSERT_EQ(results.size(), configs.size());
+    for (size_t i = 0; i < configs.size(); ++i) {
+        std::set<int> ids = loggedVehicleIds(logs[i]);
+        ASSERT_EQ(ids.size(), static_cast<size_t>(configs[i].numVehicles)) << "Run " << i;
+        EXPECT_EQ(*ids.begin(), 1) << "Run " << i;
+        EXPECT_EQ(*ids.rbegin(), configs[i].numVehicles) << "Run " << i;
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "scenario.hpp"
+#include "simulation.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+Scenario parse(const std::string& text) {
+    std::istringstream in(text);
+    return Scenario::load(in, "scenario.txt");
+}
+
+// Message of the error a malformed scenario throws
+std::string parseError(const std::string& text) {
+    try {
+        parse(text);
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+} // namespace
+
+TEST(ScenarioTest, ParsesSettingsAndFleet) {
+    SCOPED_TRACE("REQ-SIM-024: Verifies a scenario file is parsed into its settings and fleet composition.");
+
+    Scenario scenario = parse("# Morning peak\n"
+                              "hours      6.5\n"
+                              "chargers   8   # two sites\n"
+                              "\n"
+                              "vertiports 2\n"
+                              "dispatch   fair\n"
+                              "engine     soa\n"
+                              "seed       42\n"
+                              "fleet      Alpha 4 Charlie 2 Alpha 1\n");
+    EXPECT_EQ(scenario.simHours, 6.5);
+    EXPECT_EQ(scenario.numChargers, 8);
+    EXPECT_EQ(scenario.vertiports, 2);
+    EXPECT_EQ(scenario.dispatchPolicy, DispatchPolicy::FairShare);
+    EXPECT_EQ(scenario.engine, SimulationEngine::StructOfArrays);
+    EXPECT_EQ(scenario.seed, 42u);
+    EXPECT_EQ(scenario.fleetComposition, (std::vector<int>{5, 0, 2}));
+    EXPECT_EQ(scenario.numVehicles, 7); // Set by the fleet
+    EXPECT_FALSE(scenario.threads);
+    EXPECT_FALSE(scenario.randomizeVehicles);
+
+    EXPECT_EQ(parse("fleet equal\n").randomizeVehicles, false);
+    EXPECT_TRUE(parse("fleet equal\n").fleetComposition.empty());
+
+    // Errors name the line
+    EXPECT_EQ(parseError("hours 2\nchargers 0\n"), "scenario.txt:2: chargers must be a positive integer");
+    EXPECT_EQ(parseError("hours 2\nhours 3\n"), "scenario.txt:2: hours is given more than once");
+    EXPECT_EQ(parseError("speed 3\n"), "scenario.txt:1: unknown key speed");
+    EXPECT_EQ(parseError("fleet Alpha 2 Zulu 1\n"), "scenario.txt:1: unknown vehicle type Zulu");
+    EXPECT_EQ(parseError("vehicles 5\nfleet Alpha 2\n"), "scenario.txt: fleet has 2 vehicles, vehicles is 5");
+    EXPECT_NE(parseError("fleet Alpha\n"), "");
+    EXPECT_NE(parseError("hours\n"), "");
+}
+
+TEST(ScenarioTest, StrictNumbers) {
+    SCOPED_TRACE("REQ-SIM-024: Verifies numbers are only accepted when the whole text is a number in range.");
+
+    int count = 0;
+    EXPECT_TRUE(parseInt("12", count));
+    EXPECT_EQ(count, 12);
+    EXPECT_TRUE(parseInt("-3", count));
+    EXPECT_FALSE(parseInt("12abc", count));
+    EXPECT_FALSE(parseInt("", count));
+    EXPECT_FALSE(parseInt(" 5", count));
+    EXPECT_FALSE(parseInt("99999999999", count));
+    EXPECT_EQ(count, -3); // Unchanged by failed parses
+
+    double hours = 0.0;
+    EXPECT_TRUE(parseDouble("0.25", hours));
+    EXPECT_EQ(hours, 0.25);
+    EXPECT_FALSE(parseDouble("1.5h", hours));
+    EXPECT_FALSE(parseDouble("inf", hours));
+    EXPECT_FALSE(parseDouble("nan", hours));
+
+    uint64_t seed = 0;
+    EXPECT_TRUE(parseUint64("18446744073709551615", seed));
+    EXPECT_EQ(seed, UINT64_MAX);
+    EXPECT_FALSE(parseUint64("-1", seed));
+    EXPECT_FALSE(parseUint64("18446744073709551616", seed));
+
+    EXPECT_EQ(parseError("hours 2x\n"), "scenario.txt:1: hours must be a positive number");
+    EXPECT_EQ(parseError("fleet Alpha 2.5\n"), "scenario.txt:1: vehicle count of Alpha must be a non-negative integer");
+}
+
+TEST(ScenarioTest, FleetComposition) {
+    SCOPED_TRACE("REQ-SIM-024: Verifies a fleet composition creates its vehicles without random draws.");
+
+    EXPECT_EQ(expandFleetComposition({3, 0, 1, 2}), (std::vector<int>{0, 2, 3, 0, 3, 0}));
+
+    // Equal counts of every type are the fleet of the equal distribution
+    std::vector<int> equal(getNumVehicleTypes(), 4);
+    Simulation composed(static_cast<int>(equal.size()) * 4, 2.0, 3, 10.0, DEFAULT_VERBOSITY, true, false);
+    composed.setFleetComposition(equal);
+    composed.setSeed(9);
+    composed.runSimulation();
+    Simulation roundRobin(static_cast<int>(equal.size()) * 4, 2.0, 3, 10.0, DEFAULT_VERBOSITY, false, false);
+    roundRobin.setSeed(9);
+    roundRobin.runSimulation();
+    for (const auto& pair : roundRobin.getTypeStats()) {
+        const VehicleTypeStats& stats = composed.getTypeStats().at(pair.first);
+        EXPECT_EQ(stats.vehicleCount, pair.second.vehicleCount);
+        EXPECT_EQ(stats.totalFlights, pair.second.totalFlights);
+        EXPECT_EQ(stats.totalFlightTime, pair.second.totalFlightTime);
+        EXPECT_EQ(stats.totalFaults, pair.second.totalFaults);
+    }
+
+    Simulation mixed(9, 1.0, 2, 10.0, DEFAULT_VERBOSITY, true, false);
+    mixed.setFleetComposition({0, 6, 0, 3});
+    mixed.runSimulation();
+    EXPECT_EQ(mixed.getTypeStats().at(Vehicle::Manufacturer::Bravo).vehicleCount, 6);
+    EXPECT_EQ(mixed.getTypeStats().at(Vehicle::Manufacturer::Delta).vehicleCount, 3);
+    EXPECT_FALSE(mixed.getTypeStats().contains(Vehicle::Manufacturer::Alpha));
+
+    EXPECT_THROW(mixed.setFleetComposition({5, 5}), std::runtime_error);
+    EXPECT_THROW(mixed.setFleetComposition({10, -1}), std::runtime_error);
+}
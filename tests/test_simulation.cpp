@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "simulation.hpp"
+#include "checkpoint.hpp"
 #include "vehicle.hpp"
+#include <algorithm>
 #include <memory>
 #include <filesystem>
 #include <fstream>
@@ -39,7 +41,7 @@ TEST(SimulationTest, CreateVehicles) {
     Simulation sim(1, 1.0, 1, 1.0);
 
     // Test creating each vehicle type
-    for (int type = 0; type < NUM_VEHICLE_TYPES; ++type) {
+    for (int type = 0; type < static_cast<int>(getNumVehicleTypes()); ++type) {
         auto vehicle = sim.createVehicle(type);
 
         EXPECT_NE(vehicle.get(), nullptr);
@@ -101,31 +103,441 @@ TEST(SimulationTest, ChargingQueue) {
     Simulation sim(3, 1.0, 1, 1.0); // 3 vehicles, 1 charger to force queuing
     sim.initializeVehicles();
 
-    // Get references to vehicles for testing
-    Vehicle* vehicle1 = sim.vehicles[0].get();
-    Vehicle* vehicle2 = sim.vehicles[1].get();
-    Vehicle* vehicle3 = sim.vehicles[2].get();
+    // Manually add vehicles to the charging queue to test FIFO order
+    sim.resetCharging();
+    sim.vertiports.enqueue(0, 0, {});
+    sim.vertiports.enqueue(0, 1, {});
+    sim.vertiports.enqueue(0, 2, {});
 
-    // Manually add vehicles to charging queue to test FIFO order
-    sim.chargingQueue.push(vehicle1);
-    sim.chargingQueue.push(vehicle2);
-    sim.chargingQueue.push(vehicle3);
+    EXPECT_EQ(sim.vertiports.getQueue(0)[0].handle, 0u);
+    EXPECT_EQ(sim.vertiports.getQueueLength(), 3);
 
+    // Vehicles that do not take the charger leave the queue, the charger stays free
+    std::vector<size_t> order;
+    sim.vertiports.dispatch([&order](size_t vehicle, int) {
+        order.push_back(vehicle);
+        return false;
+    });
+    EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(sim.vertiports.getFreeChargerCount(), 1);
 
-    EXPECT_EQ(sim.chargingQueue.front(), vehicle1);
-    EXPECT_EQ(sim.chargingQueue.size(), 3);
+    EXPECT_EQ(sim.vertiports.getQueueLength(), 0u);
+}
+
+TEST(SimulationTest, ChargerBookkeeping) {
+    SCOPED_TRACE("REQ-SIM-007: Verifies the free charger list and the charger held by each vehicle stay consistent.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven, SimulationEngine::StructOfArrays}) {
+        SCOPED_TRACE(engineToString(engine));
+        Simulation sim(40, 3.0, 4, 10.0);
+        sim.setEngine(engine);
+        sim.runSimulation();
+
+        int occupied = 0;
+        for (int i = 0; i < sim.numChargers; ++i) {
+            if (sim.chargingStations[i] != nullptr) {
+                occupied++;
+                EXPECT_EQ(sim.vehicleCharger[sim.vehicleIndex.at(sim.chargingStations[i])], i);
+            }
+        }
+        EXPECT_EQ(occupied + sim.vertiports.getFreeChargerCount(), sim.numChargers);
+
+        // Every vehicle still charging holds a charger, every queued vehicle is waiting in the queue
+        int queued = 0;
+        for (size_t i = 0; i < sim.vehicles.size(); ++i) {
+            if (sim.vehicles[i]->getCurrentState() == Vehicle::State::Charging) {
+                EXPECT_GE(sim.vehicleCharger[i], 0);
+            }
+            if (sim.vehicles[i]->getCurrentState() == Vehicle::State::Queued) {
+                queued++;
+            }
+        }
+        EXPECT_LE(static_cast<size_t>(queued), sim.vertiports.getQueueLength());
+    }
+}
+
+TEST(SimulationTest, VertiportsChargeLandedVehicles) {
+    SCOPED_TRACE("REQ-SIM-020: Verifies vehicles only charge and wait at the vertiport they landed at.");
+
+    Simulation one(60, 3.0, 6, 10.0);
+    EXPECT_THROW(one.setVertiports(7), std::runtime_error);
+    EXPECT_THROW(one.setVertiports(0), std::runtime_error);
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven, SimulationEngine::StructOfArrays}) {
+        SCOPED_TRACE(engineToString(engine));
+        Simulation sim(60, 3.0, 6, 10.0);
+        sim.setEngine(engine);
+        sim.setSeed(8);
+        sim.setVertiports(3);
+        sim.runSimulation();
+
+        int landed = 0;
+        for (size_t i = 0; i < sim.vehicles.size(); ++i) {
+            landed += sim.vehicleSite[i] != static_cast<int>(i % 3);
+            if (sim.vehicleCharger[i] >= 0) {
+                EXPECT_EQ(sim.vertiports.getChargerSite(sim.vehicleCharger[i]), sim.vehicleSite[i]);
+            }
+        }
+        EXPECT_GT(landed, 0); // Vehicles moved between the sites
+
+        size_t queued = 0;
+        for (int site = 0; site < 3; ++site) {
+            const auto queue = sim.vertiports.getQueue(site);
+            queued += queue.size();
+            for (const auto& entry : queue) {
+                EXPECT_EQ(sim.vehicleSite[entry.handle], site);
+            }
+            // A site never keeps a free charger while its own vehicles wait
+            EXPECT_TRUE(sim.vertiports.getQueueLength(site) == 0 || sim.vertiports.getFreeChargers(site).empty());
+        }
+        EXPECT_EQ(queued, sim.vertiports.getQueueLength());
+    }
+}
+
+TEST(SimulationTest, DispatchPolicies) {
+    SCOPED_TRACE("REQ-SIM-021: Verifies every dispatch policy serves the waiting vehicles in its order.");
+
+    auto served = [](DispatchPolicy policy, const std::vector<ChargeRequest>& requests) {
+        VertiportNetwork network;
+        network.setPolicy(policy);
+        network.reset(1, 1, requests.size(), 2);
+        for (size_t i = 0; i < requests.size(); ++i) {
+            network.enqueue(0, i, requests[i]);
+        }
+        std::vector<size_t> order;
+        while (network.getQueueLength() > 0) {
+            network.dispatch([&order](size_t vehicle, int) {
+                order.push_back(vehicle);
+                return true;
+            });
+            network.releaseCharger(0);
+        }
+        return order;
+    };
+
+    // Type 0 needs long charges, type 1 short ones
+    const std::vector<ChargeRequest> requests = {
+        {2.0, 4, 0}, {2.0, 4, 0}, {2.0, 4, 0}, {0.5, 2, 1}, {0.5, 5, 1}, {1.0, 2, 1}};
+    EXPECT_EQ(served(DispatchPolicy::Fifo, requests), (std::vector<size_t>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(served(DispatchPolicy::ShortestCharge, requests), (std::vector<size_t>{3, 4, 5, 0, 1, 2}));
+    EXPECT_EQ(served(DispatchPolicy::MostPassengers, requests), (std::vector<size_t>{4, 0, 1, 2, 3, 5}));
+    // Type 1 catches up on the charger time type 0 was given first
+    EXPECT_EQ(served(DispatchPolicy::FairShare, requests), (std::vector<size_t>{0, 3, 4, 5, 1, 2}));
+
+    // Shortest charge first lowers the mean wait of a congested fleet
+    auto queuedHours = [](DispatchPolicy policy) {
+        Simulation sim(60, 4.0, 3, 10.0);
+        sim.setSeed(4);
+        sim.setDispatchPolicy(policy);
+        sim.runSimulation();
+        double total = 0.0;
+        for (const auto& pair : sim.getTypeStats()) {
+            total += pair.second.totalQueuedTime;
+        }
+        return total;
+    };
+    EXPECT_LT(queuedHours(DispatchPolicy::ShortestCharge), queuedHours(DispatchPolicy::Fifo));
+}
+
+TEST(SimulationTest, TimeAccounting) {
+    SCOPED_TRACE("REQ-SIM-006: Verifies every vehicle accounts for the full simulation duration.");
+
+    Simulation sim(20, 2.0, 3, 10.0);
+    sim.runSimulation();
+
+    for (const auto& vehicle : sim.vehicles) {
+        const auto& stats = vehicle->getTotalStats();
+        double accounted = stats.flightTime + stats.queuedTime + stats.chargingTime + stats.faultedTime;
+        EXPECT_NEAR(accounted, sim.simHours, 1e-9);
+    }
+}
+
+TEST(SimulationTest, TransitionCounts) {
+    SCOPED_TRACE("REQ-SIM-006: Verifies flight and charge counts match the vehicles, also across repeated simulations.");
+
+    for (int run = 0; run < 2; ++run) {
+        Simulation sim(20, 2.0, 3, 10.0);
+        sim.runSimulation();
+
+        int vehicleFlights = 0;
+        int vehicleCharges = 0;
+        for (const auto& vehicle : sim.vehicles) {
+            vehicleFlights += vehicle->getTotalStats().flights;
+            vehicleCharges += vehicle->getTotalStats().charges;
+        }
+
+        int typeFlights = 0;
+        int typeCharges = 0;
+        for (const auto& pair : sim.typeStats) {
+            typeFlights += pair.second.totalFlights;
+            typeCharges += pair.second.totalCharges;
+        }
+        EXPECT_GT(typeFlights, 0);
+        EXPECT_EQ(typeFlights, vehicleFlights);
+        EXPECT_EQ(typeCharges, vehicleCharges);
+    }
+}
+
+TEST(SimulationTest, EventEngineTimeAccounting) {
+    SCOPED_TRACE("REQ-SIM-008: Verifies the event-driven engine accounts for the full duration and fleet totals.");
+
+    Simulation sim(20, 3.0, 3, 1.0);
+    sim.setEngine(SimulationEngine::EventDriven);
+    sim.runSimulation();
+
+    EXPECT_DOUBLE_EQ(sim.currentTime, sim.simHours);
+
+    double vehicleFlightTime = 0.0;
+    int vehicleFaults = 0;
+    for (const auto& vehicle : sim.vehicles) {
+        const auto& stats = vehicle->getTotalStats();
+        double accounted = stats.flightTime + stats.queuedTime + stats.chargingTime + stats.faultedTime;
+        EXPECT_NEAR(accounted, sim.simHours, 1e-9);
+        EXPECT_LE(vehicle->getBatteryLevel(), vehicle->getBatteryCapacity());
+        vehicleFlightTime += stats.flightTime;
+        vehicleFaults += stats.faults;
+    }
+
+    double typeFlightTime = 0.0;
+    int typeFaults = 0;
+    int typeFlights = 0;
+    for (const auto& pair : sim.typeStats) {
+        typeFlightTime += pair.second.totalFlightTime;
+        typeFaults += pair.second.totalFaults;
+        typeFlights += pair.second.totalFlights;
+    }
+    EXPECT_NEAR(typeFlightTime, vehicleFlightTime, 1e-9);
+    EXPECT_EQ(typeFaults, vehicleFaults);
+    EXPECT_GT(typeFlights, 0);
+
+    // Only one vehicle may use a charger at a time
+    int charging = 0;
+    for (const auto& vehicle : sim.vehicles) {
+        if (vehicle->getCurrentState() == Vehicle::State::Charging) {
+            charging++;
+        }
+    }
+    EXPECT_LE(charging, sim.numChargers);
+}
+
+TEST(SimulationTest, AdaptiveEngineSkipsQuiescentSteps) {
+    SCOPED_TRACE("REQ-SIM-016: Verifies adaptive steps account for the full duration with far fewer steps.");
+
+    Simulation fixed(20, 3.0, 3, 1.0, DEFAULT_VERBOSITY, true, false);
+    fixed.setSeed(8);
+    fixed.runSimulation();
+
+    Simulation sim(20, 3.0, 3, 1.0, DEFAULT_VERBOSITY, true, false);
+    sim.setEngine(SimulationEngine::Adaptive);
+    sim.setSeed(8);
+    sim.runSimulation();
+
+    EXPECT_NEAR(sim.currentTime, sim.simHours, 1e-9);
+    EXPECT_LT(sim.stepCount * 100, fixed.stepCount);
+
+    int flights = 0;
+    for (const auto& vehicle : sim.vehicles) {
+        const auto& stats = vehicle->getTotalStats();
+        double accounted = stats.flightTime + stats.queuedTime + stats.chargingTime + stats.faultedTime;
+        EXPECT_NEAR(accounted, sim.simHours, 1e-9);
+        EXPECT_EQ(vehicle->getFaultModel(), Vehicle::FaultModel::Exponential);
+        flights += stats.flights;
+    }
+    EXPECT_GT(flights, 0);
+}
+
+TEST(SimulationTest, SoaEngineMatchesFixedStep) {
+    SCOPED_TRACE("REQ-SIM-009: Verifies the structure-of-arrays engine keeps fixed-step accounting and syncs the vehicles.");
+
+    Simulation sim(20, 2.0, 3, 10.0);
+    sim.setEngine(SimulationEngine::StructOfArrays);
+    sim.runSimulation();
 
-    Vehicle* first = sim.chargingQueue.front();
-    sim.chargingQueue.pop();
-    EXPECT_EQ(first, vehicle1);
+    ASSERT_EQ(sim.fleet.size(), sim.vehicles.size());
 
-    Vehicle* second = sim.chargingQueue.front();
-    sim.chargingQueue.pop();
-    EXPECT_EQ(second, vehicle2);
+    double vehicleFlightTime = 0.0;
+    int vehicleFaults = 0;
+    int charging = 0;
+    for (size_t i = 0; i < sim.vehicles.size(); ++i) {
+        const auto& vehicle = sim.vehicles[i];
+        const auto& stats = vehicle->getTotalStats();
+        double accounted = stats.flightTime + stats.queuedTime + stats.chargingTime + stats.faultedTime;
+        EXPECT_NEAR(accounted, sim.simHours, 1e-9);
 
-    Vehicle* third = sim.chargingQueue.front();
-    sim.chargingQueue.pop();
-    EXPECT_EQ(third, vehicle3);
+        // Vehicles are synced back from the fleet at the end of the run
+        EXPECT_EQ(vehicle->getCurrentState(), sim.fleet.getState(i));
+        EXPECT_DOUBLE_EQ(vehicle->getBatteryLevel(), sim.fleet.getBatteryLevel(i));
 
-    EXPECT_TRUE(sim.chargingQueue.empty());
+        vehicleFlightTime += stats.flightTime;
+        vehicleFaults += stats.faults;
+        if (vehicle->getCurrentState() == Vehicle::State::Charging) {
+            charging++;
+        }
+    }
+    EXPECT_LE(charging, sim.numChargers);
+
+    double typeFlightTime = 0.0;
+    int typeFaults = 0;
+    for (const auto& pair : sim.typeStats) {
+        typeFlightTime += pair.second.totalFlightTime;
+        typeFaults += pair.second.totalFaults;
+    }
+    EXPECT_NEAR(typeFlightTime, vehicleFlightTime, 1e-9);
+    EXPECT_EQ(typeFaults, vehicleFaults);
+}
+
+TEST(SimulationTest, ThreadCountDoesNotChangeResults) {
+    SCOPED_TRACE("REQ-SIM-009, REQ-SIM-010: Verifies results for a seed are bit-identical for any thread count and stepping engine.");
+
+    // More than one chunk so the chunks are really spread across threads
+    const int numVehicles = static_cast<int>(VEHICLES_PER_CHUNK) * 2 + 100;
+
+    for (Vehicle::FaultModel model : {Vehicle::FaultModel::PerStep, Vehicle::FaultModel::Exponential}) {
+        SCOPED_TRACE("Fault model " + faultModelToString(model));
+
+        // Both engines draw from the same per-vehicle streams in the same order, so they agree too
+        std::vector<VehicleTypeStatsTable> results;
+        for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::StructOfArrays}) {
+            for (int threads : {1, 3}) {
+                Simulation sim(numVehicles, 0.5, 3, 30.0);
+                sim.setEngine(engine);
+                sim.setFaultModel(model);
+                sim.setSeed(1234);
+                sim.setThreads(threads);
+                sim.runSimulation();
+                results.push_back(sim.typeStats);
+            }
+        }
+
+        for (size_t run = 1; run < results.size(); ++run) {
+            SCOPED_TRACE("Run " + std::to_string(run));
+            ASSERT_EQ(results[0].size(), results[run].size());
+            for (const auto& pair : results[0]) {
+                const auto& single = pair.second;
+                const auto& threaded = results[run].at(pair.first);
+                EXPECT_EQ(single.vehicleCount, threaded.vehicleCount);
+                EXPECT_EQ(single.totalFlights, threaded.totalFlights);
+                EXPECT_EQ(single.totalCharges, threaded.totalCharges);
+                EXPECT_EQ(single.totalFaults, threaded.totalFaults);
+                EXPECT_EQ(single.totalFlightTime, threaded.totalFlightTime);
+                EXPECT_EQ(single.totalDistance, threaded.totalDistance);
+                EXPECT_EQ(single.totalChargingTime, threaded.totalChargingTime);
+                EXPECT_EQ(single.totalPassengerMiles, threaded.totalPassengerMiles);
+            }
+        }
+    }
+}
+
+TEST(SimulationTest, SeedReproducesRun) {
+    SCOPED_TRACE("REQ-SIM-011: Verifies a seed reproduces the fleet and the results for every engine.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven}) {
+        SCOPED_TRACE(engineToString(engine));
+        std::vector<std::vector<Vehicle::Manufacturer>> fleets;
+        std::vector<VehicleTypeStatsTable> results;
+        for (uint64_t seed : {99ULL, 99ULL, 100ULL}) {
+            Simulation sim(200, 1.0, 3, 30.0);
+            sim.setEngine(engine);
+            sim.setSeed(seed);
+            sim.runSimulation();
+
+            fleets.emplace_back();
+            for (const auto& vehicle : sim.vehicles) {
+                fleets.back().push_back(vehicle->getManufacturer());
+            }
+            results.push_back(sim.typeStats);
+        }
+
+        EXPECT_EQ(fleets[0], fleets[1]);
+        EXPECT_NE(fleets[0], fleets[2]);
+        for (const auto& pair : results[0]) {
+            const auto& repeated = results[1].at(pair.first);
+            EXPECT_EQ(pair.second.totalFlights, repeated.totalFlights);
+            EXPECT_EQ(pair.second.totalFaults, repeated.totalFaults);
+            EXPECT_EQ(pair.second.totalFlightTime, repeated.totalFlightTime);
+            EXPECT_EQ(pair.second.totalPassengerMiles, repeated.totalPassengerMiles);
+        }
+    }
+}
+
+TEST(SimulationTest, RepeatedRunReusesArena) {
+    SCOPED_TRACE("REQ-SIM-017: Verifies a repeated run on the arena of the previous run gives the same results.");
+
+    // The table keeps the map interface: ascending type order, at() only for existing types
+    VehicleTypeStatsTable table;
+    table[Vehicle::Manufacturer::Delta].totalFlights = 4;
+    table[Vehicle::Manufacturer::Alpha].totalFlights = 1;
+    ASSERT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.begin()->first, Vehicle::Manufacturer::Alpha);
+    EXPECT_EQ(table.at(Vehicle::Manufacturer::Delta).totalFlights, 4);
+    EXPECT_THROW(table.at(Vehicle::Manufacturer::Bravo), std::out_of_range);
+    EXPECT_TRUE(table.find(Vehicle::Manufacturer::Bravo) == table.end());
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven}) {
+        SCOPED_TRACE(engineToString(engine));
+        Simulation sim(200, 1.0, 3, 30.0, DEFAULT_VERBOSITY, true, false);
+        sim.setEngine(engine);
+        sim.setSeed(7);
+        sim.runSimulation();
+        VehicleTypeStatsTable first = sim.getTypeStats();
+        sim.runSimulation();
+
+        const auto& second = sim.getTypeStats();
+        ASSERT_EQ(first.size(), second.size());
+        for (const auto& pair : first) {
+            const auto& repeated = second.at(pair.first);
+            EXPECT_EQ(pair.second.vehicleCount, repeated.vehicleCount);
+            EXPECT_EQ(pair.second.totalFlights, repeated.totalFlights);
+            EXPECT_EQ(pair.second.totalCharges, repeated.totalCharges);
+            EXPECT_EQ(pair.second.totalQueuedTime, repeated.totalQueuedTime);
+            EXPECT_EQ(pair.second.totalFlightTime, repeated.totalFlightTime);
+        }
+    }
+}
+
+TEST(SimulationTest, FastForwardParksWaitingVehicles) {
+    SCOPED_TRACE("REQ-SIM-023: Verifies parked faulted and queued vehicles end with the times of stepping every vehicle.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::StructOfArrays, SimulationEngine::Adaptive}) {
+        SCOPED_TRACE(engineToString(engine));
+        std::string filename = (std::filesystem::temp_directory_path() / "evtol_test_fast_forward.bin").string();
+
+        // Two chargers keep most of the fleet queued
+        Simulation stepped(60, 3.0, 2, 10.0, DEFAULT_VERBOSITY, true, false);
+        Simulation parked(60, 3.0, 2, 10.0, DEFAULT_VERBOSITY, true, false);
+        stepped.setFastForward(false);
+        parked.setCheckpointInterval(1.0, filename);
+        for (Simulation* sim : {&stepped, &parked}) {
+            sim->setEngine(engine);
+            sim->setSeed(9);
+            sim->runSimulation();
+        }
+
+        // Vehicles were parked during the run and settled at its end
+        SimulationCheckpoint checkpoint;
+        ASSERT_TRUE(SimulationCheckpoint::read(filename, checkpoint));
+        EXPECT_GT(std::count_if(checkpoint.parkedSince.begin(), checkpoint.parkedSince.end(),
+                                [](double since) { return since >= 0; }), 0);
+        std::filesystem::remove(filename);
+        EXPECT_EQ(parked.activeVehicles.size(), parked.vehicles.size());
+
+        for (size_t i = 0; i < stepped.vehicles.size(); ++i) {
+            const Vehicle& expected = *stepped.vehicles[i];
+            const Vehicle& actual = *parked.vehicles[i];
+            EXPECT_EQ(actual.getCurrentState(), expected.getCurrentState());
+            EXPECT_EQ(actual.getBatteryLevel(), expected.getBatteryLevel());
+            EXPECT_EQ(actual.getTotalStats().flights, expected.getTotalStats().flights);
+            EXPECT_EQ(actual.getTotalStats().charges, expected.getTotalStats().charges);
+            EXPECT_EQ(actual.getTotalStats().faults, expected.getTotalStats().faults);
+            EXPECT_NEAR(actual.getTotalStats().queuedTime, expected.getTotalStats().queuedTime, 1e-9);
+            EXPECT_NEAR(actual.getTotalStats().faultedTime, expected.getTotalStats().faultedTime, 1e-9);
+        }
+        for (const auto& pair : stepped.getTypeStats()) {
+            const auto& stats = parked.getTypeStats().at(pair.first);
+            EXPECT_EQ(stats.totalFlights, pair.second.totalFlights);
+            EXPECT_EQ(stats.totalFaults, pair.second.totalFaults);
+            EXPECT_EQ(stats.queueWaitTimes.getCount(), pair.second.queueWaitTimes.getCount());
+            EXPECT_NEAR(stats.totalQueuedTime, pair.second.totalQueuedTime, 1e-9);
+        }
+    }
 }
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "streaming_stats.hpp"
+#include "simulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEST(StreamingStatsTest, MomentsAndQuantiles) {
+    SCOPED_TRACE("REQ-SIM-022: Verifies the streaming mean, variance and percentiles match the exact ones.");
+
+    std::mt19937_64 engine(11);
+    std::lognormal_distribution<double> durations(-1.0, 1.0);
+    std::vector<double> samples(20000);
+    StreamingDistribution all;
+    StreamingDistribution first;
+    StreamingDistribution second;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = durations(engine);
+        all.add(samples[i]);
+        (i % 3 == 0 ? first : second).add(samples[i]);
+    }
+
+    double mean = 0.0;
+    for (double sample : samples) {
+        mean += sample;
+    }
+    mean /= static_cast<double>(samples.size());
+    double squares = 0.0;
+    for (double sample : samples) {
+        squares += (sample - mean) * (sample - mean);
+    }
+    EXPECT_EQ(all.getCount(), samples.size());
+    EXPECT_NEAR(all.getMoments().getMean(), mean, 1e-12);
+    EXPECT_NEAR(all.getMoments().getVariance(), squares / (samples.size() - 1), 1e-9);
+
+    // Quantiles are within the bucket precision of the sample of that rank
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    for (double q : {0.5, 0.95, 0.99}) {
+        double exact = sorted[static_cast<size_t>(std::ceil(q * sorted.size())) - 1];
+        EXPECT_NEAR(all.quantile(q), exact, exact / LogHistogram::SUB_BUCKETS) << q;
+    }
+    EXPECT_NEAR(all.quantile(1.0), sorted.back(), sorted.back() / LogHistogram::SUB_BUCKETS);
+    EXPECT_LE(all.quantile(1.0), sorted.back());
+
+    // Merged partial accumulators match the accumulator of the union
+    first.merge(second);
+    EXPECT_EQ(first.getCount(), all.getCount());
+    EXPECT_NEAR(first.getMoments().getMean(), all.getMoments().getMean(), 1e-12);
+    EXPECT_NEAR(first.getMoments().getVariance(), all.getMoments().getVariance(), 1e-9);
+    EXPECT_EQ(first.getHistogram().getIndices(), all.getHistogram().getIndices());
+    EXPECT_EQ(first.getHistogram().getCounts(), all.getHistogram().getCounts());
+
+    // Bounded memory: only buckets with samples, a few hundred for six orders of magnitude
+    EXPECT_LT(all.getHistogram().getIndices().size(), 1500u);
+
+    LogHistogram restored;
+    EXPECT_TRUE(restored.restore(all.getHistogram().getIndices(), all.getHistogram().getCounts()));
+    EXPECT_EQ(restored.getCount(), all.getCount());
+    EXPECT_FALSE(restored.restore({3, 2}, {1, 1}));
+    EXPECT_TRUE(restored.empty());
+}
+
+TEST(StreamingStatsTest, FixedIntervalSeries) {
+    SCOPED_TRACE("REQ-SIM-022: Verifies amounts are spread over the windows they overlap and old windows are dropped.");
+
+    FixedIntervalSeries series(1.0, 4);
+    series.add(0.5, 2.0, 4.0); // 1 in window 0, 2 in window 1, 1 in window 2
+    series.add(1.0, 0.0, 0.5); // Instant, window 1
+    ASSERT_EQ(series.size(), 3u);
+    EXPECT_DOUBLE_EQ(series.getValue(0), 1.0);
+    EXPECT_DOUBLE_EQ(series.getValue(1), 2.5);
+    EXPECT_DOUBLE_EQ(series.getValue(2), 1.0);
+
+    FixedIntervalSeries other(1.0, 4);
+    other.add(2.0, 1.0, 3.0);
+    series.merge(other);
+    EXPECT_DOUBLE_EQ(series.getValue(2), 4.0);
+
+    // Window 5 drops windows 0 and 1 from the ring of 4
+    series.add(5.0, 1.0, 1.0);
+    EXPECT_EQ(series.getFirstWindow(), 2u);
+    EXPECT_EQ(series.getValues(), (std::vector<double>{4.0, 0.0, 0.0, 1.0}));
+    series.add(0.0, 1.0, 7.0); // Before the ring, ignored
+    EXPECT_EQ(series.getFirstWindow(), 2u);
+    EXPECT_DOUBLE_EQ(series.getValue(0), 4.0);
+
+    EXPECT_FALSE(series.restore(0, std::vector<double>(5, 1.0)));
+    EXPECT_EQ(series.size(), 0u);
+}
+
+TEST(StreamingStatsTest, SimulationSessions) {
+    SCOPED_TRACE("REQ-SIM-022: Verifies the session distributions and utilization series agree with the totals.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::EventDriven, SimulationEngine::StructOfArrays}) {
+        SCOPED_TRACE(engineToString(engine));
+        Simulation sim(40, 3.0, 3, 10.0, DEFAULT_VERBOSITY, true, false);
+        sim.setEngine(engine);
+        sim.setSeed(6);
+        sim.runSimulation();
+
+        double chargingHours = 0.0;
+        for (const auto& pair : sim.getTypeStats()) {
+            const VehicleTypeStats& stats = pair.second;
+            chargingHours += stats.totalChargingTime;
+
+            // Every completed session is a sample, open sessions at the end are not
+            EXPECT_EQ(stats.flightTimes.getCount(), static_cast<uint64_t>(stats.totalFlights));
+            EXPECT_EQ(stats.chargeTimes.getCount(), static_cast<uint64_t>(stats.totalCharges));
+            EXPECT_GE(stats.queueWaitTimes.getCount(), stats.chargeTimes.getCount());
+            EXPECT_LE(stats.flightTimes.getMoments().getMean() * stats.totalFlights, stats.totalFlightTime + 1e-9);
+            EXPECT_LE(stats.chargeTimes.getMoments().getMean() * stats.totalCharges, stats.totalChargingTime + 1e-9);
+        }
+
+        double seriesHours = 0.0;
+        for (double hours : sim.getChargerUtilization().getValues()) {
+            EXPECT_LE(hours, 3 * DEFAULT_SERIES_INTERVAL_HOURS + 1e-9); // At most every charger busy
+            seriesHours += hours;
+        }
+        EXPECT_NEAR(seriesHours, chargingHours, 1e-6);
+    }
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "sweep.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+
+TEST(SweepTest, ParseRanges) {
+    SCOPED_TRACE("REQ-SIM-013: Verifies sweep ranges are parsed and expanded inclusively.");
+
+    SweepRange range;
+    ASSERT_TRUE(SweepRange::parse("20:100:20", range));
+    EXPECT_EQ(range.values(), (std::vector<double>{20, 40, 60, 80, 100}));
+
+    ASSERT_TRUE(SweepRange::parse("1:3", range));
+    EXPECT_EQ(range.values(), (std::vector<double>{1, 2, 3}));
+
+    ASSERT_TRUE(SweepRange::parse("0.5:1.5:0.1", range));
+    EXPECT_EQ(range.values().size(), 11u); // Floating point steps keep the end value
+
+    ASSERT_TRUE(SweepRange::parse("7", range));
+    EXPECT_EQ(range.values(), (std::vector<double>{7}));
+
+    EXPECT_FALSE(SweepRange::parse("", range));
+    EXPECT_FALSE(SweepRange::parse("5:1", range));
+    EXPECT_FALSE(SweepRange::parse("1:5:0", range));
+    EXPECT_FALSE(SweepRange::parse("1:x", range));
+    EXPECT_FALSE(SweepRange::parse("1:2:3:4", range));
+}
+
+TEST(SweepTest, ResultCsvRoundTrip) {
+    SCOPED_TRACE("REQ-SIM-013: Verifies cached results are read back exactly.");
+
+    SweepResult result;
+    result.flights = 12;
+    result.charges = 7;
+    result.faults = 1;
+    result.flightHours = 1.0 / 3.0;
+    result.queuedHours = 2.718281828459045;
+    result.chargingHours = 0.1;
+    result.passengerMiles = 12345.678;
+
+    SweepResult parsed;
+    ASSERT_TRUE(SweepResult::fromCsv(result.toCsv(), parsed));
+    EXPECT_EQ(parsed.flights, result.flights);
+    EXPECT_EQ(parsed.charges, result.charges);
+    EXPECT_EQ(parsed.faults, result.faults);
+    EXPECT_EQ(parsed.flightHours, result.flightHours);
+    EXPECT_EQ(parsed.queuedHours, result.queuedHours);
+    EXPECT_EQ(parsed.chargingHours, result.chargingHours);
+    EXPECT_EQ(parsed.passengerMiles, result.passengerMiles);
+
+    EXPECT_FALSE(SweepResult::fromCsv("1,2,3", parsed));
+    EXPECT_FALSE(SweepResult::fromCsv(result.toCsv() + ",4", parsed));
+}
+
+TEST(SweepTest, CachedCellsAreNotRecomputed) {
+    SCOPED_TRACE("REQ-SIM-013: Verifies the grid runs once per configuration and re-runs only compute new cells.");
+
+    std::string cacheFile = (std::filesystem::temp_directory_path() / "evtol_test_sweep_cache.txt").string();
+    std::remove(cacheFile.c_str());
+
+    SweepSettings settings;
+    settings.vehicles = {10, 20, 10};
+    settings.chargers = {1, 3, 2};
+    settings.hours = {1, 1, 1};
+    settings.simTimeStepSeconds = 30.0;
+    settings.threads = 2;
+    settings.seed = 5;
+    settings.cacheFile = cacheFile;
+
+    SweepRunner first(settings);
+    first.run();
+    ASSERT_EQ(first.getCells().size(), 4u);
+    EXPECT_EQ(first.getComputedCount(), 4);
+
+    // One more charger value, only its two cells are new
+    settings.chargers = {1, 5, 2};
+    SweepRunner second(settings);
+    second.run();
+    ASSERT_EQ(second.getCells().size(), 6u);
+    EXPECT_EQ(second.getComputedCount(), 2);
+
+    for (const auto& cell : first.getCells()) {
+        bool found = false;
+        for (const auto& other : second.getCells()) {
+            if (other.numVehicles == cell.numVehicles && other.numChargers == cell.numChargers) {
+                found = true;
+                EXPECT_TRUE(other.cached);
+                EXPECT_EQ(other.result.flightHours, cell.result.flightHours);
+                EXPECT_EQ(other.result.queuedHours, cell.result.queuedHours);
+            }
+        }
+        EXPECT_TRUE(found);
+    }
+
+    // A different seed is a different key
+    settings.seed = 6;
+    SweepRunner third(settings);
+    third.run();
+    EXPECT_EQ(third.getComputedCount(), 6);
+
+    std::ostringstream csv;
+    third.writeCsv(csv);
+    std::string text = csv.str();
+    EXPECT_EQ(text.rfind(SweepRunner::csvHeader(), 0), 0u);
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), 7);
+
+    std::remove(cacheFile.c_str());
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "thread_pool.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPoolTest, RunsEveryIndexOnce) {
+    SCOPED_TRACE("REQ-SIM-010: Verifies parallelFor runs each task index exactly once.");
+
+    for (int threads : {1, 2, 4}) {
+        ThreadPool pool(threads);
+        EXPECT_EQ(pool.size(), threads);
+
+        // Reuse the pool for several jobs, as the simulation does every step
+        for (int job = 0; job < 50; ++job) {
+            std::vector<std::atomic<int>> counts(97);
+            pool.parallelFor(counts.size(), [&](size_t i) { counts[i]++; });
+            for (const auto& count : counts) {
+                EXPECT_EQ(count.load(), 1);
+            }
+        }
+    }
+}
+
+TEST(ThreadPoolTest, RethrowsTaskException) {
+    SCOPED_TRACE("REQ-SIM-010: Verifies an exception thrown by a task reaches the caller.");
+
+    ThreadPool pool(3);
+    std::atomic<int> completed{0};
+    EXPECT_THROW(pool.parallelFor(10, [&](size_t i) {
+        if (i == 5) {
+            throw std::runtime_error("task failed");
+        }
+        completed++;
+    }), std::runtime_error);
+    EXPECT_EQ(completed.load(), 9);
+
+    // The pool is still usable afterwards
+    std::atomic<int> counter{0};
+    pool.parallelFor(8, [&](size_t) { counter++; });
+    EXPECT_EQ(counter.load(), 8);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "trace.hpp"
+#include "simulation.hpp"
+#include <filesystem>
+#include <map>
+#include <sstream>
+
+namespace {
+
+std::string tempTraceFile(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST(TraceTest, RecordsRoundTrip) {
+    SCOPED_TRACE("REQ-OUT-002: Verifies trace records are read back in order with their values.");
+
+    std::string filename = tempTraceFile("evtol_test_trace_round_trip.evtrace");
+    VehicleStats stats;
+    stats.flightTime = 0.25;
+    stats.distanceTraveled = 30.0;
+    stats.passengerMiles = 120.0;
+    stats.flights = 1;
+    stats.faults = 1;
+
+    {
+        TraceWriter writer;
+        ASSERT_TRUE(writer.open(filename, 2, 1, 1.5, 42));
+        writer.beginStep(1, 0.5);
+        writer.write(7, Vehicle::Manufacturer::Charlie, Vehicle::State::Queued, 110.0, stats);
+    }
+
+    TraceReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    EXPECT_EQ(reader.getHeader().numVehicles, 2u);
+    EXPECT_EQ(reader.getHeader().numChargers, 1u);
+    EXPECT_EQ(reader.getHeader().simHours, 1.5);
+    EXPECT_EQ(reader.getHeader().seed, 42u);
+
+    TraceRecord record;
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_TRUE(record.isStep());
+    EXPECT_EQ(record.asStep().step, 1u);
+    EXPECT_EQ(record.asStep().time, 0.5);
+
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_FALSE(record.isStep());
+    EXPECT_EQ(record.vehicleId, 7u);
+    EXPECT_EQ(record.getManufacturer(), Vehicle::Manufacturer::Charlie);
+    EXPECT_EQ(record.getState(), Vehicle::State::Queued);
+    EXPECT_EQ(record.battery, 110.0);
+    VehicleStats read = record.getStepStats();
+    EXPECT_EQ(read.flightTime, 0.25);
+    EXPECT_EQ(read.distanceTraveled, 30.0);
+    EXPECT_EQ(read.passengerMiles, 120.0);
+    EXPECT_EQ(read.flights, 1);
+    EXPECT_EQ(read.faults, 1);
+    EXPECT_EQ(read.charges, 0);
+
+    EXPECT_FALSE(reader.next(record));
+
+    // Rendered lines use the report layout with totals summed from the step records
+    TraceReader renderer;
+    ASSERT_TRUE(renderer.open(filename));
+    std::ostringstream text;
+    renderer.renderText(text);
+    EXPECT_NE(text.str().find("Simulation Step 1\n"), std::string::npos);
+    EXPECT_NE(text.str().find(formatVehicleStatsLine(7, Vehicle::Manufacturer::Charlie, Vehicle::State::Queued,
+                                                     50.0, stats, stats)), std::string::npos);
+
+    std::filesystem::remove(filename);
+    EXPECT_FALSE(reader.open(filename));
+}
+
+TEST(TraceTest, SimulationTraceMatchesStatistics) {
+    SCOPED_TRACE("REQ-OUT-002: Verifies a binary trace holds every vehicle every step and sums to the results.");
+
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::StructOfArrays, SimulationEngine::EventDriven}) {
+        SCOPED_TRACE(engineToString(engine));
+        std::string filename = tempTraceFile("evtol_test_trace_" + engineToString(engine) + ".evtrace");
+
+        const int numVehicles = 10;
+        Simulation sim(numVehicles, 1.0, 2, 60.0, DEFAULT_VERBOSITY, true, false);
+        sim.setEngine(engine);
+        sim.setSeed(5);
+        sim.setTraceFormat(TraceFormat::Binary, filename);
+        sim.runSimulation();
+
+        TraceReader reader;
+        ASSERT_TRUE(reader.open(filename));
+        EXPECT_EQ(reader.getHeader().numVehicles, static_cast<uint32_t>(numVehicles));
+
+        int steps = 0;
+        int records = 0;
+        std::map<Vehicle::Manufacturer, VehicleStats> sums;
+        TraceRecord record;
+        while (reader.next(record)) {
+            if (record.isStep()) {
+                steps++;
+            } else {
+                records++;
+                sums[record.getManufacturer()].add(record.getStepStats());
+            }
+        }
+        if (engine != SimulationEngine::EventDriven) {
+            EXPECT_EQ(steps, 60);
+            EXPECT_EQ(records, 60 * numVehicles);
+        }
+
+        for (const auto& pair : sim.getTypeStats()) {
+            const VehicleStats& sum = sums[pair.first];
+            EXPECT_EQ(sum.flights, pair.second.totalFlights);
+            EXPECT_EQ(sum.charges, pair.second.totalCharges);
+            EXPECT_EQ(sum.faults, pair.second.totalFaults);
+            EXPECT_NEAR(sum.flightTime, pair.second.totalFlightTime, 1e-9); // Summed in another order
+            EXPECT_NEAR(sum.passengerMiles, pair.second.totalPassengerMiles, 1e-6);
+        }
+        std::filesystem::remove(filename);
+    }
+}
@@ -1,15 +1,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "vehicle.hpp"
-#include "interface_rng.hpp"
+#include "mock_rng.hpp"
 #include <stdexcept>
 
-class MockRandomGenerator : public RandomGenerator {
-    public:
-        MOCK_METHOD(bool, bernoulli, (double p), (override));
-        MOCK_METHOD(int, uniformInt, (int min, int max), (override));
-};
-
 
 class VehicleTest : public ::testing::Test {
 protected:
@@ -347,6 +341,7 @@ TEST_P(VehicleParameterizedTestFault, ReadyToFaulted) {
     EXPECT_NEAR(vehicle->getTotalPassengerMiles(), (flight_time * vehicle->getPassengerCount() * vehicle->getCruiseSpeed())/2, EPSILON);
     EXPECT_NEAR(vehicle->getTotalFaultedTime(), flight_time/2, EPSILON);
     EXPECT_EQ(vehicle->getTotalFaults(), 1);
+    EXPECT_EQ(vehicle->getTotalStats().flights, 1); // Faulted flights are counted as flights
 
     // Now try to fly again, should remain in Faulted state
     double flight_time2 = 0.5;
@@ -362,8 +357,110 @@ TEST_P(VehicleParameterizedTestFault, ReadyToFaulted) {
 
 }
 
-// TODO: Add tests for Queued and then get called to charge scenarios
-// TODO: Add tests for Charging complete then Ready and Flying scenarios
+TEST_P(VehicleParameterizedTest, ScheduledFault) {
+    SCOPED_TRACE("REQ-VEHICLE-6: Verifies a scheduled fault time replaces the per-step fault check.");
+
+    double time_to_fault = vehicle->getMaxFlightTime() / 4;
+    vehicle->setFlightTimeToFault(time_to_fault);
+
+    // First update flies less than the scheduled fault time
+    double flight_time = time_to_fault / 2;
+    vehicle->updateState(flight_time);
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Flying);
+    EXPECT_NEAR(vehicle->getFlightTimeToFault(), time_to_fault - flight_time, EPSILON);
+
+    // Second update crosses the fault time, only the time up to the fault is flown
+    double flight_time2 = time_to_fault;
+    vehicle->updateState(flight_time2);
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Faulted);
+    EXPECT_NEAR(vehicle->getTotalFlightTime(), time_to_fault, EPSILON);
+    EXPECT_NEAR(vehicle->getTotalFaultedTime(), flight_time + flight_time2 - time_to_fault, EPSILON);
+    EXPECT_EQ(vehicle->getTotalFaults(), 1);
+}
+
+TEST_P(VehicleParameterizedTest, ExponentialFaultModel) {
+    SCOPED_TRACE("REQ-VEHICLE-6, REQ-VEHICLE-8: Verifies the exponential model samples one fault time per flight and faults exactly then.");
+
+    vehicle->setFaultModel(Vehicle::FaultModel::Exponential);
+    double max_flight_time = vehicle->getMaxFlightTime();
+    double time_to_fault = max_flight_time * 1.25; // Survives the first flight, faults during the second
+
+    // One sample for both flights, the per-step draw is never made
+    EXPECT_CALL(mockRng, bernoulli(::testing::_)).Times(0);
+    EXPECT_CALL(mockRng, exponential(vehicle->getFaultProbability()))
+        .WillOnce(::testing::Return(time_to_fault));
+
+    // Steps of any size give the same result, use uneven ones
+    while (vehicle->getCurrentState() != Vehicle::State::Queued) {
+        vehicle->updateState(max_flight_time / 7.3);
+    }
+    EXPECT_NEAR(vehicle->getFlightTimeToFault(), time_to_fault - max_flight_time, EPSILON);
+
+    vehicle->startCharging();
+    vehicle->updateState(vehicle->getTimeToFullCharge());
+    while (vehicle->getCurrentState() != Vehicle::State::Faulted) {
+        vehicle->updateState(max_flight_time / 3.1);
+    }
+    EXPECT_NEAR(vehicle->getTotalFlightTime(), time_to_fault, EPSILON);
+    EXPECT_EQ(vehicle->getTotalFaults(), 1);
+    EXPECT_EQ(vehicle->getTotalStats().flights, 2);
+}
+
+TEST_F(VehicleTest, PerStepFaultProbabilityIsCapped) {
+    SCOPED_TRACE("REQ-VEHICLE-6: Verifies the per-step fault probability never exceeds 1 for long steps.");
+
+    // 10 faults per hour over a 0.5 hour step
+    Vehicle vehicle(Vehicle::Manufacturer::Alpha, 100, 100, 1, 1, 1, 10.0, mockRng);
+    EXPECT_CALL(mockRng, bernoulli(1.0)).WillOnce(::testing::Return(true));
+
+    vehicle.updateState(0.5);
+    EXPECT_EQ(vehicle.getCurrentState(), Vehicle::State::Faulted);
+}
+
+TEST_P(VehicleParameterizedTest, QueuedToChargingToFlying) {
+    SCOPED_TRACE("REQ-VEHICLE-3, REQ-VEHICLE-5: Verifies charging completes within a step and remaining time is flown.");
+
+    // Deplete battery
+    vehicle->updateState(vehicle->getMaxFlightTime());
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Queued);
+    double flight_time = vehicle->getTotalFlightTime();
+
+    vehicle->startCharging();
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Charging);
+    double charge_time = vehicle->getTimeToFullCharge();
+    EXPECT_NEAR(charge_time, vehicle->getTimeToCharge(), EPSILON);
+
+    // Charge to full and fly the rest of the step
+    double time_delta = 0.01;
+    vehicle->updateState(charge_time + time_delta);
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Flying);
+    EXPECT_NEAR(vehicle->getTotalChargingTime(), charge_time, EPSILON);
+    EXPECT_NEAR(vehicle->getStepStats().chargingTime, charge_time, EPSILON);
+    EXPECT_NEAR(vehicle->getTotalFlightTime(), flight_time + time_delta, EPSILON);
+}
+
+TEST_P(VehicleParameterizedTest, FlightAndChargeCounts) {
+    SCOPED_TRACE("REQ-VEHICLE-5: Verifies completed flights and charging sessions are counted by the vehicle.");
+
+    // A flight only counts once it ends
+    vehicle->updateState(vehicle->getMaxFlightTime() * 0.5);
+    EXPECT_EQ(vehicle->getTotalStats().flights, 0);
+
+    vehicle->updateState(vehicle->getMaxFlightTime());
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Queued);
+    EXPECT_EQ(vehicle->getStepStats().flights, 1);
+    EXPECT_EQ(vehicle->getTotalStats().flights, 1);
+    EXPECT_EQ(vehicle->getTotalStats().charges, 0);
+
+    // Complete the charge and start the next flight in the same step
+    vehicle->startCharging();
+    vehicle->updateState(vehicle->getTimeToFullCharge() + 0.01);
+    EXPECT_EQ(vehicle->getCurrentState(), Vehicle::State::Flying);
+    EXPECT_EQ(vehicle->getStepStats().charges, 1);
+    EXPECT_EQ(vehicle->getStepStats().flights, 0);
+    EXPECT_EQ(vehicle->getTotalStats().charges, 1);
+    EXPECT_EQ(vehicle->getTotalStats().flights, 1);
+}
 
 TEST_P(VehicleParameterizedTest, StepAndTotalStatsAccumulation) {
     SCOPED_TRACE("REQ-VEHICLE-5: Verifies step stats are properly accumulated into total stats.");
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "simulation.hpp"
+#include "counter_rng.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const char* const TYPE_FILE =
+    "# name    mph  kWh  hours  kWh/mile  passengers  faults/hour\n"
+    "Foxtrot   140  280  0.7    1.9       4           0.12\n"
+    "\n"
+    "Golf      80   90   0.4    1.1       1           0.3  # cargo drone\n";
+
+// Leaves the process-wide registry with the built-in types only
+class VehicleRegistryTest : public ::testing::Test {
+protected:
+    void TearDown() override { VehicleTypeRegistry::instance().reset(); }
+};
+
+} // namespace
+
+TEST_F(VehicleRegistryTest, LoadsTypesFromFile) {
+    SCOPED_TRACE("REQ-VEH-009: Verifies vehicle types are read from a type file after the built-in types.");
+
+    VehicleTypeRegistry registry;
+    EXPECT_EQ(registry.size(), static_cast<size_t>(Vehicle::Manufacturer::NumManufacturers));
+    EXPECT_EQ(registry.fingerprint(), "");
+
+    std::istringstream in(TYPE_FILE);
+    registry.load(in, "types.txt");
+    ASSERT_EQ(registry.getRegisteredCount(), 2u);
+
+    Vehicle::Manufacturer golf;
+    ASSERT_TRUE(registry.find("Golf", golf));
+    EXPECT_EQ(static_cast<size_t>(golf), static_cast<size_t>(Vehicle::Manufacturer::NumManufacturers) + 1);
+    EXPECT_EQ(registry.get(golf).spec.cruiseSpeed, 80.0);
+    EXPECT_EQ(registry.get(golf).spec.passengerCount, 1);
+    EXPECT_EQ(registry.get(golf).spec.faultProbability, 0.3);
+    EXPECT_EQ(registry.get(Vehicle::Manufacturer::Alpha).name, "Alpha");
+    EXPECT_EQ(registry.fingerprint().size(), 16u);
+
+    // A bad line rejects the whole file and names its line
+    const char* const invalid[] = {
+        "Hotel 100 100 0.5 1.0 2\n",            // Missing field
+        "Hotel 100 100 0.5 1.0 2.5 0.1\n",      // Fractional passengers
+        "Hotel 100 100 0 1.0 2 0.1\n",          // No charge time
+        "Hotel 100 100 0.5 1.0 2 0.1\nGolf 1 1 1 1 1 0\n", // Already defined
+        "Bravo 100 100 0.5 1.0 2 0.1\n",        // Built-in name
+    };
+    for (const char* text : invalid) {
+        SCOPED_TRACE(text);
+        std::istringstream bad(text);
+        EXPECT_THROW(registry.load(bad, "bad.txt"), std::runtime_error);
+        EXPECT_EQ(registry.getRegisteredCount(), 2u);
+    }
+    try {
+        std::istringstream bad("\nHotel fast 100 0.5 1.0 2 0.1\n");
+        registry.load(bad, "bad.txt");
+        FAIL() << "Expected a parse error";
+    } catch (const std::runtime_error& error) {
+        EXPECT_EQ(std::string(error.what()).rfind("bad.txt:2:", 0), 0u);
+    }
+}
+
+TEST_F(VehicleRegistryTest, SimulationCreatesRegisteredTypes) {
+    SCOPED_TRACE("REQ-VEH-009, REQ-SIM-005: Verifies the simulation creates and reports registered vehicle types.");
+
+    std::istringstream in(TYPE_FILE);
+    VehicleTypeRegistry::instance().load(in, "types.txt");
+    Vehicle::Manufacturer foxtrot;
+    ASSERT_TRUE(VehicleTypeRegistry::instance().find("Foxtrot", foxtrot));
+
+    // Equal distribution, every type gets three vehicles
+    for (SimulationEngine engine : {SimulationEngine::FixedStep, SimulationEngine::StructOfArrays}) {
+        SCOPED_TRACE(engineToString(engine));
+        Simulation sim(21, 2.0, 3, 30.0, DEFAULT_VERBOSITY, false, false);
+        sim.setEngine(engine);
+        sim.setSeed(3);
+        sim.runSimulation();
+
+        const auto& typeStats = sim.getTypeStats();
+        ASSERT_EQ(typeStats.size(), 7u);
+        const VehicleTypeStats& stats = typeStats.at(foxtrot);
+        EXPECT_EQ(stats.manufacturerName, "Foxtrot");
+        EXPECT_EQ(stats.vehicleCount, 3);
+        EXPECT_EQ(stats.expectedFaultRate, 0.12);
+        EXPECT_GT(stats.totalFlightTime, 0.0);
+    }
+}
+
+TEST_F(VehicleRegistryTest, TypeKernelsMatchGenericKernel) {
+    SCOPED_TRACE("REQ-VEH-009: Verifies the built-in type kernels step exactly like the generic state machine.");
+
+    if (!Vehicle::getTypeKernelsEnabled()) {
+        GTEST_SKIP() << "Built without EVTOL_TYPE_KERNELS";
+    }
+
+    // Only vehicles with the exact built-in constants use a type kernel
+    AlphaCompanyVehicle alpha;
+    Vehicle custom(Vehicle::Manufacturer::Alpha, 100, 320, 0.6, 1.6, 4, 0.25);
+    EXPECT_TRUE(alpha.usesTypeKernel());
+    EXPECT_FALSE(custom.usesTypeKernel());
+
+    // Same random streams with and without the kernels, charging whenever a vehicle queues
+    auto run = [](bool kernels) {
+        Vehicle::setTypeKernelsEnabled(kernels);
+        std::vector<CounterRandomGenerator> rngs;
+        std::vector<Vehicle> vehicles;
+        for (size_t type = 0; type < static_cast<size_t>(Vehicle::Manufacturer::NumManufacturers); ++type) {
+            rngs.emplace_back(11, type);
+        }
+        for (size_t type = 0; type < rngs.size(); ++type) {
+            auto manufacturer = static_cast<Vehicle::Manufacturer>(type);
+            vehicles.emplace_back(manufacturer, getVehicleTypeSpec(manufacturer), rngs[type]);
+        }
+        for (int step = 0; step < 2000; ++step) {
+            for (auto& vehicle : vehicles) {
+                if (vehicle.getCurrentState() == Vehicle::State::Queued) {
+                    vehicle.startCharging();
+                }
+                vehicle.updateState(0.01);
+            }
+        }
+        Vehicle::setTypeKernelsEnabled(true);
+        return vehicles;
+    };
+    std::vector<Vehicle> specialized = run(true);
+    std::vector<Vehicle> generic = run(false);
+
+    for (size_t i = 0; i < specialized.size(); ++i) {
+        SCOPED_TRACE(specialized[i].getManufacturerString());
+        const VehicleStats& expected = generic[i].getTotalStats();
+        const VehicleStats& actual = specialized[i].getTotalStats();
+        EXPECT_EQ(specialized[i].getCurrentState(), generic[i].getCurrentState());
+        EXPECT_EQ(specialized[i].getBatteryLevel(), generic[i].getBatteryLevel());
+        EXPECT_EQ(actual.flightTime, expected.flightTime);
+        EXPECT_EQ(actual.distanceTraveled, expected.distanceTraveled);
+        EXPECT_EQ(actual.chargingTime, expected.chargingTime);
+        EXPECT_EQ(actual.passengerMiles, expected.passengerMiles);
+        EXPECT_EQ(actual.faults, expected.faults);
+        EXPECT_EQ(actual.flights, expected.flights);
+        EXPECT_EQ(actual.charges, expected.charges);
+    }
+}
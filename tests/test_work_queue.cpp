@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "work_queue.hpp"
+#include "replication.hpp"
+#include <thread>
+#include <vector>
+
+namespace {
+
+ReplicationSettings smallReplications() {
+    ReplicationSettings settings;
+    settings.numVehicles = 20;
+    settings.simHours = 1.0;
+    settings.simTimeStepSeconds = 30.0;
+    settings.replications = 5;
+    settings.seed = 19;
+    return settings;
+}
+
+void expectSameStats(const std::vector<VehicleTypeStatsTable>& expected, const std::vector<VehicleTypeStatsTable>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].size(), actual[i].size());
+        for (const auto& pair : expected[i]) {
+            const VehicleTypeStats& stats = actual[i].at(pair.first);
+            EXPECT_EQ(stats.manufacturerName, pair.second.manufacturerName);
+            EXPECT_EQ(stats.vehicleCount, pair.second.vehicleCount);
+            EXPECT_EQ(stats.totalFlights, pair.second.totalFlights);
+            EXPECT_EQ(stats.totalFlightTime, pair.second.totalFlightTime);
+            EXPECT_EQ(stats.totalQueuedTime, pair.second.totalQueuedTime);
+            EXPECT_EQ(stats.totalFaults, pair.second.totalFaults);
+            EXPECT_EQ(stats.totalPassengerMiles, pair.second.totalPassengerMiles);
+            EXPECT_EQ(stats.expectedFaultRate, pair.second.expectedFaultRate);
+        }
+    }
+}
+
+} // namespace
+
+TEST(WorkQueueTest, PayloadsRoundTrip) {
+    SCOPED_TRACE("REQ-SIM-019: Verifies work items and results are decoded as they were encoded.");
+
+    RunConfig config;
+    config.numVehicles = 42;
+    config.simHours = 2.5;
+    config.engine = SimulationEngine::Adaptive;
+    config.faultModel = Vehicle::FaultModel::Exponential;
+    config.randomizeVehicles = false;
+    config.dispatchPolicy = DispatchPolicy::ShortestCharge;
+    config.seed = 1234567890123ull;
+
+    uint64_t item = 0;
+    RunConfig decoded;
+    ASSERT_TRUE(decodeWorkItem(encodeWorkItem(7, config), item, decoded));
+    EXPECT_EQ(item, 7u);
+    EXPECT_EQ(decoded.numVehicles, 42);
+    EXPECT_EQ(decoded.simHours, 2.5);
+    EXPECT_EQ(decoded.engine, SimulationEngine::Adaptive);
+    EXPECT_EQ(decoded.faultModel, Vehicle::FaultModel::Exponential);
+    EXPECT_FALSE(decoded.randomizeVehicles);
+    EXPECT_EQ(decoded.dispatchPolicy, DispatchPolicy::ShortestCharge);
+    EXPECT_EQ(decoded.seed, config.seed);
+
+    // Truncated and padded payloads are malformed
+    std::string payload = encodeWorkItem(7, config);
+    EXPECT_FALSE(decodeWorkItem(payload.substr(0, payload.size() - 1), item, decoded));
+    EXPECT_FALSE(decodeWorkItem(payload + "x", item, decoded));
+
+    // Fleet compositions travel with the item and must match the number of vehicles
+    config.fleetComposition = {10, 0, 32};
+    ASSERT_TRUE(decodeWorkItem(encodeWorkItem(7, config), item, decoded));
+    EXPECT_EQ(decoded.fleetComposition, config.fleetComposition);
+    config.fleetComposition = {10, 0, 31};
+    EXPECT_FALSE(decodeWorkItem(encodeWorkItem(7, config), item, decoded));
+    config.fleetComposition.clear();
+
+    VehicleTypeStatsTable typeStats = simulate(config).typeStats;
+    VehicleTypeStatsTable decodedStats;
+    ASSERT_TRUE(decodeWorkResult(encodeWorkResult(3, typeStats), item, decodedStats));
+    EXPECT_EQ(item, 3u);
+    expectSameStats({typeStats}, {decodedStats});
+}
+
+TEST(WorkQueueTest, WorkersMatchLocalRun) {
+    SCOPED_TRACE("REQ-SIM-019: Verifies replications run on workers give the results of a local run.");
+
+    ReplicationRunner local(smallReplications());
+    local.run();
+
+    WorkCoordinatorSettings settings;
+    settings.port = 0;
+    WorkCoordinator coordinator(settings);
+    std::vector<int> completed(2, 0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 2; ++i) {
+        workers.emplace_back([&completed, &coordinator, i] {
+            completed[i] = WorkWorker("127.0.0.1", coordinator.getPort(), 5.0).run();
+        });
+    }
+
+    ReplicationRunner remote(smallReplications());
+    remote.setBatchRunner([&coordinator](const std::vector<RunConfig>& configs) { return coordinator.run(configs); });
+    remote.run();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    expectSameStats(local.getResults(), remote.getResults());
+    EXPECT_EQ(completed[0] + completed[1], 5);
+    EXPECT_EQ(coordinator.getWorkersSeen(), 2);
+    EXPECT_EQ(coordinator.getRetries(), 0);
+}
+
+TEST(WorkQueueTest, LostWorkerIsRetried) {
+    SCOPED_TRACE("REQ-SIM-019: Verifies the item of a lost worker is run by another worker.");
+
+    WorkCoordinatorSettings settings;
+    settings.port = 0;
+    WorkCoordinator coordinator(settings);
+
+    // Takes an item and disconnects without a result, then a real worker finishes the batch
+    std::thread workers([&coordinator] {
+        WorkConnection lost = WorkConnection::connect("127.0.0.1", coordinator.getPort(), 5.0);
+        lost.send(WorkMessage::Hello, encodeWorkHello());
+        WorkMessage type;
+        std::string payload;
+        ASSERT_TRUE(lost.receive(type, payload));
+        EXPECT_EQ(type, WorkMessage::Work);
+        lost.close();
+        WorkWorker("127.0.0.1", coordinator.getPort(), 5.0).run();
+    });
+
+    ReplicationRunner remote(smallReplications());
+    remote.setBatchRunner([&coordinator](const std::vector<RunConfig>& configs) { return coordinator.run(configs); });
+    remote.run();
+    workers.join();
+
+    ReplicationRunner local(smallReplications());
+    local.run();
+    expectSameStats(local.getResults(), remote.getResults());
+    EXPECT_EQ(coordinator.getRetries(), 1);
+
+    // A worker that keeps getting lost fails the batch
+    settings.maxAttempts = 1;
+    WorkCoordinator strict(settings);
+    std::thread flaky([&strict] {
+        WorkConnection lost = WorkConnection::connect("127.0.0.1", strict.getPort(), 5.0);
+        lost.send(WorkMessage::Hello, encodeWorkHello());
+        WorkMessage type;
+        std::string payload;
+        lost.receive(type, payload);
+    });
+    EXPECT_THROW(strict.run({RunConfig{}}), std::runtime_error);
+    flaky.join();
+}